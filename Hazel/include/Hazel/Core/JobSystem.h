@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+
+#include <functional>
+
+namespace Hazel {
+
+	// Fixed pool of worker threads for data-parallel loops issued by the main thread
+	class JobSystem
+	{
+	public:
+		// begin, end, thread index. Thread 0 is the thread that called ParallelFor, workers are 1 to GetThreadCount() - 1.
+		using RangeFunction = std::function<void(uint32_t, uint32_t, uint32_t)>;
+
+		// workerCount 0 uses one worker per hardware thread besides the main one
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		// Workers plus the calling thread, the number of distinct thread indices ParallelFor hands out
+		static uint32_t GetThreadCount();
+
+		// Splits [0, count) into batches of at least minBatchSize, runs them on the workers and the calling thread
+		// and returns once every batch is done. Not reentrant.
+		static void ParallelFor(uint32_t count, uint32_t minBatchSize, const RangeFunction& function);
+	};
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Hazel/Renderer/Material.h"
+#include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Renderer/IBLBaker.h"
 
 #include <future>
 
@@ -22,17 +24,41 @@ namespace Hazel {
 		PbrMaterialTexture GetPbrTexture(const std::string& name);
 		Ref<Texture2D> Get2DTexture(const std::string& name);
 		Ref<TextureCube> GetCubeTexture(const std::string& name);
+		// Imports the mesh on first use, later calls with the same path share it
+		Ref<Mesh> GetMesh(const std::string& path);
+		// Irradiance of the environment the IBL maps were baked from, as SH coefficients
+		const SphericalHarmonics& GetIrradianceSH() const { return m_IrradianceSH; }
+
+		// Starts baking another equirectangular HDR environment, the maps in use are swapped out once it completes
+		void SetEnvironment(const std::string& hdrPath);
+		// Call once per frame, outside of any scene. Runs as much of the bake as the budget allows.
+		void UpdateEnvironmentBake();
+		bool IsEnvironmentBaking() const { return m_EnvironmentBaker != nullptr; }
+		float GetEnvironmentBakeProgress() const;
+		const std::string& GetEnvironmentPath() const { return m_EnvironmentPath; }
+		const std::string& GetBakingEnvironmentPath() const;
+		IBLBakeSettings& GetIBLBakeSettings() { return m_IBLBakeSettings; }
+		// Bumped every time new environment maps are swapped in
+		uint32_t GetEnvironmentVersion() const { return m_EnvironmentVersion; }
 	private:
 		ResourceManager();
 		void PreloadPbrTexResources();
 		void Preload2DTexResources();
 		void PrecomputeIBLTextures();
+		void SwapEnvironment(const IBLData& data);
 
 	private:
 		std::unordered_map<std::string, PbrMaterialTexture> m_PbrTextures;
 
 		std::unordered_map<std::string, Ref<Texture2D>> m_2DTextures;
 		std::unordered_map<std::string, Ref<TextureCube>> m_CubeTextures;
+		std::unordered_map<std::string, Ref<Mesh>> m_Meshes;
+		SphericalHarmonics m_IrradianceSH;
+
+		std::string m_EnvironmentPath = "../../assets/textures/hdr/christmas_photo_studio_03_8k.hdr";
+		Scope<IBLBaker> m_EnvironmentBaker;
+		IBLBakeSettings m_IBLBakeSettings;
+		uint32_t m_EnvironmentVersion = 0;
 
 		std::vector<std::future<void>> m_Futures;
 	private:
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	struct AABB
+	{
+		glm::vec3 Min{ 0.0f };
+		glm::vec3 Max{ 0.0f };
+
+		AABB() = default;
+		AABB(const glm::vec3& min, const glm::vec3& max)
+			: Min(min), Max(max) {}
+
+		glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		float GetSurfaceArea() const
+		{
+			glm::vec3 d = Max - Min;
+			return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+		}
+
+		bool Contains(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Min)) && glm::all(glm::greaterThanEqual(Max, other.Max));
+		}
+
+		bool Overlaps(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Max)) && glm::all(glm::greaterThanEqual(Max, other.Min));
+		}
+
+		static AABB Union(const AABB& a, const AABB& b)
+		{
+			return { glm::min(a.Min, b.Min), glm::max(a.Max, b.Max) };
+		}
+
+		// Bounds of this box after an affine transform (Arvo's method)
+		AABB Transformed(const glm::mat4& transform) const
+		{
+			glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+			glm::vec3 extents = GetExtents();
+			glm::vec3 newExtents = glm::abs(glm::vec3(transform[0])) * extents.x
+				+ glm::abs(glm::vec3(transform[1])) * extents.y
+				+ glm::abs(glm::vec3(transform[2])) * extents.z;
+			return { center - newExtents, center + newExtents };
+		}
+	};
+
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Hazel/Math/AABB.h"
+#include "Hazel/Math/Frustum.h"
+#include "Hazel/Math/Ray.h"
+
+#include <vector>
+
+namespace Hazel {
+
+	// Bounding volume hierarchy of "fat" AABBs, after Box2D's b2DynamicTree.
+	// A proxy is only reinserted when its tight bounds leave the fat bounds, so small motions cost nothing.
+	class DynamicAABBTree
+	{
+	public:
+		static constexpr int32_t NullNode = -1;
+	public:
+		DynamicAABBTree();
+
+		int32_t CreateProxy(const AABB& aabb, uint32_t userData);
+		void DestroyProxy(int32_t proxyID);
+		// Returns true if the proxy had to be reinserted
+		bool MoveProxy(int32_t proxyID, const AABB& aabb, const glm::vec3& displacement);
+
+		uint32_t GetUserData(int32_t proxyID) const { return m_Nodes[proxyID].UserData; }
+		const AABB& GetFatAABB(int32_t proxyID) const { return m_Nodes[proxyID].Box; }
+		uint32_t GetProxyCount() const { return m_ProxyCount; }
+		int32_t GetHeight() const { return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height; }
+
+		void Clear();
+
+		// callback(uint32_t userData) for every proxy whose fat AABB is not outside the frustum
+		template<typename Callback>
+		void Query(const Frustum& frustum, Callback&& callback) const;
+		// callback(uint32_t userData) for every proxy whose fat AABB overlaps aabb
+		template<typename Callback>
+		void Query(const AABB& aabb, Callback&& callback) const;
+		// float callback(uint32_t userData, float maxT) for every proxy whose fat AABB the ray enters within maxT.
+		// The callback returns the new maxT, the closest hit so far, and subtrees beyond it are skipped (as b2DynamicTree::RayCast).
+		template<typename Callback>
+		void RayCast(const Ray& ray, float maxT, Callback&& callback) const;
+	private:
+		struct Node
+		{
+			AABB Box;
+			uint32_t UserData = 0;
+			union
+			{
+				int32_t Parent;
+				int32_t Next;
+			};
+			int32_t Child1 = NullNode;
+			int32_t Child2 = NullNode;
+			// Leaf = 0, free node = -1
+			int32_t Height = -1;
+
+			bool IsLeaf() const { return Child1 == NullNode; }
+		};
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t nodeID);
+
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+		int32_t Balance(int32_t nodeID);
+
+		template<typename Callback>
+		void VisitSubtree(int32_t nodeID, Callback& callback, std::vector<int32_t>& stack) const;
+	private:
+		std::vector<Node> m_Nodes;
+		int32_t m_Root = NullNode;
+		int32_t m_FreeList = NullNode;
+		uint32_t m_ProxyCount = 0;
+
+		mutable std::vector<int32_t> m_Stack;
+	};
+
+	template<typename Callback>
+	void DynamicAABBTree::VisitSubtree(int32_t nodeID, Callback& callback, std::vector<int32_t>& stack) const
+	{
+		size_t base = stack.size();
+		stack.push_back(nodeID);
+		while (stack.size() > base)
+		{
+			const Node& node = m_Nodes[stack.back()];
+			stack.pop_back();
+			if (node.IsLeaf())
+			{
+				callback(node.UserData);
+			}
+			else
+			{
+				stack.push_back(node.Child1);
+				stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::Query(const Frustum& frustum, Callback&& callback) const
+	{
+		if (m_Root == NullNode)
+			return;
+
+		std::vector<int32_t>& stack = m_Stack;
+		stack.clear();
+		stack.push_back(m_Root);
+		while (!stack.empty())
+		{
+			int32_t nodeID = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_Nodes[nodeID];
+			Frustum::Result result = frustum.Test(node.Box);
+			if (result == Frustum::Result::Outside)
+				continue;
+
+			if (node.IsLeaf())
+				callback(node.UserData);
+			else if (result == Frustum::Result::Inside)
+				VisitSubtree(nodeID, callback, stack); // Whole subtree is visible, no more plane tests needed
+			else
+			{
+				stack.push_back(node.Child1);
+				stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::Query(const AABB& aabb, Callback&& callback) const
+	{
+		if (m_Root == NullNode)
+			return;
+
+		std::vector<int32_t>& stack = m_Stack;
+		stack.clear();
+		stack.push_back(m_Root);
+		while (!stack.empty())
+		{
+			int32_t nodeID = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_Nodes[nodeID];
+			if (!node.Box.Overlaps(aabb))
+				continue;
+
+			if (node.IsLeaf())
+				callback(node.UserData);
+			else
+			{
+				stack.push_back(node.Child1);
+				stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::RayCast(const Ray& ray, float maxT, Callback&& callback) const
+	{
+		float t;
+		if (m_Root == NullNode || !ray.Intersects(m_Nodes[m_Root].Box, maxT, t))
+			return;
+
+		// Entry distances go along on the stack, so boxes behind a closer hit are dropped without a retest
+		std::vector<std::pair<int32_t, float>> stack;
+		stack.emplace_back(m_Root, t);
+		while (!stack.empty())
+		{
+			auto [nodeID, entry] = stack.back();
+			stack.pop_back();
+			if (entry > maxT)
+				continue;
+
+			const Node& node = m_Nodes[nodeID];
+			if (node.IsLeaf())
+			{
+				maxT = callback(node.UserData, maxT);
+				continue;
+			}
+
+			// Nearer child goes on top so its hits can cull the farther one
+			float t1, t2;
+			bool hit1 = ray.Intersects(m_Nodes[node.Child1].Box, maxT, t1);
+			bool hit2 = ray.Intersects(m_Nodes[node.Child2].Box, maxT, t2);
+			if (hit1 && hit2)
+			{
+				if (t1 < t2)
+				{
+					stack.emplace_back(node.Child2, t2);
+					stack.emplace_back(node.Child1, t1);
+				}
+				else
+				{
+					stack.emplace_back(node.Child1, t1);
+					stack.emplace_back(node.Child2, t2);
+				}
+			}
+			else if (hit1)
+				stack.emplace_back(node.Child1, t1);
+			else if (hit2)
+				stack.emplace_back(node.Child2, t2);
+		}
+	}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Hazel/Math/AABB.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	class Frustum
+	{
+	public:
+		enum class Result
+		{
+			Outside = 0, Intersects, Inside
+		};
+	public:
+		Frustum() = default;
+		// Planes are extracted from an OpenGL style view-projection matrix
+		Frustum(const glm::mat4& viewProjection);
+
+		Result Test(const AABB& aabb) const;
+		bool Intersects(const AABB& aabb) const { return Test(aabb) != Result::Outside; }
+	private:
+		// xyz = inward facing normal, w = distance
+		glm::vec4 m_Planes[6];
+	};
+
+}
@@ -6,4 +6,9 @@ namespace Hazel::Math{
 
 	bool DecomposeTransform(const glm::mat4& transform, glm::vec3& translation, glm::vec3& rotation, glm::vec3& scale);
 
+	// Unit vector folded onto the octahedron and unwrapped to [-1, 1]^2, two components instead of three.
+	// Shaders undo it with the matching OctahedralDecode.
+	glm::vec2 OctahedralEncode(const glm::vec3& normal);
+	glm::vec3 OctahedralDecode(const glm::vec2& encoded);
+
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Hazel/Math/AABB.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// Points along the ray are Origin + t * Direction. Direction is not normalized, so distances
+	// are in units of its length and stay the same when the ray is moved into another space.
+	struct Ray
+	{
+		glm::vec3 Origin{ 0.0f };
+		glm::vec3 Direction{ 0.0f, 0.0f, -1.0f };
+
+		Ray() = default;
+		Ray(const glm::vec3& origin, const glm::vec3& direction)
+			: Origin(origin), Direction(direction) {}
+
+		glm::vec3 GetPoint(float t) const { return Origin + t * Direction; }
+
+		Ray Transformed(const glm::mat4& transform) const;
+
+		// Each returns the entry distance in t if it is within [0, maxT]
+		bool Intersects(const AABB& aabb, float maxT, float& t) const;
+		bool IntersectsSphere(const glm::vec3& center, float radius, float maxT, float& t) const;
+		// Moller-Trumbore, both faces count
+		bool IntersectsTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float maxT, float& t) const;
+
+		// Ray through a point in normalized device coordinates, from the near plane (t = 0) to the far plane (t = 1)
+		static Ray FromNDC(const glm::vec2& ndc, const glm::mat4& viewProjection);
+	};
+
+}
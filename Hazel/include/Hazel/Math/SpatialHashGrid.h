@@ -0,0 +1,143 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <unordered_map>
+
+namespace Hazel {
+
+	// Uniform grid over the xy plane for flat, 2D content. Only occupied cells exist, hashed by their coordinates.
+	// A proxy is listed in every cell its box overlaps, so a query only visits the cells under its rect and costs
+	// what is inside the rect, not what is in the world. Proxies spanning too many cells are kept aside and
+	// tested on every query instead.
+	class SpatialHashGrid
+	{
+	public:
+		static constexpr int32_t NullProxy = -1;
+		// Proxies covering more cells than this skip the grid
+		static constexpr uint32_t MaxCellsPerProxy = 64;
+	public:
+		SpatialHashGrid(float cellSize = 8.0f);
+
+		int32_t CreateProxy(const glm::vec2& min, const glm::vec2& max, uint32_t userData);
+		void DestroyProxy(int32_t proxyID);
+		// Cells are only touched when the proxy moves into a different range of them
+		void MoveProxy(int32_t proxyID, const glm::vec2& min, const glm::vec2& max);
+
+		uint32_t GetUserData(int32_t proxyID) const { return m_Proxies[proxyID].UserData; }
+		uint32_t GetProxyCount() const { return m_ProxyCount; }
+		uint32_t GetCellCount() const { return (uint32_t)m_Cells.size(); }
+		float GetCellSize() const { return m_CellSize; }
+
+		void Clear();
+
+		// callback(uint32_t userData) once for every proxy whose box overlaps [min, max]
+		template<typename Callback>
+		void Query(const glm::vec2& min, const glm::vec2& max, Callback&& callback) const;
+	private:
+		struct CellRange
+		{
+			glm::ivec2 Min{ 0 }, Max{ -1 };
+
+			bool operator==(const CellRange& other) const { return Min == other.Min && Max == other.Max; }
+			// In 64 bits, with cells clamped to +-2^30 a side can span 2^31 + 1 of them
+			uint64_t GetCellCount() const { return (uint64_t)((int64_t)Max.x - Min.x + 1) * (uint64_t)((int64_t)Max.y - Min.y + 1); }
+		};
+
+		struct Proxy
+		{
+			glm::vec2 Min{ 0.0f }, Max{ 0.0f };
+			uint32_t UserData = 0;
+			CellRange Cells;
+			bool Oversized = false;
+			int32_t NextFree = NullProxy;
+			// Last query that reported the proxy, so ones spanning several cells are reported once
+			mutable uint32_t QueryStamp = 0;
+		};
+
+		struct CellHash
+		{
+			size_t operator()(uint64_t key) const
+			{
+				// Neighbouring cells differ in few bits, mix them (MurmurHash3 finalizer)
+				key ^= key >> 33;
+				key *= 0xff51afd7ed558ccdull;
+				key ^= key >> 33;
+				return (size_t)key;
+			}
+		};
+
+		static uint64_t GetCellKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+		CellRange GetCellRange(const glm::vec2& min, const glm::vec2& max) const;
+
+		void InsertIntoCells(int32_t proxyID);
+		void RemoveFromCells(int32_t proxyID);
+	private:
+		float m_CellSize;
+		std::unordered_map<uint64_t, std::vector<int32_t>, CellHash> m_Cells;
+		std::vector<int32_t> m_Oversized;
+
+		std::vector<Proxy> m_Proxies;
+		int32_t m_FreeList = NullProxy;
+		uint32_t m_ProxyCount = 0;
+
+		mutable uint32_t m_QueryStamp = 0;
+	};
+
+	template<typename Callback>
+	void SpatialHashGrid::Query(const glm::vec2& min, const glm::vec2& max, Callback&& callback) const
+	{
+		if (++m_QueryStamp == 0)
+		{
+			// Wrapped around, stamps from 4 billion queries ago could match again
+			for (const Proxy& proxy : m_Proxies)
+				proxy.QueryStamp = 0;
+			m_QueryStamp = 1;
+		}
+
+		auto visit = [&](int32_t proxyID)
+		{
+			const Proxy& proxy = m_Proxies[proxyID];
+			if (proxy.QueryStamp == m_QueryStamp)
+				return;
+			proxy.QueryStamp = m_QueryStamp;
+
+			if (glm::all(glm::lessThanEqual(proxy.Min, max)) && glm::all(glm::greaterThanEqual(proxy.Max, min)))
+				callback(proxy.UserData);
+		};
+
+		for (int32_t proxyID : m_Oversized)
+			visit(proxyID);
+
+		// A rect wider than the occupied part of the world would mostly look up empty cells, walk the occupied ones instead
+		CellRange range = GetCellRange(min, max);
+		if (range.GetCellCount() > m_Cells.size())
+		{
+			for (const auto& [key, proxies] : m_Cells)
+			{
+				glm::ivec2 cell((int32_t)(key >> 32), (int32_t)(uint32_t)key);
+				if (glm::any(glm::lessThan(cell, range.Min)) || glm::any(glm::greaterThan(cell, range.Max)))
+					continue;
+
+				for (int32_t proxyID : proxies)
+					visit(proxyID);
+			}
+			return;
+		}
+
+		for (int32_t y = range.Min.y; y <= range.Max.y; y++)
+		{
+			for (int32_t x = range.Min.x; x <= range.Max.x; x++)
+			{
+				auto it = m_Cells.find(GetCellKey(x, y));
+				if (it == m_Cells.end())
+					continue;
+
+				for (int32_t proxyID : it->second)
+					visit(proxyID);
+			}
+		}
+	}
+
+}
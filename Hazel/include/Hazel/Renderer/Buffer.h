@@ -4,7 +4,10 @@ namespace Hazel {
 
 	enum class ShaderDataType
 	{
-		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool,
+		// Packed, read as floats in the shader. The Norm types map to [0, 1] or [-1, 1],
+		// Int2_10_10_10_Rev is xyz in signed 10-bit and w in signed 2-bit, all normalized.
+		Half2, Half4, UByte4Norm, Short2Norm, Int2_10_10_10_Rev
 	};
 
 	static uint32_t ShaderDataTypeSize(ShaderDataType type)
@@ -22,6 +25,11 @@ namespace Hazel {
 			case ShaderDataType::Int3:     return 4 * 3;
 			case ShaderDataType::Int4:     return 4 * 4;
 			case ShaderDataType::Bool:     return 1;
+			case ShaderDataType::Half2:    return 2 * 2;
+			case ShaderDataType::Half4:    return 2 * 4;
+			case ShaderDataType::UByte4Norm:        return 4;
+			case ShaderDataType::Short2Norm:        return 2 * 2;
+			case ShaderDataType::Int2_10_10_10_Rev: return 4;
 		}
 
 		HZ_CORE_ASSERT(false, "Unknow ShaderDataType!");
@@ -49,13 +57,18 @@ namespace Hazel {
 				case ShaderDataType::Float2:   return 2;
 				case ShaderDataType::Float3:   return 3;
 				case ShaderDataType::Float4:   return 4;
-				case ShaderDataType::Mat3:     return 3 * 3;
-				case ShaderDataType::Mat4:     return 4 * 4;
+				case ShaderDataType::Mat3:     return 3; // 3* float3
+				case ShaderDataType::Mat4:     return 4; // 4* float4
 				case ShaderDataType::Int:      return 1;
 				case ShaderDataType::Int2:     return 2;
 				case ShaderDataType::Int3:     return 3;
 				case ShaderDataType::Int4:     return 4;
 				case ShaderDataType::Bool:     return 1;
+				case ShaderDataType::Half2:    return 2;
+				case ShaderDataType::Half4:    return 4;
+				case ShaderDataType::UByte4Norm:        return 4;
+				case ShaderDataType::Short2Norm:        return 2;
+				case ShaderDataType::Int2_10_10_10_Rev: return 4;
 			}
 
 			HZ_CORE_ASSERT(false, "Unknow ShaderDataType!");
@@ -115,7 +128,12 @@ namespace Hazel {
 		static Ref<VertexBuffer> Create(void* vertices, uint32_t size);
 	};
 
-	// Currently Hazel only support 32-bit index buffers
+	// Width of the indices stored in an IndexBuffer
+	enum class IndexType
+	{
+		UInt16 = 0, UInt32
+	};
+
 	class IndexBuffer
 	{
 	public:
@@ -125,7 +143,9 @@ namespace Hazel {
 		virtual void Unbind() const = 0;
 
 		virtual uint32_t GetCount() const = 0;
+		virtual IndexType GetIndexType() const = 0;
 
 		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
+		static Ref<IndexBuffer> Create(uint16_t* indices, uint32_t count);
 	};
 }
\ No newline at end of file
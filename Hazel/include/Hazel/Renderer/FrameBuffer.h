@@ -48,6 +48,15 @@ namespace Hazel {
 		bool SwapChainTarget = false;
 	};
 
+	// Integer attachment pixels read back without stalling on the GPU
+	struct PixelReadback
+	{
+		uint32_t RequestID = 0;
+		int X = 0, Y = 0;
+		uint32_t Width = 0, Height = 0;
+		std::vector<int> Pixels; // Row by row, bottom row first
+	};
+
 	class FrameBuffer
 	{
 	public:
@@ -58,6 +67,11 @@ namespace Hazel {
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
+		// Like ReadPixel but only queues the copy, the result shows up a frame or two later in PollReadPixels.
+		// The rect is clipped to the framebuffer. Returns the ID the result will carry.
+		virtual uint32_t ReadPixelsAsync(uint32_t attachmentIndex, int x, int y, uint32_t width = 1, uint32_t height = 1) = 0;
+		// Hands out the oldest finished readback, false if none finished yet
+		virtual bool PollReadPixels(PixelReadback& result) = 0;
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
 
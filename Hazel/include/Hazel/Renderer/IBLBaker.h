@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Hazel/Renderer/IBLCache.h"
+#include "Hazel/Renderer/RenderGraph.h"
+
+#include <functional>
+#include <future>
+
+namespace Hazel {
+
+	class Shader;
+
+	struct IBLBakeSettings
+	{
+		float FrameBudget = 2.0f; // ms of CPU time per frame, at least one step always runs
+		// Bounds the GPU work queued per frame, which the CPU timings don't see
+		uint32_t MaxStepsPerFrame = 4;
+	};
+
+	// Bakes the IBL maps of an equirectangular HDR environment one cubemap face or prefilter mip face at a time.
+	// Everything is rendered into textures of its own, so the maps in use stay untouched until the bake is complete.
+	// Hashing the sources, decoding and downsampling the HDR, projecting the SH and reading and writing the cache
+	// file run on worker threads. Uploads are split into bands or single faces, readbacks go through a pixel pack buffer.
+	class IBLBaker
+	{
+	public:
+		// The BRDF LUT doesn't depend on the environment, it is only baked when none is given
+		IBLBaker(const std::string& hdrPath, const Ref<Texture2D>& brdfLUT = nullptr);
+		~IBLBaker();
+
+		// Runs steps until the budget is used up, returns true once the bake is complete
+		bool Update(const IBLBakeSettings& settings);
+		// Runs every remaining step, waiting on the workers
+		void Finish();
+
+		bool IsComplete() const { return m_NextStep == m_Steps.size(); }
+		float GetProgress() const { return (float)m_NextStep / (float)m_Steps.size(); }
+		const std::string& GetPath() const { return m_HdrPath; }
+		const IBLData& GetResult() const { return m_Result; }
+	private:
+		// Downsampled to what the environment cubemap can resolve, rows bottom to top
+		struct HdrImage
+		{
+			std::vector<float> Pixels;    // RGB, for the SH projection
+			std::vector<uint16_t> Texels; // RGB half floats, for the upload
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+		};
+
+		// Returns false when it is waiting on a worker or the GPU and has to be run again later
+		using Step = std::function<bool()>;
+
+		static HdrImage DecodeHdr(const std::string& path);
+
+		void BuildSteps();
+		std::vector<Step> BuildLoadSteps();
+		// Replaces every step after the running one once it returns, for when the cache lookup picks a different route
+		void ReplaceRemainingSteps(std::vector<Step> steps);
+		bool RunStep();
+		template<typename T>
+		bool IsReady(const std::future<T>& future) const;
+		void RenderFace(const Ref<Shader>& shader, const Ref<TextureCube>& target, uint32_t face, uint32_t mip);
+	private:
+		std::string m_HdrPath;
+		std::string m_CachePath;
+
+		std::vector<Step> m_Steps;
+		size_t m_NextStep = 0;
+		std::vector<Step> m_ReplacementSteps;
+		bool m_ReplaceSteps = false;
+		bool m_Blocking = false;
+		float m_LastStepTime = 0.0f; // ms
+
+		std::future<uint64_t> m_CacheKey;
+		std::future<bool> m_CacheRead;
+		std::future<HdrImage> m_Decode;
+		std::future<SphericalHarmonics> m_IrradianceSH;
+		std::future<bool> m_CacheWrite;
+		uint64_t m_Key = 0;
+		HdrImage m_Image;
+
+		// Cache hit: the file's contents and the maps they are uploaded into
+		IBLCache::Contents m_CacheContents;
+		IBLData m_Loaded;
+		// Cache miss: the baked maps on their way to the file
+		Ref<TextureReadback> m_Readback;
+		IBLCache::MapLayout m_CacheMaps[IBLCache::MapCount];
+
+		Ref<Texture2D> m_HdrTexture;
+		RenderGraph m_CaptureGraph;
+
+		IBLData m_Result;
+	};
+
+}
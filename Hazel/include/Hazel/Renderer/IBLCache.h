@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/SphericalHarmonics.h"
+
+namespace Hazel {
+
+	struct IBLData
+	{
+		Ref<TextureCube> EnvCubeMap;
+		Ref<TextureCube> IrradianceMap;
+		Ref<TextureCube> PrefilterMap;
+		Ref<Texture2D> BrdfLUT;
+		// Already convolved, see SphericalHarmonics::ConvolveIrradiance
+		SphericalHarmonics IrradianceSH;
+	};
+
+	// Baked IBL maps on disk as raw texels, every face and mip level, plus the irradiance SH coefficients,
+	// so later launches skip the HDR decode and the capture passes.
+	// A cache file is only used when its key matches the one computed from the current sources.
+	// Read and Write only touch the file, so they run on worker threads; moving texels to and from the GPU is up to the caller.
+	class IBLCache
+	{
+	public:
+		// EnvCubeMap, IrradianceMap, PrefilterMap, BrdfLUT, in file order
+		static const uint32_t MapCount = 4;
+
+		// Size and format of one map as stored
+		struct MapLayout
+		{
+			uint32_t FaceCount; // 1 for 2D textures, 6 for cube maps
+			uint32_t Width;
+			uint32_t Height;
+			uint32_t MipLevels;
+			uint32_t Format;
+
+			uint32_t GetLevelSize(uint32_t level) const;
+			// Every face of every level
+			size_t GetSize() const;
+		};
+
+		// The texels of all maps back to back: map by map, level by level, face by face within a level
+		struct Contents
+		{
+			SphericalHarmonics IrradianceSH;
+			MapLayout Maps[MapCount];
+			std::vector<uint8_t> Texels;
+		};
+
+		// 64-bit FNV-1a over the contents of every file, in order. Returns 0 if any of them can't be read.
+		static uint64_t ComputeKey(const std::vector<std::string>& sourcePaths);
+
+		static Ref<Texture> GetMap(const IBLData& data, uint32_t map);
+		static MapLayout GetMapLayout(const IBLData& data, uint32_t map);
+
+		static bool Read(const std::string& path, uint64_t key, Contents& contents);
+		// texels holds every map laid out as in Contents
+		static bool Write(const std::string& path, uint64_t key, const SphericalHarmonics& irradianceSH,
+			const MapLayout (&maps)[MapCount], const void* texels);
+	};
+
+}
@@ -12,6 +12,8 @@ namespace Hazel {
 		float Metallic = 0.0f;
 		float Roughness = 1.0f;
 		float Ao = 1.0f;
+		// Below 1 the material is drawn in the translucent pass
+		float Opacity = 1.0f;
 
 		PbrMaterial() = default;
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Renderer/Buffer.h"
+#include "Hazel/Math/AABB.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	struct MeshVertex
+	{
+		glm::vec3 Position;
+		glm::vec3 Normal;
+		glm::vec2 TexCoord;
+	};
+
+	// What MeshVertex is uploaded as: octahedral normal in two snorm16, half float texture coordinates
+	struct PackedMeshVertex
+	{
+		glm::vec3 Position;
+		uint32_t Normal;
+		uint32_t TexCoord;
+	};
+
+	// Static triangle mesh. GPU buffers are created once, the CPU copy is kept for bounds and picking.
+	class Mesh
+	{
+	public:
+		// Indices are stored as 16-bit on the GPU when every vertex is addressable with them
+		Mesh(std::vector<MeshVertex> vertices, std::vector<uint32_t> indices, const std::string& path = std::string());
+
+		const std::vector<MeshVertex>& GetVertices() const { return m_Vertices; }
+		const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+		uint32_t GetTriangleCount() const { return (uint32_t)m_Indices.size() / 3; }
+
+		const AABB& GetBounds() const { return m_Bounds; }
+		const std::string& GetPath() const { return m_Path; }
+
+		const Ref<VertexBuffer>& GetVertexBuffer() const { return m_VertexBuffer; }
+		const Ref<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
+
+		static Ref<Mesh> Create(const std::string& path);
+
+		// Packs the vertices into a static buffer laid out as a_Position, a_Normal (octahedral), a_TexCoord
+		static Ref<VertexBuffer> CreateVertexBuffer(const std::vector<MeshVertex>& vertices);
+	private:
+		std::vector<MeshVertex> m_Vertices;
+		std::vector<uint32_t> m_Indices;
+		AABB m_Bounds;
+		std::string m_Path;
+
+		Ref<VertexBuffer> m_VertexBuffer;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+
+}
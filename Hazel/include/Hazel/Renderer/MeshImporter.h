@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Hazel/Renderer/Mesh.h"
+
+namespace Hazel {
+
+	class MeshImporter
+	{
+	public:
+		// Wavefront .obj and binary glTF 2.0 (.glb). Every primitive is merged into one mesh. Returns nullptr on failure.
+		static Ref<Mesh> Import(const std::string& path);
+
+		// Merges bit-identical vertices
+		static void Deduplicate(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+		// Reorders triangles for the post-transform vertex cache (Forsyth, "Linear-Speed Vertex Cache Optimisation")
+		static void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+		// Reorders vertices into first-use order so vertex fetch walks memory linearly, unreferenced vertices are dropped
+		static void OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+		// Smooth area-weighted normals
+		static void GenerateNormals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices);
+	private:
+		static bool LoadOBJ(const std::string& path, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices, bool& hasNormals);
+		static bool LoadGLB(const std::string& path, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices, bool& hasNormals);
+	};
+
+}
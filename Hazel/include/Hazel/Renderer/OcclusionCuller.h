@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Hazel/Math/AABB.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// Software occlusion culling: occluder boxes are rasterized into a small depth buffer on the CPU,
+	// then renderable bounds are tested against a max-depth (HiZ) pyramid built from it.
+	// Occluders only cover pixels their silhouette covers completely and write their farthest depth in each pixel,
+	// so a box reported occluded is hidden for certain.
+	class OcclusionCuller
+	{
+	public:
+		static const uint32_t Width = 256;
+		static const uint32_t Height = 128;
+		// Rows per job, each band is rasterized and reduced to its first HiZ levels on its own thread
+		static const uint32_t BandHeight = 16;
+
+		OcclusionCuller();
+
+		// Clears the depth buffer and drops the last frame's occluders
+		void Begin(const glm::mat4& viewProjection);
+		// localBounds in the space transform maps to the world. Occluders crossing the near plane are skipped.
+		void AddOccluder(const AABB& localBounds, const glm::mat4& transform);
+		// Rasterizes the occluders on the job system and builds the HiZ pyramid
+		void Rasterize();
+
+		// World space bounds. Only reads, so it can be called from any thread once Rasterize returned.
+		bool IsOccluded(const AABB& bounds) const;
+
+		uint32_t GetOccluderCount() const { return (uint32_t)m_Occluders.size(); }
+	private:
+		// Screen space setup of an occluder box. Edge functions and depth planes are evaluated at integer
+		// pixel coordinates, with the pixel center and the conservative offsets folded into the constants.
+		struct ScreenBox
+		{
+			static const uint32_t MaxEdges = 8;
+			static const uint32_t MaxPlanes = 3;
+
+			// Silhouette, inside where A * x + B * y + C >= 0 for every edge
+			float EdgeA[MaxEdges], EdgeB[MaxEdges], EdgeC[MaxEdges];
+			uint32_t EdgeCount = 0;
+			// Front faces. The front of a convex box is the farthest of its front face planes.
+			float PlaneA[MaxPlanes], PlaneB[MaxPlanes], PlaneC[MaxPlanes];
+			uint32_t PlaneCount = 0;
+			int32_t MinX, MaxX, MinY, MaxY;
+		};
+
+		void RasterizeBand(uint32_t band);
+		void BuildLevel(uint32_t level, uint32_t beginRow, uint32_t endRow);
+	private:
+		glm::mat4 m_ViewProjection{ 1.0f };
+		std::vector<ScreenBox> m_Occluders;
+
+		// Level 0 is the depth buffer, each level above holds the max of 2x2 texels of the one below
+		std::vector<std::vector<float>> m_Levels;
+	};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Hazel/Renderer/VertexArray.h"
+
+namespace Hazel {
+
+	// The vertex array only holds the primitive's own buffers. Renderers that add per-instance attributes
+	// build their own vertex arrays around VertexBuffer and IndexBuffer.
+	struct Primitive
+	{
+		std::string Name;
+		Ref<VertexArray> VertexArray;
+		Ref<VertexBuffer> VertexBuffer;
+		Ref<IndexBuffer> IndexBuffer; // Null for non-indexed primitives
+		uint32_t Count = 0; // Indices, or vertices when not indexed
+		uint32_t VertexCount = 0; // Only known for the built-in spheres
+	};
+
+	// Static geometry built once at renderer init and shared by every subsystem, looked up by id.
+	// Primitives are never removed, so ids stay valid for the whole run.
+	class PrimitiveCache
+	{
+	public:
+		static const uint32_t SphereLodCount = 4;
+
+		// Ids of the built-in primitives
+		enum : uint32_t
+		{
+			Cube = 0,               // [-1, 1] cube: position, normal, texcoord
+			Quad,                   // [-1, 1] quad in xy: position, texcoord
+			FullscreenTriangle,     // Covers [-1, 1] in xy with a single triangle: position, texcoord
+			SphereLod0,             // Unit spheres, finest first: position, octahedral normal, texcoord (PackedMeshVertex)
+			BuiltinCount = SphereLod0 + SphereLodCount
+		};
+		static const uint32_t InvalidId = 0xFFFFFFFF;
+
+		static void Init();
+
+		// Takes ownership of the buffers, count is the number of indices or, without an index buffer, vertices
+		static uint32_t Register(const std::string& name, const Ref<VertexBuffer>& vertexBuffer, const Ref<IndexBuffer>& indexBuffer, uint32_t count);
+		// Returns InvalidId if nothing was registered under the name
+		static uint32_t Find(const std::string& name);
+		static const Primitive& Get(uint32_t id);
+
+		// Binds the primitive's own vertex array, whatever shader is bound draws it
+		static void Draw(uint32_t id);
+
+		static uint32_t GetSphereLod(uint32_t lod) { return SphereLod0 + lod; }
+		static uint32_t GetSphereLodSegments(uint32_t lod);
+	};
+
+}
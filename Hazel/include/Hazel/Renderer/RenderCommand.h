@@ -32,14 +32,19 @@ namespace Hazel {
 			s_RendererAPI->DrawArrays(vertexArray, vertexCount);
 		}
 
-		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0)
+		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0)
 		{
-			s_RendererAPI->DrawIndexed(vertexArray, indexCount);
+			s_RendererAPI->DrawIndexed(vertexArray, indexCount, baseVertex);
 		}
 
-		static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount = 0)
+		static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0)
 		{
-			s_RendererAPI->DrawLines(vertexArray, vertexCount);
+			s_RendererAPI->DrawIndexedInstanced(vertexArray, indexCount, instanceCount, baseInstance);
+		}
+
+		static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount = 0, uint32_t firstVertex = 0)
+		{
+			s_RendererAPI->DrawLines(vertexArray, vertexCount, firstVertex);
 		}
 
 		static void SetLineWidth(float width)
@@ -57,6 +62,11 @@ namespace Hazel {
 			s_RendererAPI->DisableDepthTest();
 		}
 
+		static void SetDepthWrite(bool enabled)
+		{
+			s_RendererAPI->SetDepthWrite(enabled);
+		}
+
 	private:
 		static RendererAPI* s_RendererAPI;
 	};
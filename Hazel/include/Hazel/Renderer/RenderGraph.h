@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Hazel/Renderer/FrameBuffer.h"
+
+#include <functional>
+
+namespace Hazel {
+
+	// Framebuffers kept around for reuse, handed out by specification
+	class FrameBufferPool
+	{
+	public:
+		// Framebuffers left unused for more frames than this are freed
+		static const uint32_t MaxIdleFrames = 8;
+
+		// Reuses an idle framebuffer with the same attachments, size and samples, or creates one.
+		// Creating one frees the idle framebuffers that only differ in size.
+		Ref<FrameBuffer> Acquire(const FramebufferSpecification& spec);
+		void Release(const Ref<FrameBuffer>& frameBuffer);
+
+		// Advances the frame count and frees framebuffers that sat idle for too long
+		void EndFrame();
+		// Frees every idle framebuffer
+		void Clear();
+
+		uint32_t GetFrameBufferCount() const { return (uint32_t)m_Entries.size(); }
+		uint32_t GetCreatedCount() const { return m_CreatedCount; }
+	private:
+		struct Entry
+		{
+			Ref<Hazel::FrameBuffer> FrameBuffer;
+			uint64_t LastUsedFrame = 0;
+			bool InUse = false;
+		};
+
+		std::vector<Entry> m_Entries;
+		uint64_t m_Frame = 0;
+		uint32_t m_CreatedCount = 0;
+	};
+
+	// Index of a target declared in a RenderGraph, valid until the graph's next Reset
+	using RenderGraphResource = uint32_t;
+
+	// Passes are declared every frame with the targets they read and the one they render to.
+	// Execute culls passes whose results nobody uses and backs transient targets with pooled framebuffers
+	// only from their first to their last use, so targets whose lifetimes don't overlap share a framebuffer.
+	class RenderGraph
+	{
+	public:
+		static const RenderGraphResource InvalidResource = 0xFFFFFFFF;
+
+		using ExecuteFunction = std::function<void(const RenderGraph&)>;
+
+		struct Statistics
+		{
+			uint32_t Passes = 0;
+			uint32_t CulledPasses = 0;
+			uint32_t Targets = 0;
+			// Framebuffers the transient targets were actually backed by this frame
+			uint32_t FrameBuffersUsed = 0;
+			uint32_t PooledFrameBuffers = 0;
+			uint32_t FrameBuffersCreated = 0; // Over the graph's lifetime
+		};
+	public:
+		RenderGraph() = default;
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+
+		// Drops last frame's passes and targets, the pooled framebuffers stay
+		void Reset();
+
+		// Transient target, only backed by a framebuffer while passes use it
+		RenderGraphResource CreateTarget(const std::string& name, const FramebufferSpecification& spec);
+		// Framebuffer owned outside the graph, passes writing it are never culled
+		RenderGraphResource ImportTarget(const std::string& name, const Ref<FrameBuffer>& frameBuffer);
+		// Keeps a transient target and the passes producing it, its framebuffer stays valid until the next Reset
+		void MarkOutput(RenderGraphResource target);
+
+		// The target, if any, is bound while execute runs. Passes writing to textures of their own
+		// or reading back to the CPU have side effects and are never culled.
+		void AddPass(const std::string& name, const std::vector<RenderGraphResource>& reads, RenderGraphResource target,
+			const ExecuteFunction& execute, bool hasSideEffects = false);
+
+		// Culls, then runs the remaining passes in the order they were added
+		void Execute();
+
+		// Valid inside the passes using the target, and after Execute for outputs and imported targets
+		const Ref<FrameBuffer>& GetFrameBuffer(RenderGraphResource target) const;
+
+		// Frees the pooled framebuffers, for graphs that won't run again for a while
+		void ReleaseFrameBuffers();
+
+		const Statistics& GetStats() const { return m_Stats; }
+	private:
+		struct Target
+		{
+			std::string Name;
+			FramebufferSpecification Specification;
+			Ref<Hazel::FrameBuffer> FrameBuffer;
+			bool Imported = false;
+			bool Output = false;
+			// Live passes using the target, first to last
+			uint32_t FirstPass = InvalidResource;
+			uint32_t LastPass = 0;
+		};
+
+		struct Pass
+		{
+			std::string Name;
+			std::vector<RenderGraphResource> Reads;
+			RenderGraphResource Target = InvalidResource;
+			ExecuteFunction Execute;
+			bool HasSideEffects = false;
+			bool Culled = false;
+		};
+
+		void Cull();
+		void ComputeLifetimes();
+	private:
+		std::vector<Target> m_Targets;
+		std::vector<Pass> m_Passes;
+		FrameBufferPool m_Pool;
+		Statistics m_Stats;
+	};
+
+}
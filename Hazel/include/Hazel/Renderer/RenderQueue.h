@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+
+namespace Hazel {
+
+	struct DrawPacket
+	{
+		uint64_t SortKey;
+		uint32_t Index; // Into the submitter's own per-draw data
+	};
+
+	// Draw packets ordered by a 64-bit key, most significant bits first:
+	//   Opaque:      pass(2) | shader(6) | mesh(10) | material(14) | depth(32)      -> grouped by state, front-to-back within a state
+	//   Translucent: pass(2) | ~depth(32) | shader(6) | mesh(10) | material(14)     -> back-to-front regardless of state
+	class RenderQueue
+	{
+	public:
+		enum class Pass : uint8_t
+		{
+			Opaque = 0, Translucent = 1
+		};
+
+		static uint64_t MakeKey(Pass pass, uint32_t shader, uint32_t mesh, uint32_t material, float depth);
+
+		static Pass GetPass(uint64_t key);
+		static uint32_t GetShader(uint64_t key);
+		static uint32_t GetMesh(uint64_t key);
+		static uint32_t GetMaterial(uint64_t key);
+
+		void Submit(uint64_t key, uint32_t index) { m_Packets.push_back({ key, index }); }
+		void Clear() { m_Packets.clear(); }
+
+		// LSD radix sort, bytes that are identical across all keys are skipped
+		void Sort();
+
+		uint32_t GetSize() const { return (uint32_t)m_Packets.size(); }
+		const DrawPacket& operator[](uint32_t index) const { return m_Packets[index]; }
+	private:
+		std::vector<DrawPacket> m_Packets;
+		std::vector<DrawPacket> m_Scratch;
+	};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/SubTexture2D.h"
 
 #include "Hazel/Renderer/Camera.h"
 #include "Hazel/Renderer/EditorCamera.h"
@@ -29,6 +30,13 @@ namespace Hazel {
 		
 		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
 		static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D> texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
+		static void DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
+
+		// Draws count quads from parallel arrays. Everything after colors may be null, null textures draw with the
+		// white texture and texRects (UV min, max) default to the whole texture. Batches are only split when they
+		// run out of space or texture slots. Textures are not reference counted here, they have to outlive the scene.
+		static void DrawQuads(uint32_t count, const glm::mat4* transforms, const glm::vec4* colors, const Texture2D* const* textures = nullptr,
+			const glm::vec4* texRects = nullptr, const float* tilingFactors = nullptr, const int* entityIDs = nullptr);
 		
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
@@ -51,6 +59,9 @@ namespace Hazel {
 		{
 			uint32_t DrawCalls = 0;
 			uint32_t QuadCount = 0;
+			// Vertex and instance data written, and what the same primitives took as four all-float vertices each
+			uint64_t VertexBytes = 0;
+			uint64_t UnpackedVertexBytes = 0;
 
 			uint32_t GetTotalVertexCount() { return QuadCount * 4; }
 			uint32_t GetTotalIndexCount() { return QuadCount * 6; }
@@ -59,5 +70,11 @@ namespace Hazel {
 		static Statistics GetStats();
 	private:
 		static void NextBatch();
+
+		// Quads are one instance each, axisX, axisY and translation are columns 0, 1 and 3 of the transform.
+		// A null texture draws with the white texture.
+		static void SubmitQuad(const glm::vec3& axisX, const glm::vec3& axisY, const glm::vec3& translation, const Ref<Texture2D>& texture,
+			float tilingFactor, const glm::vec4& color, const glm::vec4& texRect, int entityID);
+		static float GetTextureIndex(const Ref<Texture2D>& texture);
 	};
 }
\ No newline at end of file
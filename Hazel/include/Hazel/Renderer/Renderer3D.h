@@ -3,6 +3,7 @@
 #include "Hazel/Renderer/Material.h"
 #include "Hazel/Renderer/Camera.h"
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Renderer/SphericalHarmonics.h"
 
 #include "Hazel/Scene/Components.h"
 
@@ -12,6 +13,7 @@ namespace Hazel {
 	{
 		std::vector<glm::vec3> PointLightPositions;
 		std::vector<glm::vec3> PointLightColors;
+		std::vector<float> PointLightRanges;
 		glm::vec3 DirectionalLightDirection;
 		glm::vec3 DirectionalLightColor;
 		//IBLSettings iblSettings;            // IBL   
@@ -23,25 +25,49 @@ namespace Hazel {
 	public:
 		static void Init();
 
-		static void BeginScene(const Camera& camera, const glm::mat4& transform);
-		static void BeginScene(const EditorCamera& camera);
+		// Camera and light uniform blocks are uploaded here once per scene
+		static void BeginScene(const Camera& camera, const glm::mat4& transform, const LightParams& lightParams);
+		static void BeginScene(const EditorCamera& camera, const LightParams& lightParams);
 		static void EndScene();
 		static void StartBatch();
 		static void Flush();
 
 		// Primitives
-		static void DrawSphere(const glm::vec3& position, float radius, const PbrMaterial& material, LightParams lightParams);
-		static void DrawSphere(const glm::vec3& position, float radius,  PbrMaterialTexture pbrTexture, LightParams lightParams);
+		static void DrawSphere(const glm::vec3& position, float radius, const PbrMaterial& material);
+		static void DrawSphere(const glm::vec3& position, float radius, const PbrMaterialTexture& pbrTexture);
 		
-		static void DrawSphere(const glm::mat4& transform, const PbrMaterial& material, LightParams lightParams, int entityID = -1);
-		static void DrawSphere(const glm::mat4& transform, PbrMaterialTexture pbrTexture, LightParams lightParams, int entityID = -1);
+		static void DrawSphere(const glm::mat4& transform, const PbrMaterial& material, int entityID = -1);
+		static void DrawSphere(const glm::mat4& transform, const PbrMaterialTexture& pbrTexture, int entityID = -1);
 		
-		static void DrawSphere(const glm::mat4& transform, SphereRendererComponent& src, LightParams lightParams, int entityID);
+		static void DrawSphere(const glm::mat4& transform, SphereRendererComponent& src, int entityID);
+
+		// Meshes are batched with the spheres, every mesh gets its own vertex array the first time it is drawn
+		static void DrawMesh(const glm::mat4& transform, const Ref<Mesh>& mesh, const PbrMaterial& material, int entityID = -1);
+		static void DrawMesh(const glm::mat4& transform, const Ref<Mesh>& mesh, const PbrMaterialTexture& pbrTexture, int entityID = -1);
+		static void DrawMesh(const glm::mat4& transform, MeshRendererComponent& mrc, int entityID);
+
+		// Parallel recording: BeginRecording sets up one command list per thread, then RecordSphere and RecordMesh may run
+		// concurrently as long as every thread writes its own list. SubmitRecorded merges the lists into the batch on the render thread.
+		// Recording only reads renderer state, materials and meshes drawn for the first time are created by SubmitRecorded.
+		static void BeginRecording(uint32_t listCount);
+		static void RecordSphere(uint32_t list, const glm::mat4& transform, SphereRendererComponent& src, int entityID);
+		static void RecordMesh(uint32_t list, const glm::mat4& transform, MeshRendererComponent& mrc, int entityID);
+		static void AddRecordTime(uint32_t list, float time);
+		static void SubmitRecorded();
 
 		static void DrawLines(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID = -1);
 		static float GetLineWidth();
 		static void SetLineWidth(float width);
 
+		// Added to every sphere's own LodBias, positive values pick coarser LODs sooner
+		static float GetSphereLodBias();
+		static void SetSphereLodBias(float bias);
+
+		// Ambient diffuse is evaluated from these coefficients instead of sampling the irradiance cubemap
+		static void SetIrradianceSH(const SphericalHarmonics& irradianceSH);
+		static bool GetUseIrradianceSH();
+		static void SetUseIrradianceSH(bool use);
+
 		static void DrawIBLBackground(const EditorCamera& camera);
 		static void DrawGroundPlane(int rows, int cols, float spacing = 1.0f);
 
@@ -50,6 +76,21 @@ namespace Hazel {
 		{
 			uint32_t DrawCalls = 0;
 			uint32_t SphereCount = 0;
+			uint32_t MeshCount = 0;
+			uint32_t Triangles = 0;
+			uint64_t BytesUploaded = 0;
+			uint32_t BuffersAllocated = 0;
+			uint32_t StateChanges = 0;
+			float SortTime = 0.0f; // ms
+			uint32_t PointLights = 0;
+			uint32_t LightIndices = 0;
+
+			static const uint32_t MaxRecordThreads = 32;
+			uint32_t RecordThreads = 0;
+			float RecordTimes[MaxRecordThreads] = {}; // ms spent recording, per thread
+			float MergeTime = 0.0f; // ms
+			uint64_t VertexBytes = 0; // Vertex data read by draws
+			uint64_t UnpackedVertexBytes = 0; // The same data in the unpacked formats
 		};
 		static void ResetStats();
 		static Statistics GetStats();
@@ -22,12 +22,14 @@ namespace Hazel {
 		virtual void Clear() = 0;
 
 		virtual void DrawArrays(const Ref<VertexArray>& vertexArray, uint32_t vertexCount = 0) = 0;
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
-		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount = 0) = 0;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) = 0;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0) = 0;
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount = 0, uint32_t firstVertex = 0) = 0;
 
 		virtual void SetLineWidth(float width = 0) = 0;
 		virtual void EnableDepthTest() = 0;
 		virtual void DisableDepthTest() = 0;
+		virtual void SetDepthWrite(bool enabled) = 0;
 
 		inline static API GetAPI() { return s_API; }
 	private:
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Hazel/Renderer/Buffer.h"
+
+namespace Hazel {
+
+	// Vertex buffer that stays mapped for its whole lifetime, so batches are written straight into GPU visible memory.
+	// The buffer is split into segments used in turn. Leaving a segment fences it, and a segment is only written
+	// again once that fence has signalled, so the CPU never overwrites data a pending draw still reads.
+	// Draws address their data through the allocation's offset, as a base vertex or base instance.
+	class RingBuffer : public VertexBuffer
+	{
+	public:
+		static const uint32_t SegmentCount = 3;
+
+		struct Allocation
+		{
+			void* Data = nullptr;
+			uint32_t Offset = 0; // In bytes from the start of the buffer
+			uint32_t Size = 0;
+		};
+	public:
+		virtual ~RingBuffer() = default;
+
+		// Space at an offset that is a multiple of alignment (any value, usually the vertex size). It stays free until
+		// committed, so a batch can reserve its largest size and commit what it used. Draw from committed data before
+		// the next Reserve, a segment is fenced once the ring moves past it.
+		virtual Allocation Reserve(uint32_t size, uint32_t alignment) = 0;
+		// Like Reserve, but takes whatever is left of the current segment, up to maxSize. Only moves on to the next
+		// segment when less than minSize is left, so batches of unknown size share a segment instead of each taking one.
+		virtual Allocation ReserveAvailable(uint32_t minSize, uint32_t maxSize, uint32_t alignment) = 0;
+		virtual void Commit(uint32_t size) = 0;
+
+		Allocation Allocate(uint32_t size, uint32_t alignment)
+		{
+			Allocation allocation = Reserve(size, alignment);
+			Commit(size);
+			return allocation;
+		}
+
+		virtual uint32_t GetSegmentSize() const = 0;
+		// Times Reserve had to wait for the GPU to release a segment
+		virtual uint32_t GetStallCount() const = 0;
+
+		// Largest single allocation is segmentSize
+		static Ref<RingBuffer> Create(uint32_t segmentSize);
+	};
+
+}
@@ -5,6 +5,14 @@
 
 namespace Hazel {
 
+	// Uniform location resolved once up front, so per-draw uploads skip the name lookup
+	struct UniformHandle
+	{
+		int32_t Location = -1;
+
+		bool IsValid() const { return Location != -1; }
+	};
+
 	class Shader
 	{
 	public:
@@ -22,6 +30,17 @@ namespace Hazel {
 		virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
 		virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
 
+		virtual UniformHandle GetUniformHandle(const std::string& name) = 0;
+
+		virtual void SetInt(UniformHandle handle, int value) = 0;
+		virtual void SetIntArray(UniformHandle handle, int* values, uint32_t count) = 0;
+		virtual void SetFloat(UniformHandle handle, float value) = 0;
+		virtual void SetFloat2(UniformHandle handle, const glm::vec2& value) = 0;
+		virtual void SetFloat3(UniformHandle handle, const glm::vec3& value) = 0;
+		virtual void SetFloat3Array(UniformHandle handle, float* values, uint32_t count) = 0;
+		virtual void SetFloat4(UniformHandle handle, const glm::vec4& value) = 0;
+		virtual void SetMat4(UniformHandle handle, const glm::mat4& value) = 0;
+
 		virtual const std::string& GetName() const = 0;
 
 		static Ref<Shader> Create(const std::string& filepath);
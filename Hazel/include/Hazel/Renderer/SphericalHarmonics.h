@@ -0,0 +1,26 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// Order 2 (9 coefficient) real spherical harmonics of an RGB function over the sphere, in the order
+	// 1, y, z, x, xy, yz, 3z^2 - 1, xz, x^2 - y^2
+	struct SphericalHarmonics
+	{
+		static const uint32_t CoefficientCount = 9;
+
+		glm::vec3 Coefficients[CoefficientCount] = {};
+
+		// Projects an equirectangular RGB(A) float image, rows bottom to top as uploaded for IBL_EquirectangularToCubemap.glsl.
+		// The rows are split into bands that are summed on worker threads.
+		static SphericalHarmonics ProjectEquirectangular(const float* pixels, uint32_t width, uint32_t height, uint32_t channels);
+
+		// Radiance coefficients to coefficients of irradiance / pi, the quantity the irradiance cubemap holds,
+		// so shading only has to evaluate the basis at the normal
+		SphericalHarmonics ConvolveIrradiance() const;
+
+		glm::vec3 Evaluate(const glm::vec3& direction) const;
+	};
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+
+namespace Hazel {
+
+	// Shader storage block (std430) attached to a fixed binding point, for arrays too large for a uniform block
+	class StorageBuffer
+	{
+	public:
+		virtual ~StorageBuffer() = default;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		// Reallocates the storage, previous contents are discarded
+		virtual void Resize(uint32_t size) = 0;
+
+		virtual void Bind() const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+		virtual uint32_t GetBinding() const = 0;
+
+		static Ref<StorageBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
@@ -14,6 +14,9 @@ namespace Hazel {
 		const Ref<Texture2D> GetTexture() const { return m_Texture; }
 		const glm::vec2* GetTexCoords() const { return m_TexCoords; }
 
+		// Moves the sub-texture into the [min, max] region of another texture, e.g. an atlas page its texture was packed in
+		void Remap(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max);
+
 		static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize);
 	private:
 		Ref<Texture2D> m_Texture;
@@ -45,6 +45,30 @@ namespace Hazel {
 		StbImage images[5];
 	};
 
+	enum class TextureFormat
+	{
+		None = 0,
+		R8,
+		RGB8,
+		RGBA8,
+		RGB16F,
+		RGBA16F
+	};
+
+	// Size in bytes of one texel as stored, see Texture::GetLevelData
+	inline uint32_t GetTextureFormatTexelSize(TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::R8:      return 1;
+			case TextureFormat::RGB8:    return 3;
+			case TextureFormat::RGBA8:   return 4;
+			case TextureFormat::RGB16F:  return 6;
+			case TextureFormat::RGBA16F: return 8;
+		}
+		return 0;
+	}
+
 	class Texture
 	{
 	public:
@@ -53,10 +77,18 @@ namespace Hazel {
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 		virtual uint32_t GetRendererID() const = 0;
+		virtual TextureFormat GetFormat() const = 0;
+		virtual uint32_t GetMipLevelCount() const = 0;
 
 		virtual void SetData(void* data, uint32_t size, uint32_t textureIndex = 0) = 0;
 		virtual void SetDataFromFrameBuffer(const Ref<FrameBuffer>& frameBuffer, uint32_t textureIndex = 0, int level = 0) = 0;
 
+		// Raw texels of one face/layer at one mip level, in storage order: half floats for the 16F formats, bytes otherwise
+		virtual void GetLevelData(void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) const = 0;
+		virtual void SetLevelData(const void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) = 0;
+		// Like SetLevelData for a band of rows, so large uploads can be spread out
+		virtual void SetLevelRows(const void* data, uint32_t size, uint32_t firstRow, uint32_t rowCount, uint32_t textureIndex = 0, int level = 0) = 0;
+
 		virtual void GenerateMipmaps() const = 0;
 		
 		virtual void Bind(uint32_t slot = 0, uint32_t textureIndex = 0) const = 0;
@@ -69,7 +101,13 @@ namespace Hazel {
 	class Texture2D : public Texture
 	{
 	public:
-		static Ref<Texture2D> Create(uint32_t width, uint32_t height);
+		// File the texture was loaded from, empty for textures created in memory
+		virtual const std::string& GetPath() const = 0;
+
+		// Level 0 texels of a rect, tightly packed in the texture's format
+		virtual void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+
+		static Ref<Texture2D> Create(uint32_t width, uint32_t height, TextureFormat format = TextureFormat::RGBA8, uint32_t mipLevels = 1);
 		static Ref<Texture2D> Create(const std::string& path, StbImage& stbImage = StbImage());
 		static Ref<Texture2D> Create(const Ref<FrameBuffer>& frameBuffer);
 		static Ref<Texture2D> CreateHdr(const std::string& hdrPath);
@@ -78,7 +116,38 @@ namespace Hazel {
 	class TextureCube : public Texture
 	{
 	public:
-		static Ref<TextureCube> Create(uint32_t width, uint32_t height);
+		static Ref<TextureCube> Create(uint32_t width, uint32_t height, uint32_t mipLevels = 1);
+	};
+
+	// Layers of equal size and format, sampled as one sampler2DArray. textureIndex selects the layer.
+	class Texture2DArray : public Texture
+	{
+	public:
+		virtual uint32_t GetLayerCount() const = 0;
+
+		// GPU-side copy of a texture with the same size and format into a layer, mipmaps are not regenerated
+		virtual void CopyLayer(const Ref<Texture2D>& source, uint32_t layer) = 0;
+
+		static Ref<Texture2DArray> Create(uint32_t width, uint32_t height, uint32_t layers, TextureFormat format);
+	};
+
+	// Reads textures back through a pixel pack buffer: copies are queued on the GPU and fenced, and the CPU
+	// only looks at the texels once they have arrived, so it never waits on the GPU unless asked to.
+	class TextureReadback
+	{
+	public:
+		virtual ~TextureReadback() = default;
+
+		// Queues a copy of one face/layer at one mip level to offset, laid out as GetLevelData returns it
+		virtual void Queue(const Ref<Texture>& texture, uint32_t textureIndex, int level, uint32_t offset) = 0;
+		// Fences the copies queued so far
+		virtual void Submit() = 0;
+		// Whether the submitted copies have arrived, wait blocks until they have
+		virtual bool IsComplete(bool wait = false) = 0;
+		// Texels of the completed copies. The pointer stays valid for the lifetime of the readback and can be read from any thread.
+		virtual const void* GetData() = 0;
+
+		static Ref<TextureReadback> Create(uint32_t size);
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/SubTexture2D.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// Skyline bottom-left rectangle packer. The top edge of what was placed so far is kept as a list of
+	// segments, each rect goes where its top ends lowest.
+	class SkylinePacker
+	{
+	public:
+		SkylinePacker(uint32_t width, uint32_t height);
+
+		// False when the rect fits nowhere
+		bool Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+
+		uint32_t GetUsedHeight() const { return m_UsedHeight; }
+	private:
+		// Where a rect placed at the start of a segment would rest, false if it runs off the page
+		bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+	private:
+		struct Segment
+		{
+			uint32_t X, Y, Width;
+		};
+
+		std::vector<Segment> m_Skyline;
+		uint32_t m_Width, m_Height;
+		uint32_t m_UsedHeight = 0;
+	};
+
+	// Packs small textures into shared RGBA8 pages, so quads using different textures can share a texture slot.
+	// Textures go into the first page with room, every page keeps its packer so later textures fill the gaps.
+	// Texels are decoded from the texture's file, the GPU copy is never read back.
+	// Each texture is surrounded by padding filled with its extruded edge texels, so filtering never reaches
+	// a neighbour. Rects are aligned to the padding and pages have mips down to log2(padding), the last level
+	// where the padding is still a texel wide.
+	// The atlas holds on to the textures it packed.
+	class TextureAtlas
+	{
+	public:
+		struct Region
+		{
+			Ref<Texture2D> Page;
+			glm::vec4 Rect; // UV min, max of the texture inside the page
+		};
+
+		// Textures larger than maxTextureSize on either side are not worth packing and are left alone
+		TextureAtlas(uint32_t pageSize = 2048, uint32_t maxTextureSize = 256, uint32_t padding = 4);
+
+		// Packs a texture and uploads it to its page. False if it can't be packed: too large, not loaded
+		// from a file or not an 8-bit format.
+		bool Add(const Ref<Texture2D>& texture);
+		// Packs several textures tallest first, which keeps the skylines flat, and regenerates mips once
+		void Add(std::vector<Ref<Texture2D>> textures);
+		void Clear();
+
+		// Null if the texture is not in the atlas
+		const Region* GetRegion(const Ref<Texture2D>& texture) const;
+		// Points a sub-texture of a packed texture at the atlas page instead, false if the texture is not packed
+		bool Remap(SubTexture2D& subTexture) const;
+
+		uint32_t GetPageCount() const { return (uint32_t)m_Pages.size(); }
+		uint32_t GetTextureCount() const { return (uint32_t)m_Regions.size(); }
+	private:
+		// Packs and uploads without touching the mips
+		bool Insert(const Ref<Texture2D>& texture);
+		void UpdateMips();
+	private:
+		struct Page
+		{
+			Ref<Texture2D> Texture;
+			SkylinePacker Packer;
+			bool MipsDirty = false;
+		};
+
+		uint32_t m_PageSize, m_MaxTextureSize, m_Padding;
+		uint32_t m_MipLevels = 1;
+
+		std::vector<Page> m_Pages;
+		std::unordered_map<Ref<Texture2D>, Region> m_Regions;
+	};
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+
+namespace Hazel {
+
+	// Block of std140 uniform data attached to a fixed binding point
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() = default;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		// Attaches the whole buffer to its binding point
+		virtual void Bind() const = 0;
+		// Attaches only [offset, offset + size) to the binding point, offset must be a multiple of GetOffsetAlignment()
+		virtual void BindRange(uint32_t offset, uint32_t size) const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+		virtual uint32_t GetBinding() const = 0;
+
+		static uint32_t GetOffsetAlignment();
+
+		static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
@@ -3,6 +3,8 @@
 #include "SceneCamera.h"
 #include "Hazel/Core/UUID.h"
 #include "Hazel/Renderer/Material.h"
+#include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Math/AABB.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -57,6 +59,11 @@ namespace Hazel {
 		Ref<Texture2D> Texture;
 		float TilingFactor = 1.0f;
 
+		// Where the scene's sprite atlas packed Texture, drawn in its place while TilingFactor is 1
+		Ref<Texture2D> AtlasPage;
+		glm::vec4 AtlasRect{ 0.0f, 0.0f, 1.0f, 1.0f }; // UV min, max
+		Ref<Texture2D> AtlasSource; // Texture the atlas fields were set for
+
 		SpriteRendererComponent() = default;
 		SpriteRendererComponent(const SpriteRendererComponent&) = default;
 		SpriteRendererComponent(const glm::vec4& color)
@@ -67,6 +74,8 @@ namespace Hazel {
 	{
 		PbrMaterial Material;
 		PbrMaterialTexture MaterialTexture;
+		// In LOD levels, positive values switch to coarser LODs sooner
+		float LodBias = 0.0f;
 
 		SphereRendererComponent() = default;
 		SphereRendererComponent(const SphereRendererComponent&) = default;
@@ -76,9 +85,60 @@ namespace Hazel {
 			: Material(), MaterialTexture(materialTexture) {}
 	};
 
+	struct MeshRendererComponent
+	{
+		Ref<Mesh> Mesh;
+		PbrMaterial Material;
+		PbrMaterialTexture MaterialTexture;
+
+		MeshRendererComponent() = default;
+		MeshRendererComponent(const MeshRendererComponent&) = default;
+		MeshRendererComponent(const Ref<Hazel::Mesh>& mesh)
+			: Mesh(mesh) {}
+	};
+
+	// Hides whatever is behind the box from the scene's occlusion culling. Keep the box inside the geometry it stands for,
+	// anything it covers that the geometry doesn't will be culled wrongly.
+	struct OccluderComponent
+	{
+		AABB Bounds{ glm::vec3(-1.0f), glm::vec3(1.0f) }; // In the entity's local space
+
+		OccluderComponent() = default;
+		OccluderComponent(const OccluderComponent&) = default;
+		OccluderComponent(const AABB& bounds)
+			: Bounds(bounds) {}
+	};
+
+	// Internal: tracks a renderable's proxy in the scene's bounds tree. Managed by Scene, never serialized.
+	struct RenderBoundsComponent
+	{
+		int32_t ProxyID = -1;
+		AABB LocalBounds;
+
+		// Translation at the last refit, the tree predicts further movement from the change
+		glm::vec3 Translation{ 0.0f };
+
+		RenderBoundsComponent() = default;
+		RenderBoundsComponent(const RenderBoundsComponent&) = default;
+		RenderBoundsComponent(const AABB& localBounds)
+			: LocalBounds(localBounds) {}
+	};
+
+	// Internal: tracks a sprite's proxy in the scene's sprite grid. Managed by Scene, never serialized.
+	struct SpriteBoundsComponent
+	{
+		int32_t ProxyID = -1;
+		AABB WorldBounds;
+
+		SpriteBoundsComponent() = default;
+		SpriteBoundsComponent(const SpriteBoundsComponent&) = default;
+	};
+
 	struct PointLightComponent
 	{
 		glm::vec3 Color{ 300.0f, 300.0f, 300.0f};
+		// Distance at which the light's contribution fades to zero
+		float Range = 25.0f;
 
 		PointLightComponent() = default;
 		PointLightComponent(const PointLightComponent&) = default;
@@ -41,6 +41,14 @@ namespace Hazel {
 			return m_Scene->m_Registry.get<T>(m_EntityHandle);
 		}
 
+		// Lets the scene know a component was changed in place, after running func(T&) on it if given
+		template<typename T, typename... Func>
+		T& PatchComponent(Func&&... func)
+		{
+			HZ_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			return m_Scene->m_Registry.patch<T>(m_EntityHandle, std::forward<Func>(func)...);
+		}
+
 		template<typename T>
 		bool HasComponent()
 		{
@@ -4,15 +4,35 @@
 #include "Hazel/Core/Timestep.h"
 #include "Hazel/Renderer/Renderer3D.h"
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Renderer/OcclusionCuller.h"
+#include "Hazel/Renderer/TextureAtlas.h"
+#include "Hazel/Math/DynamicAABBTree.h"
+#include "Hazel/Math/SpatialHashGrid.h"
 
 #include "entt.hpp"
 
 namespace Hazel {
 
 	class Entity;
+	struct SpriteRendererComponent;
 
 	class Scene
 	{
+	public:
+		struct Statistics
+		{
+			uint32_t VisibleRenderables = 0;
+			uint32_t CulledRenderables = 0;
+			// Frustum visible renderables the occlusion culler removed
+			uint32_t OccludedRenderables = 0;
+			uint32_t Occluders = 0;
+			float OcclusionRasterTime = 0.0f; // ms
+			float OcclusionTestTime = 0.0f; // ms
+			uint32_t AtlasPages = 0;
+			uint32_t AtlasTextures = 0;
+			uint32_t VisibleSprites = 0;
+			uint32_t CulledSprites = 0;
+		};
 	public:
 		Scene();
 		~Scene();
@@ -33,15 +53,112 @@ namespace Hazel {
 		void DuplicateEntity(Entity entity);
 
 		Entity GetPrimaryCameraEntity();
+		bool IsValid(entt::entity handle) const { return m_Registry.valid(handle); }
+		// Closest sphere, mesh or sprite the ray hits within maxT, tested against the bounds as of the last update
+		Entity RayCast(const Ray& ray, float maxT = std::numeric_limits<float>::max(), float* hitT = nullptr);
+
+		// Assigns a sprite's texture and packs it into the sprite atlas
+		void SetSpriteTexture(Entity entity, const Ref<Texture2D>& texture);
+		// Packs the textures of all sprites that are not drawn from the atlas yet, done once a scene is loaded
+		void PackSprites();
+
+		const Statistics& GetStatistics() const { return m_Stats; }
+
+		bool IsOcclusionCullingEnabled() const { return m_OcclusionCulling; }
+		void SetOcclusionCulling(bool enabled) { m_OcclusionCulling = enabled; }
 	private:
 		LightParams GetLightParams();
 
+		// Refits the tree proxies of the renderables added, changed or moved since the last update
+		void UpdateRenderBounds();
+		void CullRenderables(const glm::mat4& viewProjection);
+		// Removes the visible entities hidden behind occluders
+		void CullOccluded(const glm::mat4& viewProjection);
+		// Turns the visible entities into draws on the job system's threads
+		void RecordRenderables();
+		// Refits the grid proxies of the sprites added or moved since the last update
+		void UpdateSpriteBounds();
+		// Finds the visible sprites through the grid cells under the view
+		void CullSprites(const glm::mat4& viewProjection);
+		// Points a sprite at its texture's atlas region, or clears the region if the texture is not packed
+		void SetSpriteAtlasRegion(SpriteRendererComponent& sprite);
+		// Gathers the visible sprites into the scratch arrays and submits them to Renderer2D in one call.
+		// Sprites whose texture changed without going through the atlas are drawn from the texture itself.
+		void DrawSprites();
+		void OnRenderBoundsDestroy(entt::registry& registry, entt::entity entity);
+		void OnSpriteBoundsDestroy(entt::registry& registry, entt::entity entity);
+		// Sphere and mesh renderers being added, patched or removed
+		void OnRenderableChange(entt::registry& registry, entt::entity entity);
+		void OnSpriteRendererConstruct(entt::registry& registry, entt::entity entity);
+		void OnSpriteRendererDestroy(entt::registry& registry, entt::entity entity);
+		// Transforms are changed in place, writers patch them (Entity::PatchComponent) so the proxies of moved
+		// renderables and sprites get refit. Drawing and picking read the transforms themselves.
+		void OnTransformUpdate(entt::registry& registry, entt::entity entity);
+
 		template<typename T>
 		void OnComponentAdded(Entity entity, T& component);
 	private:
+		// Entities per ParallelFor batch at the least, small scenes stay on the main thread
+		static const uint32_t RecordBatchSize = 256;
+		// World units per sprite grid cell, a few times the size of a typical sprite
+		static constexpr float SpriteCellSize = 8.0f;
+
+		// Declared before the registry so proxies can still be released while it is torn down
+		DynamicAABBTree m_BoundsTree;
+		SpatialHashGrid m_SpriteGrid{ SpriteCellSize };
 		entt::registry m_Registry;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
 
+		std::vector<entt::entity> m_VisibleEntities;
+
+		bool m_OcclusionCulling = false;
+		OcclusionCuller m_OcclusionCuller;
+		std::vector<uint8_t> m_Occluded;
+
+		// Renderables added or patched since the last refit, as reported by the registry signals
+		std::vector<entt::entity> m_MovedRenderables;
+		// Their new bounds, one list per job system thread
+		struct RenderBoundsUpdate
+		{
+			entt::entity Entity;
+			AABB LocalBounds;
+			AABB WorldBounds;
+		};
+		std::vector<std::vector<RenderBoundsUpdate>> m_BoundsUpdates;
+
+		// Sprite attributes as parallel arrays for Renderer2D::DrawQuads, kept to reuse their storage
+		struct SpriteArrays
+		{
+			std::vector<glm::mat4> Transforms;
+			std::vector<glm::vec4> Colors;
+			std::vector<const Texture2D*> Textures;
+			std::vector<glm::vec4> TexRects;
+			std::vector<float> TilingFactors;
+			std::vector<int> EntityIDs;
+		};
+		SpriteArrays m_Sprites;
+		// Shared with the scenes copied from this one, whose sprites point into the same pages
+		Ref<TextureAtlas> m_SpriteAtlas;
+
+		// Sprites added or patched since the last grid update, as reported by the registry signals
+		std::vector<entt::entity> m_MovedSprites;
+		// Sprites that moved since the last grid update and the depth range they span, one per job system thread
+		struct SpriteBoundsUpdates
+		{
+			struct Update
+			{
+				entt::entity Entity;
+				AABB WorldBounds;
+			};
+			std::vector<Update> Moved;
+			float MinZ, MaxZ;
+		};
+		std::vector<SpriteBoundsUpdates> m_SpriteBoundsUpdates;
+		// Sprites only ever span this depth range, the view is cut down to it before querying the grid
+		float m_SpriteMinZ = 0.0f, m_SpriteMaxZ = 0.0f;
+		std::vector<entt::entity> m_VisibleSprites;
+		Statistics m_Stats;
+
 		friend class Entity;
 		friend class SceneSerializer;
 		friend class SceneHierarchyPanel;
@@ -8,10 +8,20 @@ namespace Hazel {
 	{
 	public:
 		virtual ~ScriptableEntity() = default;
+		// Transforms are handed out patched, whatever a script does with them the scene refits the entity's bounds
 		template<typename T>
 		T& GetComponent()
 		{
-			return m_Entity.GetComponent<T>();
+			if constexpr (std::is_same_v<T, TransformComponent>)
+				return m_Entity.PatchComponent<T>();
+			else
+				return m_Entity.GetComponent<T>();
+		}
+
+		template<typename T, typename... Func>
+		T& PatchComponent(Func&&... func)
+		{
+			return m_Entity.PatchComponent<T>(std::forward<Func>(func)...);
 		}
 	protected:
 		virtual void OnCreate() {}
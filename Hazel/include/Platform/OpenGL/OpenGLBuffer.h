@@ -26,14 +26,17 @@ namespace Hazel {
 	{
 	public:
 		OpenGLIndexBuffer(uint32_t* index, uint32_t count);
+		OpenGLIndexBuffer(uint16_t* index, uint32_t count);
 		virtual ~OpenGLIndexBuffer();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
 		virtual uint32_t GetCount() const override { return m_Count; }
+		virtual IndexType GetIndexType() const override { return m_IndexType; }
 	private:
 		uint32_t m_RendererID;
 		uint32_t m_Count;
+		IndexType m_IndexType;
 	};
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Hazel/Renderer/FrameBuffer.h"
 
+#include <deque>
+
 namespace Hazel {
 
 	class OpenGLFrameBuffer : public FrameBuffer
@@ -17,6 +19,8 @@ namespace Hazel {
 
 		virtual void Resize(uint32_t width, uint32_t height) override;
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+		virtual uint32_t ReadPixelsAsync(uint32_t attachmentIndex, int x, int y, uint32_t width = 1, uint32_t height = 1) override;
+		virtual bool PollReadPixels(PixelReadback& result) override;
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
 
@@ -33,6 +37,23 @@ namespace Hazel {
 
 		std::vector<uint32_t> m_ColorAttachments;
 		uint32_t m_DepthAttachment;
+
+		// Pixel pack buffers the async reads copy into, reused in order once their fence signals
+		static const uint32_t ReadbackSlotCount = 3;
+		struct ReadbackSlot
+		{
+			uint32_t Buffer = 0;
+			uint32_t Size = 0;
+			void* Fence = nullptr;
+			PixelReadback Result;
+		};
+
+		void RetireReadback(bool wait);
+
+		std::array<ReadbackSlot, ReadbackSlotCount> m_ReadbackSlots;
+		uint32_t m_FirstPendingReadback = 0, m_PendingReadbackCount = 0;
+		std::deque<PixelReadback> m_FinishedReadbacks;
+		uint32_t m_NextReadbackID = 1;
 	};
 
 }
\ No newline at end of file
@@ -14,12 +14,14 @@ namespace Hazel {
 		virtual void Clear() override;
 
 		virtual void DrawArrays(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount) override;
-		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) override;
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex) override;
 
 		virtual void SetLineWidth(float width) override;
 		virtual void EnableDepthTest() override;
 		virtual void DisableDepthTest() override;
+		virtual void SetDepthWrite(bool enabled) override;
 	};
 
 }
\ No newline at end of file
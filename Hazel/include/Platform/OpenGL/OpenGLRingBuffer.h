@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Hazel/Renderer/RingBuffer.h"
+
+namespace Hazel {
+
+	class OpenGLRingBuffer : public RingBuffer
+	{
+	public:
+		OpenGLRingBuffer(uint32_t segmentSize);
+		virtual ~OpenGLRingBuffer();
+
+		virtual Allocation Reserve(uint32_t size, uint32_t alignment) override;
+		virtual Allocation ReserveAvailable(uint32_t minSize, uint32_t maxSize, uint32_t alignment) override;
+		virtual void Commit(uint32_t size) override;
+
+		virtual uint32_t GetSegmentSize() const override { return m_SegmentSize; }
+		virtual uint32_t GetStallCount() const override { return m_StallCount; }
+
+		// Written through Reserve, there is nothing to copy
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(BufferLayout layout) override { m_Layout = layout; }
+	private:
+		void NextSegment();
+	private:
+		uint32_t m_RendererID = 0;
+		uint8_t* m_MappedData = nullptr;
+		uint32_t m_SegmentSize = 0;
+
+		uint32_t m_Segment = 0;
+		uint32_t m_Head = 0;
+		uint32_t m_Reserved = 0;
+		void* m_Fences[SegmentCount] = {};
+		uint32_t m_StallCount = 0;
+
+		BufferLayout m_Layout;
+	};
+
+}
@@ -25,6 +25,17 @@ namespace Hazel {
 		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override;
 		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
 
+		virtual UniformHandle GetUniformHandle(const std::string& name) override;
+
+		virtual void SetInt(UniformHandle handle, int value) override;
+		virtual void SetIntArray(UniformHandle handle, int* values, uint32_t count) override;
+		virtual void SetFloat(UniformHandle handle, float value) override;
+		virtual void SetFloat2(UniformHandle handle, const glm::vec2& value) override;
+		virtual void SetFloat3(UniformHandle handle, const glm::vec3& value) override;
+		virtual void SetFloat3Array(UniformHandle handle, float* values, uint32_t count) override;
+		virtual void SetFloat4(UniformHandle handle, const glm::vec4& value) override;
+		virtual void SetMat4(UniformHandle handle, const glm::mat4& value) override;
+
 		virtual const std::string& GetName() const override;
 
 		void UploadUniformInt(const std::string& name, int value);
@@ -41,9 +52,14 @@ namespace Hazel {
 		std::string ReadFile(const std::string& filepath);
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
 		void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
+		void ReflectUniforms();
+		int GetUniformLocation(const std::string& name);
 	private:
 		std::string m_Name;
 		uint32_t m_RendererID;
+
+		std::unordered_map<std::string, int> m_UniformLocations;
+		std::unordered_set<std::string> m_MissingUniforms;
 	};
 
 }
\ No newline at end of file
@@ -9,7 +9,7 @@ namespace Hazel {
 	class OpenGLTexture2D : public Texture2D
 	{
 	public:
-		OpenGLTexture2D(uint32_t width, uint32_t height);
+		OpenGLTexture2D(uint32_t width, uint32_t height, TextureFormat format, uint32_t mipLevels);
 		OpenGLTexture2D(const std::string& path, StbImage& stbImage);
 		OpenGLTexture2D(const Ref<FrameBuffer>& frameBuffer);
 		OpenGLTexture2D(const std::string& hdrPath);
@@ -18,9 +18,17 @@ namespace Hazel {
 		virtual uint32_t GetWidth() const override { return m_Width; }
 		virtual uint32_t GetHeight() const override { return m_Height; }
 		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual TextureFormat GetFormat() const override;
+		virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+		virtual const std::string& GetPath() const override { return m_Path; }
 
 		virtual void SetData(void* data, uint32_t size, uint32_t textureIndex = 0) override;
 		virtual void SetDataFromFrameBuffer(const Ref<FrameBuffer>& frameBuffer, uint32_t textureIndex, int level) override;
+
+		virtual void GetLevelData(void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) const override;
+		virtual void SetLevelData(const void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) override;
+		virtual void SetLevelRows(const void* data, uint32_t size, uint32_t firstRow, uint32_t rowCount, uint32_t textureIndex = 0, int level = 0) override;
+		virtual void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 	
 		virtual void GenerateMipmaps() const override;
 
@@ -36,6 +44,7 @@ namespace Hazel {
 		std::string m_Path;
 		bool m_IsLoaded = false;
 		uint32_t m_Width, m_Height;
+		uint32_t m_MipLevels = 1;
 		uint32_t m_RendererID;
 		GLenum m_InternalFormat, m_DataFormat;
 	};
@@ -43,16 +52,22 @@ namespace Hazel {
 	class OpenGLTextureCube : public TextureCube
 	{
 	public:
-		OpenGLTextureCube(uint32_t width, uint32_t height);
+		OpenGLTextureCube(uint32_t width, uint32_t height, uint32_t mipLevels);
 		virtual ~OpenGLTextureCube();
 
 		virtual uint32_t GetWidth() const override { return m_Width; }
 		virtual uint32_t GetHeight() const override { return m_Height; }
 		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual TextureFormat GetFormat() const override;
+		virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
 
 		virtual void SetData(void* data, uint32_t size, uint32_t textureIndex = 0) override;
 		virtual void SetDataFromFrameBuffer(const Ref<FrameBuffer>& frameBuffer, uint32_t textureIndex, int level) override;
 
+		virtual void GetLevelData(void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) const override;
+		virtual void SetLevelData(const void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) override;
+		virtual void SetLevelRows(const void* data, uint32_t size, uint32_t firstRow, uint32_t rowCount, uint32_t textureIndex = 0, int level = 0) override;
+
 		virtual void GenerateMipmaps() const override;
 
 		virtual void Bind(uint32_t slot = 0, uint32_t textureIndex = 0) const override;
@@ -67,7 +82,66 @@ namespace Hazel {
 		std::string m_Path;
 		bool m_IsLoaded = false;
 		uint32_t m_Width, m_Height;
+		uint32_t m_MipLevels = 1;
 		uint32_t m_RendererID;
 		GLenum m_InternalFormat, m_DataFormat;
 	};
-}
\ No newline at end of file
+
+	class OpenGLTexture2DArray : public Texture2DArray
+	{
+	public:
+		OpenGLTexture2DArray(uint32_t width, uint32_t height, uint32_t layers, TextureFormat format);
+		virtual ~OpenGLTexture2DArray();
+
+		virtual uint32_t GetWidth() const override { return m_Width; }
+		virtual uint32_t GetHeight() const override { return m_Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual TextureFormat GetFormat() const override { return m_Format; }
+		virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+		virtual uint32_t GetLayerCount() const override { return m_Layers; }
+
+		virtual void SetData(void* data, uint32_t size, uint32_t textureIndex = 0) override;
+		virtual void SetDataFromFrameBuffer(const Ref<FrameBuffer>& frameBuffer, uint32_t textureIndex, int level) override;
+
+		virtual void GetLevelData(void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) const override;
+		virtual void SetLevelData(const void* data, uint32_t size, uint32_t textureIndex = 0, int level = 0) override;
+		virtual void SetLevelRows(const void* data, uint32_t size, uint32_t firstRow, uint32_t rowCount, uint32_t textureIndex = 0, int level = 0) override;
+		virtual void CopyLayer(const Ref<Texture2D>& source, uint32_t layer) override;
+
+		virtual void GenerateMipmaps() const override;
+
+		virtual void Bind(uint32_t slot = 0, uint32_t textureIndex = 0) const override;
+
+		virtual bool IsLoaded() const override { return true; }
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == ((OpenGLTexture2DArray&)other).m_RendererID;
+		}
+	private:
+		uint32_t m_Width, m_Height, m_Layers;
+		uint32_t m_MipLevels;
+		uint32_t m_RendererID;
+		TextureFormat m_Format;
+		GLenum m_InternalFormat, m_DataFormat;
+	};
+
+	class OpenGLTextureReadback : public TextureReadback
+	{
+	public:
+		OpenGLTextureReadback(uint32_t size);
+		virtual ~OpenGLTextureReadback();
+
+		virtual void Queue(const Ref<Texture>& texture, uint32_t textureIndex, int level, uint32_t offset) override;
+		virtual void Submit() override;
+		virtual bool IsComplete(bool wait = false) override;
+		virtual const void* GetData() override;
+	private:
+		uint32_t m_RendererID = 0;
+		uint32_t m_Size;
+		void* m_Fence = nullptr;
+		bool m_Complete = false;
+		const void* m_MappedData = nullptr;
+	};
+
+}
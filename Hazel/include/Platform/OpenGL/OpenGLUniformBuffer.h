@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Hazel/Renderer/UniformBuffer.h"
+
+namespace Hazel {
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		OpenGLUniformBuffer(uint32_t size, uint32_t binding);
+		virtual ~OpenGLUniformBuffer();
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+
+		virtual void Bind() const override;
+		virtual void BindRange(uint32_t offset, uint32_t size) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+		virtual uint32_t GetBinding() const override { return m_Binding; }
+
+		static uint32_t GetOffsetAlignment();
+	private:
+		uint32_t m_RendererID = 0;
+		uint32_t m_Size = 0;
+		uint32_t m_Binding = 0;
+	};
+
+}
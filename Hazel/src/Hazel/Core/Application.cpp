@@ -2,6 +2,7 @@
 
 #include "Hazel/Core/TimeStep.h"
 #include "Hazel/Core/Input.h"
+#include "Hazel/Core/JobSystem.h"
 #include "Hazel/Renderer/Renderer.h"
 
 #include <glfw/glfw3.h>
@@ -18,6 +19,7 @@ namespace Hazel {
 		m_Window = std::unique_ptr<Window>(Window::Create(WindowProps(name)));
 		m_Window->SetEventCallback(HZ_BIND_EVENT_FN(Application::OnEvent));
 
+		JobSystem::Init();
 		Renderer::Init();
 
 		m_ImGuiLayer = new ImGuiLayer();
@@ -26,6 +28,7 @@ namespace Hazel {
 
 	Application::~Application()
 	{
+		JobSystem::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
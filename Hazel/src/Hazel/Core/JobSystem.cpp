@@ -0,0 +1,147 @@
+#include "Hazel/Core/JobSystem.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Workers;
+		std::mutex Mutex;
+		std::condition_variable WakeCondition;
+		std::condition_variable DoneCondition;
+		uint64_t Generation = 0;
+		uint32_t ActiveWorkers = 0;
+		bool Quit = false;
+
+		// The loop being run. Only written under the mutex while no worker is active.
+		const JobSystem::RangeFunction* Function = nullptr;
+		uint32_t Count = 0;
+		uint32_t BatchSize = 0;
+		uint32_t BatchCount = 0;
+		std::atomic<uint32_t> NextBatch = 0;
+		std::atomic<uint32_t> DoneBatches = 0;
+	};
+
+	static JobSystemData s_JobData;
+
+	namespace Utils {
+
+		// Batches are claimed one at a time, so fast threads pick up the slack of slow ones
+		static void RunBatches(uint32_t threadIndex)
+		{
+			uint32_t batch;
+			while ((batch = s_JobData.NextBatch.fetch_add(1)) < s_JobData.BatchCount)
+			{
+				uint32_t begin = batch * s_JobData.BatchSize;
+				uint32_t end = std::min(begin + s_JobData.BatchSize, s_JobData.Count);
+				(*s_JobData.Function)(begin, end, threadIndex);
+
+				if (s_JobData.DoneBatches.fetch_add(1) + 1 == s_JobData.BatchCount)
+				{
+					std::lock_guard<std::mutex> lock(s_JobData.Mutex);
+					s_JobData.DoneCondition.notify_all();
+				}
+			}
+		}
+
+		static void WorkerLoop(uint32_t threadIndex)
+		{
+			uint64_t generation = 0;
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(s_JobData.Mutex);
+					s_JobData.WakeCondition.wait(lock, [&]() { return s_JobData.Quit || s_JobData.Generation != generation; });
+					if (s_JobData.Quit)
+						return;
+
+					generation = s_JobData.Generation;
+					s_JobData.ActiveWorkers++;
+				}
+
+				RunBatches(threadIndex);
+
+				{
+					std::lock_guard<std::mutex> lock(s_JobData.Mutex);
+					s_JobData.ActiveWorkers--;
+				}
+				s_JobData.DoneCondition.notify_all();
+			}
+		}
+
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		HZ_CORE_ASSERT(s_JobData.Workers.empty(), "JobSystem already initialized!");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_JobData.Quit = false;
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_JobData.Workers.emplace_back(Utils::WorkerLoop, i + 1);
+
+		HZ_CORE_INFO("JobSystem started {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_JobData.Mutex);
+			s_JobData.Quit = true;
+		}
+		s_JobData.WakeCondition.notify_all();
+
+		for (std::thread& worker : s_JobData.Workers)
+			worker.join();
+		s_JobData.Workers.clear();
+	}
+
+	uint32_t JobSystem::GetThreadCount()
+	{
+		return (uint32_t)s_JobData.Workers.size() + 1;
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t minBatchSize, const RangeFunction& function)
+	{
+		if (count == 0)
+			return;
+
+		// A handful of batches per thread evens out uneven batches without much claiming overhead
+		uint32_t threadCount = GetThreadCount();
+		uint32_t batchSize = std::max(minBatchSize, (count + threadCount * 4 - 1) / (threadCount * 4));
+		batchSize = std::max(batchSize, 1u);
+		uint32_t batchCount = (count + batchSize - 1) / batchSize;
+		if (batchCount == 1 || threadCount == 1)
+		{
+			function(0, count, 0);
+			return;
+		}
+
+		{
+			// Workers still leaving the previous loop read its fields, so they have to be gone first
+			std::unique_lock<std::mutex> lock(s_JobData.Mutex);
+			s_JobData.DoneCondition.wait(lock, []() { return s_JobData.ActiveWorkers == 0; });
+
+			s_JobData.Function = &function;
+			s_JobData.Count = count;
+			s_JobData.BatchSize = batchSize;
+			s_JobData.BatchCount = batchCount;
+			s_JobData.NextBatch = 0;
+			s_JobData.DoneBatches = 0;
+			s_JobData.Generation++;
+		}
+		s_JobData.WakeCondition.notify_all();
+
+		Utils::RunBatches(0);
+
+		std::unique_lock<std::mutex> lock(s_JobData.Mutex);
+		s_JobData.DoneCondition.wait(lock, []() { return s_JobData.DoneBatches == s_JobData.BatchCount; });
+	}
+
+}
@@ -0,0 +1,355 @@
+#include "Hazel/Math/DynamicAABBTree.h"
+
+namespace Hazel {
+
+	// Fat AABB margin, relative to the size of the proxy plus a small absolute part
+	static constexpr float s_RelativeMargin = 0.1f;
+	static constexpr float s_AbsoluteMargin = 0.05f;
+	// Displacement is extrapolated this many frames ahead
+	static constexpr float s_DisplacementMultiplier = 4.0f;
+
+	static AABB Fatten(const AABB& aabb)
+	{
+		glm::vec3 margin = (aabb.Max - aabb.Min) * s_RelativeMargin + glm::vec3(s_AbsoluteMargin);
+		return { aabb.Min - margin, aabb.Max + margin };
+	}
+
+	DynamicAABBTree::DynamicAABBTree()
+	{
+		m_Nodes.reserve(16);
+	}
+
+	int32_t DynamicAABBTree::AllocateNode()
+	{
+		if (m_FreeList == NullNode)
+		{
+			m_Nodes.emplace_back();
+			m_Nodes.back().Next = NullNode;
+			m_FreeList = (int32_t)m_Nodes.size() - 1;
+		}
+
+		int32_t nodeID = m_FreeList;
+		Node& node = m_Nodes[nodeID];
+		m_FreeList = node.Next;
+		node.Parent = NullNode;
+		node.Child1 = NullNode;
+		node.Child2 = NullNode;
+		node.Height = 0;
+		node.UserData = 0;
+		return nodeID;
+	}
+
+	void DynamicAABBTree::FreeNode(int32_t nodeID)
+	{
+		Node& node = m_Nodes[nodeID];
+		node.Next = m_FreeList;
+		node.Height = -1;
+		m_FreeList = nodeID;
+	}
+
+	int32_t DynamicAABBTree::CreateProxy(const AABB& aabb, uint32_t userData)
+	{
+		int32_t proxyID = AllocateNode();
+		m_Nodes[proxyID].Box = Fatten(aabb);
+		m_Nodes[proxyID].UserData = userData;
+
+		InsertLeaf(proxyID);
+		m_ProxyCount++;
+		return proxyID;
+	}
+
+	void DynamicAABBTree::DestroyProxy(int32_t proxyID)
+	{
+		HZ_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Nodes.size() && m_Nodes[proxyID].IsLeaf(), "Invalid proxy!");
+
+		RemoveLeaf(proxyID);
+		FreeNode(proxyID);
+		m_ProxyCount--;
+	}
+
+	bool DynamicAABBTree::MoveProxy(int32_t proxyID, const AABB& aabb, const glm::vec3& displacement)
+	{
+		HZ_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Nodes.size() && m_Nodes[proxyID].IsLeaf(), "Invalid proxy!");
+
+		Node& node = m_Nodes[proxyID];
+		if (node.Box.Contains(aabb))
+		{
+			// Still shrink-wrap proxies that became much smaller than their fat box
+			AABB fat = Fatten(aabb);
+			AABB huge = { fat.Min - (fat.Max - fat.Min), fat.Max + (fat.Max - fat.Min) };
+			if (huge.Contains(node.Box))
+				return false;
+		}
+
+		RemoveLeaf(proxyID);
+
+		// Predict where the proxy is heading so a steadily moving object is not reinserted every frame
+		AABB fat = Fatten(aabb);
+		glm::vec3 d = displacement * s_DisplacementMultiplier;
+		fat.Min += glm::min(d, glm::vec3(0.0f));
+		fat.Max += glm::max(d, glm::vec3(0.0f));
+		m_Nodes[proxyID].Box = fat;
+
+		InsertLeaf(proxyID);
+		return true;
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NullNode;
+		m_FreeList = NullNode;
+		m_ProxyCount = 0;
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32_t leaf)
+	{
+		if (m_Root == NullNode)
+		{
+			m_Root = leaf;
+			m_Nodes[m_Root].Parent = NullNode;
+			return;
+		}
+
+		// Find the best sibling with the surface area heuristic
+		AABB leafBox = m_Nodes[leaf].Box;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const Node& node = m_Nodes[index];
+			int32_t child1 = node.Child1;
+			int32_t child2 = node.Child2;
+
+			float area = node.Box.GetSurfaceArea();
+			float combinedArea = AABB::Union(node.Box, leafBox).GetSurfaceArea();
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int32_t child)
+			{
+				const Node& childNode = m_Nodes[child];
+				float newArea = AABB::Union(leafBox, childNode.Box).GetSurfaceArea();
+				if (childNode.IsLeaf())
+					return newArea + inheritanceCost;
+				return (newArea - childNode.Box.GetSurfaceArea()) + inheritanceCost;
+			};
+
+			float cost1 = descendCost(child1);
+			float cost2 = descendCost(child2);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		int32_t sibling = index;
+
+		// Create a new parent
+		int32_t oldParent = m_Nodes[sibling].Parent;
+		int32_t newParent = AllocateNode();
+		m_Nodes[newParent].Parent = oldParent;
+		m_Nodes[newParent].Box = AABB::Union(leafBox, m_Nodes[sibling].Box);
+		m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+		m_Nodes[newParent].Child1 = sibling;
+		m_Nodes[newParent].Child2 = leaf;
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		if (oldParent != NullNode)
+		{
+			if (m_Nodes[oldParent].Child1 == sibling)
+				m_Nodes[oldParent].Child1 = newParent;
+			else
+				m_Nodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			m_Root = newParent;
+		}
+
+		// Walk back up the tree fixing heights and AABBs
+		index = m_Nodes[leaf].Parent;
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			int32_t child1 = m_Nodes[index].Child1;
+			int32_t child2 = m_Nodes[index].Child2;
+			m_Nodes[index].Height = 1 + std::max(m_Nodes[child1].Height, m_Nodes[child2].Height);
+			m_Nodes[index].Box = AABB::Union(m_Nodes[child1].Box, m_Nodes[child2].Box);
+
+			index = m_Nodes[index].Parent;
+		}
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NullNode;
+			return;
+		}
+
+		int32_t parent = m_Nodes[leaf].Parent;
+		int32_t grandParent = m_Nodes[parent].Parent;
+		int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		if (grandParent != NullNode)
+		{
+			// Destroy parent and connect sibling to grandParent
+			if (m_Nodes[grandParent].Child1 == parent)
+				m_Nodes[grandParent].Child1 = sibling;
+			else
+				m_Nodes[grandParent].Child2 = sibling;
+			m_Nodes[sibling].Parent = grandParent;
+			FreeNode(parent);
+
+			int32_t index = grandParent;
+			while (index != NullNode)
+			{
+				index = Balance(index);
+
+				int32_t child1 = m_Nodes[index].Child1;
+				int32_t child2 = m_Nodes[index].Child2;
+				m_Nodes[index].Box = AABB::Union(m_Nodes[child1].Box, m_Nodes[child2].Box);
+				m_Nodes[index].Height = 1 + std::max(m_Nodes[child1].Height, m_Nodes[child2].Height);
+
+				index = m_Nodes[index].Parent;
+			}
+		}
+		else
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = NullNode;
+			FreeNode(parent);
+		}
+	}
+
+	// Performs a left or right rotation if node A is imbalanced, returns the new root of the subtree
+	int32_t DynamicAABBTree::Balance(int32_t iA)
+	{
+		Node* A = &m_Nodes[iA];
+		if (A->IsLeaf() || A->Height < 2)
+			return iA;
+
+		int32_t iB = A->Child1;
+		int32_t iC = A->Child2;
+		Node* B = &m_Nodes[iB];
+		Node* C = &m_Nodes[iC];
+
+		int32_t balance = C->Height - B->Height;
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			int32_t iF = C->Child1;
+			int32_t iG = C->Child2;
+			Node* F = &m_Nodes[iF];
+			Node* G = &m_Nodes[iG];
+
+			// Swap A and C
+			C->Child1 = iA;
+			C->Parent = A->Parent;
+			A->Parent = iC;
+
+			// A's old parent should point to C
+			if (C->Parent != NullNode)
+			{
+				if (m_Nodes[C->Parent].Child1 == iA)
+					m_Nodes[C->Parent].Child1 = iC;
+				else
+					m_Nodes[C->Parent].Child2 = iC;
+			}
+			else
+			{
+				m_Root = iC;
+			}
+
+			// Rotate
+			if (F->Height > G->Height)
+			{
+				C->Child2 = iF;
+				A->Child2 = iG;
+				G->Parent = iA;
+				A->Box = AABB::Union(B->Box, G->Box);
+				C->Box = AABB::Union(A->Box, F->Box);
+
+				A->Height = 1 + std::max(B->Height, G->Height);
+				C->Height = 1 + std::max(A->Height, F->Height);
+			}
+			else
+			{
+				C->Child2 = iG;
+				A->Child2 = iF;
+				F->Parent = iA;
+				A->Box = AABB::Union(B->Box, F->Box);
+				C->Box = AABB::Union(A->Box, G->Box);
+
+				A->Height = 1 + std::max(B->Height, F->Height);
+				C->Height = 1 + std::max(A->Height, G->Height);
+			}
+
+			return iC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			int32_t iD = B->Child1;
+			int32_t iE = B->Child2;
+			Node* D = &m_Nodes[iD];
+			Node* E = &m_Nodes[iE];
+
+			// Swap A and B
+			B->Child1 = iA;
+			B->Parent = A->Parent;
+			A->Parent = iB;
+
+			// A's old parent should point to B
+			if (B->Parent != NullNode)
+			{
+				if (m_Nodes[B->Parent].Child1 == iA)
+					m_Nodes[B->Parent].Child1 = iB;
+				else
+					m_Nodes[B->Parent].Child2 = iB;
+			}
+			else
+			{
+				m_Root = iB;
+			}
+
+			// Rotate
+			if (D->Height > E->Height)
+			{
+				B->Child2 = iD;
+				A->Child1 = iE;
+				E->Parent = iA;
+				A->Box = AABB::Union(C->Box, E->Box);
+				B->Box = AABB::Union(A->Box, D->Box);
+
+				A->Height = 1 + std::max(C->Height, E->Height);
+				B->Height = 1 + std::max(A->Height, D->Height);
+			}
+			else
+			{
+				B->Child2 = iE;
+				A->Child1 = iD;
+				D->Parent = iA;
+				A->Box = AABB::Union(C->Box, D->Box);
+				B->Box = AABB::Union(A->Box, E->Box);
+
+				A->Height = 1 + std::max(C->Height, D->Height);
+				B->Height = 1 + std::max(A->Height, E->Height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+}
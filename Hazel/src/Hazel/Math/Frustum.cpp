@@ -0,0 +1,44 @@
+#include "Hazel/Math/Frustum.h"
+
+namespace Hazel {
+
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		// Gribb/Hartmann: each plane is row 3 +/- row i of the clip matrix
+		glm::vec4 row0 = { viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+		glm::vec4 row1 = { viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+		glm::vec4 row2 = { viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+		glm::vec4 row3 = { viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+		m_Planes[0] = row3 + row0; // Left
+		m_Planes[1] = row3 - row0; // Right
+		m_Planes[2] = row3 + row1; // Bottom
+		m_Planes[3] = row3 - row1; // Top
+		m_Planes[4] = row3 + row2; // Near
+		m_Planes[5] = row3 - row2; // Far
+
+		for (glm::vec4& plane : m_Planes)
+			plane /= glm::length(glm::vec3(plane));
+	}
+
+	Frustum::Result Frustum::Test(const AABB& aabb) const
+	{
+		glm::vec3 center = aabb.GetCenter();
+		glm::vec3 extents = aabb.GetExtents();
+
+		Result result = Result::Inside;
+		for (const glm::vec4& plane : m_Planes)
+		{
+			glm::vec3 normal = glm::vec3(plane);
+			float distance = glm::dot(normal, center) + plane.w;
+			float radius = glm::dot(extents, glm::abs(normal));
+
+			if (distance < -radius)
+				return Result::Outside;
+			if (distance < radius)
+				result = Result::Intersects;
+		}
+		return result;
+	}
+
+}
@@ -79,4 +79,31 @@ namespace Hazel::Math {
 		return true;
 	}
 
+	glm::vec2 OctahedralEncode(const glm::vec3& normal)
+	{
+		// Zero (or NaN) normals show up in imported meshes, they get +Z rather than NaNs in the vertex buffer
+		float length = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+		if (!(length > 0.0f))
+			return glm::vec2(0.0f);
+
+		glm::vec3 n = normal / length;
+		glm::vec2 encoded(n.x, n.y);
+		if (n.z < 0.0f)
+		{
+			// Lower half folds over the diagonals
+			glm::vec2 sign(encoded.x >= 0.0f ? 1.0f : -1.0f, encoded.y >= 0.0f ? 1.0f : -1.0f);
+			encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * sign;
+		}
+		return encoded;
+	}
+
+	glm::vec3 OctahedralDecode(const glm::vec2& encoded)
+	{
+		glm::vec3 n(encoded.x, encoded.y, 1.0f - glm::abs(encoded.x) - glm::abs(encoded.y));
+		float t = glm::max(-n.z, 0.0f);
+		n.x += n.x >= 0.0f ? -t : t;
+		n.y += n.y >= 0.0f ? -t : t;
+		return glm::normalize(n);
+	}
+
 }
\ No newline at end of file
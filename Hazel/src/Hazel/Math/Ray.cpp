@@ -0,0 +1,86 @@
+#include "Hazel/Math/Ray.h"
+
+namespace Hazel {
+
+	Ray Ray::Transformed(const glm::mat4& transform) const
+	{
+		return { glm::vec3(transform * glm::vec4(Origin, 1.0f)), glm::vec3(transform * glm::vec4(Direction, 0.0f)) };
+	}
+
+	bool Ray::Intersects(const AABB& aabb, float maxT, float& t) const
+	{
+		// Slab test, IEEE infinities take care of axis-parallel directions
+		glm::vec3 inverseDirection = 1.0f / Direction;
+		glm::vec3 t0 = (aabb.Min - Origin) * inverseDirection;
+		glm::vec3 t1 = (aabb.Max - Origin) * inverseDirection;
+		glm::vec3 tNear = glm::min(t0, t1);
+		glm::vec3 tFar = glm::max(t0, t1);
+
+		float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+		float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, maxT));
+		if (enter > exit)
+			return false;
+
+		t = enter;
+		return true;
+	}
+
+	bool Ray::IntersectsSphere(const glm::vec3& center, float radius, float maxT, float& t) const
+	{
+		glm::vec3 offset = Origin - center;
+		float a = glm::dot(Direction, Direction);
+		float b = glm::dot(offset, Direction);
+		float c = glm::dot(offset, offset) - radius * radius;
+		float discriminant = b * b - a * c;
+		if (a == 0.0f || discriminant < 0.0f)
+			return false;
+
+		float root = std::sqrt(discriminant);
+		float hit = (-b - root) / a;
+		if (hit < 0.0f)
+			hit = (-b + root) / a; // Starts inside the sphere
+		if (hit < 0.0f || hit > maxT)
+			return false;
+
+		t = hit;
+		return true;
+	}
+
+	bool Ray::IntersectsTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float maxT, float& t) const
+	{
+		glm::vec3 edge1 = b - a;
+		glm::vec3 edge2 = c - a;
+		glm::vec3 p = glm::cross(Direction, edge2);
+		float determinant = glm::dot(edge1, p);
+		if (glm::abs(determinant) < 1e-12f)
+			return false;
+
+		float inverseDeterminant = 1.0f / determinant;
+		glm::vec3 s = Origin - a;
+		float u = glm::dot(s, p) * inverseDeterminant;
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		glm::vec3 q = glm::cross(s, edge1);
+		float v = glm::dot(Direction, q) * inverseDeterminant;
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		float hit = glm::dot(edge2, q) * inverseDeterminant;
+		if (hit < 0.0f || hit > maxT)
+			return false;
+
+		t = hit;
+		return true;
+	}
+
+	Ray Ray::FromNDC(const glm::vec2& ndc, const glm::mat4& viewProjection)
+	{
+		glm::mat4 inverse = glm::inverse(viewProjection);
+		glm::vec4 nearPoint = inverse * glm::vec4(ndc, -1.0f, 1.0f);
+		glm::vec4 farPoint = inverse * glm::vec4(ndc, 1.0f, 1.0f);
+		glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+		return { origin, glm::vec3(farPoint) / farPoint.w - origin };
+	}
+
+}
@@ -0,0 +1,135 @@
+#include "Hazel/Math/SpatialHashGrid.h"
+
+namespace Hazel {
+
+	SpatialHashGrid::SpatialHashGrid(float cellSize)
+		: m_CellSize(cellSize)
+	{
+		HZ_CORE_ASSERT(cellSize > 0.0f, "Cell size must be positive!");
+	}
+
+	SpatialHashGrid::CellRange SpatialHashGrid::GetCellRange(const glm::vec2& min, const glm::vec2& max) const
+	{
+		// Clamped so far away or infinite bounds can't overflow the cell coordinates
+		constexpr float limit = (float)(1 << 30);
+		glm::vec2 cellMin = glm::clamp(glm::floor(min / m_CellSize), glm::vec2(-limit), glm::vec2(limit));
+		glm::vec2 cellMax = glm::clamp(glm::floor(max / m_CellSize), glm::vec2(-limit), glm::vec2(limit));
+
+		CellRange range;
+		range.Min = glm::ivec2(cellMin);
+		range.Max = glm::ivec2(cellMax);
+		return range;
+	}
+
+	void SpatialHashGrid::InsertIntoCells(int32_t proxyID)
+	{
+		Proxy& proxy = m_Proxies[proxyID];
+		proxy.Oversized = proxy.Cells.GetCellCount() > MaxCellsPerProxy;
+		if (proxy.Oversized)
+		{
+			m_Oversized.push_back(proxyID);
+			return;
+		}
+
+		for (int32_t y = proxy.Cells.Min.y; y <= proxy.Cells.Max.y; y++)
+		{
+			for (int32_t x = proxy.Cells.Min.x; x <= proxy.Cells.Max.x; x++)
+				m_Cells[GetCellKey(x, y)].push_back(proxyID);
+		}
+	}
+
+	void SpatialHashGrid::RemoveFromCells(int32_t proxyID)
+	{
+		auto removeFrom = [proxyID](std::vector<int32_t>& proxies)
+		{
+			auto it = std::find(proxies.begin(), proxies.end(), proxyID);
+			HZ_CORE_ASSERT(it != proxies.end(), "Proxy is missing from its cell!");
+			*it = proxies.back();
+			proxies.pop_back();
+		};
+
+		const Proxy& proxy = m_Proxies[proxyID];
+		if (proxy.Oversized)
+		{
+			removeFrom(m_Oversized);
+			return;
+		}
+
+		for (int32_t y = proxy.Cells.Min.y; y <= proxy.Cells.Max.y; y++)
+		{
+			for (int32_t x = proxy.Cells.Min.x; x <= proxy.Cells.Max.x; x++)
+			{
+				auto it = m_Cells.find(GetCellKey(x, y));
+				HZ_CORE_ASSERT(it != m_Cells.end(), "Proxy cell does not exist!");
+				removeFrom(it->second);
+				// Empty cells are dropped, so the map only ever holds the occupied part of the world
+				if (it->second.empty())
+					m_Cells.erase(it);
+			}
+		}
+	}
+
+	int32_t SpatialHashGrid::CreateProxy(const glm::vec2& min, const glm::vec2& max, uint32_t userData)
+	{
+		int32_t proxyID;
+		if (m_FreeList != NullProxy)
+		{
+			proxyID = m_FreeList;
+			m_FreeList = m_Proxies[proxyID].NextFree;
+		}
+		else
+		{
+			proxyID = (int32_t)m_Proxies.size();
+			m_Proxies.emplace_back();
+		}
+
+		Proxy& proxy = m_Proxies[proxyID];
+		proxy.Min = min;
+		proxy.Max = max;
+		proxy.UserData = userData;
+		proxy.Cells = GetCellRange(min, max);
+		proxy.NextFree = NullProxy;
+		proxy.QueryStamp = 0;
+		InsertIntoCells(proxyID);
+
+		m_ProxyCount++;
+		return proxyID;
+	}
+
+	void SpatialHashGrid::DestroyProxy(int32_t proxyID)
+	{
+		HZ_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Proxies.size(), "Invalid proxy!");
+
+		RemoveFromCells(proxyID);
+		m_Proxies[proxyID].NextFree = m_FreeList;
+		m_FreeList = proxyID;
+		m_ProxyCount--;
+	}
+
+	void SpatialHashGrid::MoveProxy(int32_t proxyID, const glm::vec2& min, const glm::vec2& max)
+	{
+		HZ_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Proxies.size(), "Invalid proxy!");
+
+		Proxy& proxy = m_Proxies[proxyID];
+		proxy.Min = min;
+		proxy.Max = max;
+
+		CellRange cells = GetCellRange(min, max);
+		if (cells == proxy.Cells)
+			return;
+
+		RemoveFromCells(proxyID);
+		proxy.Cells = cells;
+		InsertIntoCells(proxyID);
+	}
+
+	void SpatialHashGrid::Clear()
+	{
+		m_Cells.clear();
+		m_Oversized.clear();
+		m_Proxies.clear();
+		m_FreeList = NullProxy;
+		m_ProxyCount = 0;
+	}
+
+}
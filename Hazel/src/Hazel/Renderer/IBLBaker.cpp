@@ -0,0 +1,525 @@
+#include "Hazel/Renderer/IBLBaker.h"
+
+#include "Hazel/Renderer/Shader.h"
+#include "Hazel/Renderer/FrameBuffer.h"
+#include "Hazel/Renderer/RenderCommand.h"
+#include "Hazel/Renderer/PrimitiveCache.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <stb_image.h>
+
+#include <chrono>
+#include <filesystem>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		enum IBLShader : uint32_t
+		{
+			EquirectangularToCubemapShader = 0,
+			IrradianceConvolutionShader,
+			PrefilterShader,
+			BrdfShader,
+			IBLShaderCount
+		};
+
+		static const char* IBLShaderPaths[IBLShaderCount] = {
+			"../../assets/shaders/IBL_EquirectangularToCubemap.glsl",
+			"../../assets/shaders/IBL_IrradianceConvolution.glsl",
+			"../../assets/shaders/IBL_Prefilter.glsl",
+			"../../assets/shaders/IBL_Brdf.glsl"
+		};
+
+		static constexpr uint32_t EnvironmentSize = 512;
+		static constexpr uint32_t EnvironmentMipLevels = 10; // Full chain down to 1x1
+		static constexpr uint32_t IrradianceSize = 32;
+		static constexpr uint32_t PrefilterSize = 128;
+		static constexpr uint32_t PrefilterMipLevels = 5;
+		static constexpr uint32_t BrdfLUTSize = 512;
+		// An equirectangular map four faces wide has about one texel per environment cubemap texel
+		static constexpr uint32_t HdrMaxWidth = 4 * EnvironmentSize;
+		static constexpr uint32_t HdrUploadBands = 16;
+
+		static FramebufferSpecification GetCaptureSpecification(uint32_t size)
+		{
+			FramebufferSpecification spec;
+			spec.Attachments = { FramebufferTextureFormat::RGB16F, FramebufferTextureFormat::Depth };
+			spec.Width = size;
+			spec.Height = size;
+			return spec;
+		}
+
+		// Projection and views for capturing data onto the 6 cubemap face directions
+		static const glm::mat4& GetCaptureProjection()
+		{
+			static const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
+			return projection;
+		}
+
+		static const glm::mat4& GetCaptureView(uint32_t face)
+		{
+			static const glm::mat4 views[] =
+			{
+				glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
+				glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(-1.0f,  0.0f, 0.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
+				glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  1.0f,  0.0f), glm::vec3(0.0f,  0.0f,  1.0f)),
+				glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f,  0.0f), glm::vec3(0.0f,  0.0f, -1.0f)),
+				glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
+				glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))
+			};
+			return views[face];
+		}
+
+	}
+
+	// Compiled on first use, each in a step of its own, and kept for every later bake
+	struct IBLBakerData
+	{
+		Ref<Shader> Shaders[Utils::IBLShaderCount];
+	};
+
+	static IBLBakerData s_IBLBakerData;
+
+	IBLBaker::IBLBaker(const std::string& hdrPath, const Ref<Texture2D>& brdfLUT)
+		: m_HdrPath(hdrPath)
+	{
+		m_CachePath = "../../assets/cache/" + std::filesystem::path(hdrPath).stem().string() + ".iblcache";
+		m_Result.BrdfLUT = brdfLUT;
+
+		std::vector<std::string> sources = { hdrPath };
+		for (const char* shaderPath : Utils::IBLShaderPaths)
+			sources.push_back(shaderPath);
+		m_CacheKey = std::async(std::launch::async, IBLCache::ComputeKey, sources);
+
+		BuildSteps();
+	}
+
+	IBLBaker::~IBLBaker()
+	{
+		// Workers read members of the baker: the decoded pixels, the cache contents and the mapped readback
+		if (m_IrradianceSH.valid())
+			m_IrradianceSH.wait();
+		if (m_CacheRead.valid())
+			m_CacheRead.wait();
+		if (m_CacheWrite.valid())
+			m_CacheWrite.wait();
+	}
+
+	IBLBaker::HdrImage IBLBaker::DecodeHdr(const std::string& path)
+	{
+		HdrImage image;
+		int width, height, channels;
+		// The flag has to be this thread's own, the main thread sets the global one while loading textures
+		stbi_set_flip_vertically_on_load_thread(1);
+		float* pixels = stbi_loadf(path.c_str(), &width, &height, &channels, 3);
+		if (!pixels)
+			return image;
+
+		// Box filtered by a whole factor, so an 8K source becomes a 2K one
+		uint32_t factor = std::max(std::min((uint32_t)width / Utils::HdrMaxWidth, (uint32_t)height), 1u);
+		image.Width = (uint32_t)width / factor;
+		image.Height = (uint32_t)height / factor;
+		image.Pixels.resize((size_t)image.Width * image.Height * 3);
+		image.Texels.resize(image.Pixels.size());
+
+		float weight = 1.0f / (float)(factor * factor);
+		for (uint32_t y = 0; y < image.Height; y++)
+		{
+			for (uint32_t x = 0; x < image.Width; x++)
+			{
+				glm::vec3 sum(0.0f);
+				for (uint32_t sy = 0; sy < factor; sy++)
+				{
+					const float* row = &pixels[((size_t)(y * factor + sy) * width + x * factor) * 3];
+					for (uint32_t sx = 0; sx < factor; sx++)
+						sum += glm::vec3(row[sx * 3], row[sx * 3 + 1], row[sx * 3 + 2]);
+				}
+
+				size_t index = ((size_t)y * image.Width + x) * 3;
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					image.Pixels[index + c] = sum[c] * weight;
+					image.Texels[index + c] = glm::packHalf1x16(image.Pixels[index + c]);
+				}
+			}
+		}
+
+		stbi_image_free(pixels);
+		return image;
+	}
+
+	bool IBLBaker::Update(const IBLBakeSettings& settings)
+	{
+		auto frameStart = std::chrono::steady_clock::now();
+		for (uint32_t steps = 0; !IsComplete() && steps < settings.MaxStepsPerFrame; steps++)
+		{
+			// Stops early when the last step suggests the next one won't fit
+			float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+			if (steps > 0 && elapsed + m_LastStepTime > settings.FrameBudget)
+				break;
+
+			auto stepStart = std::chrono::steady_clock::now();
+			if (!RunStep())
+				break;
+			m_LastStepTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - stepStart).count();
+		}
+		return IsComplete();
+	}
+
+	void IBLBaker::Finish()
+	{
+		m_Blocking = true;
+		while (!IsComplete())
+			RunStep();
+		m_Blocking = false;
+	}
+
+	void IBLBaker::ReplaceRemainingSteps(std::vector<Step> steps)
+	{
+		m_ReplacementSteps = std::move(steps);
+		m_ReplaceSteps = true;
+	}
+
+	bool IBLBaker::RunStep()
+	{
+		if (!m_Steps[m_NextStep]())
+			return false;
+
+		m_NextStep++;
+		// Applied here, the step that asked for it lives in m_Steps
+		if (m_ReplaceSteps)
+		{
+			m_Steps.erase(m_Steps.begin() + m_NextStep, m_Steps.end());
+			for (Step& step : m_ReplacementSteps)
+				m_Steps.push_back(std::move(step));
+			m_ReplacementSteps.clear();
+			m_ReplaceSteps = false;
+		}
+		return true;
+	}
+
+	template<typename T>
+	bool IBLBaker::IsReady(const std::future<T>& future) const
+	{
+		return m_Blocking || future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	void IBLBaker::RenderFace(const Ref<Shader>& shader, const Ref<TextureCube>& target, uint32_t face, uint32_t mip)
+	{
+		uint32_t size = std::max(target->GetWidth() >> mip, 1u);
+
+		// Every face of a mip shares one pooled framebuffer, each size is only created once per bake
+		m_CaptureGraph.Reset();
+		RenderGraphResource capture = m_CaptureGraph.CreateTarget("IBL Capture", Utils::GetCaptureSpecification(size));
+		m_CaptureGraph.AddPass("IBL Face", {}, capture, [&](const RenderGraph& graph)
+		{
+			shader->SetMat4("projection", Utils::GetCaptureProjection());
+			shader->SetMat4("view", Utils::GetCaptureView(face));
+			RenderCommand::Clear();
+			PrimitiveCache::Draw(PrimitiveCache::Cube);
+			target->SetDataFromFrameBuffer(graph.GetFrameBuffer(capture), face, mip);
+		}, true);
+		m_CaptureGraph.Execute();
+	}
+
+	std::vector<IBLBaker::Step> IBLBaker::BuildLoadSteps()
+	{
+		std::vector<Step> steps;
+		steps.push_back([this]()
+		{
+			const IBLCache::MapLayout* maps = m_CacheContents.Maps;
+			m_Loaded.EnvCubeMap = TextureCube::Create(maps[0].Width, maps[0].Height, maps[0].MipLevels);
+			m_Loaded.IrradianceMap = TextureCube::Create(maps[1].Width, maps[1].Height, maps[1].MipLevels);
+			m_Loaded.PrefilterMap = TextureCube::Create(maps[2].Width, maps[2].Height, maps[2].MipLevels);
+			m_Loaded.BrdfLUT = Texture2D::Create(maps[3].Width, maps[3].Height, (TextureFormat)maps[3].Format);
+			m_Loaded.IrradianceSH = m_CacheContents.IrradianceSH;
+			return true;
+		});
+
+		// One face of one mip level per step
+		size_t offset = 0;
+		for (uint32_t map = 0; map < IBLCache::MapCount; map++)
+		{
+			const IBLCache::MapLayout& layout = m_CacheContents.Maps[map];
+			for (uint32_t level = 0; level < layout.MipLevels; level++)
+			{
+				uint32_t size = layout.GetLevelSize(level);
+				for (uint32_t face = 0; face < layout.FaceCount; face++)
+				{
+					steps.push_back([this, map, face, level, offset, size]()
+					{
+						IBLCache::GetMap(m_Loaded, map)->SetLevelData(m_CacheContents.Texels.data() + offset, size, face, level);
+						return true;
+					});
+					offset += size;
+				}
+			}
+		}
+
+		// Nothing is handed out until everything is uploaded
+		steps.push_back([this]()
+		{
+			HZ_CORE_INFO("Loaded IBL maps from '{0}'", m_CachePath);
+			m_Result = m_Loaded;
+			m_Loaded = IBLData();
+			m_CacheContents = IBLCache::Contents();
+			return true;
+		});
+		return steps;
+	}
+
+	void IBLBaker::BuildSteps()
+	{
+		// Cache lookup, the file is read on a worker and the HDR is only decoded when the baked maps are missing or stale
+		m_Steps.push_back([this]()
+		{
+			if (!IsReady(m_CacheKey))
+				return false;
+
+			m_Key = m_CacheKey.get();
+			if (m_Key)
+			{
+				m_CacheRead = std::async(std::launch::async, [this]()
+				{
+					return IBLCache::Read(m_CachePath, m_Key, m_CacheContents);
+				});
+			}
+			return true;
+		});
+
+		m_Steps.push_back([this]()
+		{
+			if (m_CacheRead.valid())
+			{
+				if (!IsReady(m_CacheRead))
+					return false;
+
+				if (m_CacheRead.get())
+				{
+					ReplaceRemainingSteps(BuildLoadSteps());
+					return true;
+				}
+				m_CacheContents = IBLCache::Contents();
+			}
+
+			m_Decode = std::async(std::launch::async, DecodeHdr, m_HdrPath);
+			return true;
+		});
+
+		// The downsampled texels feed both the GPU texture and the SH projection, which runs while the faces render
+		m_Steps.push_back([this]()
+		{
+			if (!IsReady(m_Decode))
+				return false;
+
+			m_Image = m_Decode.get();
+			if (m_Image.Pixels.empty())
+			{
+				HZ_CORE_ERROR("Failed to load HDR environment '{0}'", m_HdrPath);
+				m_Result = IBLData();
+				ReplaceRemainingSteps({});
+				return true;
+			}
+
+			const float* pixels = m_Image.Pixels.data();
+			uint32_t width = m_Image.Width, height = m_Image.Height;
+			m_IrradianceSH = std::async(std::launch::async, [pixels, width, height]()
+			{
+				return SphericalHarmonics::ProjectEquirectangular(pixels, width, height, 3).ConvolveIrradiance();
+			});
+
+			m_HdrTexture = Texture2D::Create(m_Image.Width, m_Image.Height, TextureFormat::RGB16F);
+			return true;
+		});
+
+		// The upload is split into bands of rows
+		for (uint32_t band = 0; band < Utils::HdrUploadBands; band++)
+		{
+			m_Steps.push_back([this, band]()
+			{
+				uint32_t firstRow = m_Image.Height * band / Utils::HdrUploadBands;
+				uint32_t rowCount = m_Image.Height * (band + 1) / Utils::HdrUploadBands - firstRow;
+				if (rowCount > 0)
+				{
+					size_t rowSize = (size_t)m_Image.Width * 3;
+					m_HdrTexture->SetLevelRows(m_Image.Texels.data() + firstRow * rowSize,
+						(uint32_t)(rowCount * rowSize * sizeof(uint16_t)), firstRow, rowCount);
+				}
+
+				if (band == Utils::HdrUploadBands - 1)
+					m_Image.Texels = std::vector<uint16_t>();
+				return true;
+			});
+		}
+
+		for (uint32_t shader = 0; shader < Utils::IBLShaderCount; shader++)
+		{
+			m_Steps.push_back([this, shader]()
+			{
+				if (shader == Utils::BrdfShader && m_Result.BrdfLUT)
+					return true;
+
+				if (!s_IBLBakerData.Shaders[shader])
+					s_IBLBakerData.Shaders[shader] = Shader::Create(Utils::IBLShaderPaths[shader]);
+				return true;
+			});
+		}
+
+		m_Steps.push_back([this]()
+		{
+			m_Result.EnvCubeMap = TextureCube::Create(Utils::EnvironmentSize, Utils::EnvironmentSize, Utils::EnvironmentMipLevels);
+			m_Result.IrradianceMap = TextureCube::Create(Utils::IrradianceSize, Utils::IrradianceSize);
+			m_Result.PrefilterMap = TextureCube::Create(Utils::PrefilterSize, Utils::PrefilterSize, Utils::PrefilterMipLevels);
+			return true;
+		});
+
+		// Convert the HDR equirectangular environment map to its cubemap equivalent
+		for (uint32_t face = 0; face < 6; face++)
+		{
+			m_Steps.push_back([this, face]()
+			{
+				const Ref<Shader>& shader = s_IBLBakerData.Shaders[Utils::EquirectangularToCubemapShader];
+				shader->Bind();
+				shader->SetInt("equirectangularMap", 1);
+				m_HdrTexture->Bind(1);
+				RenderFace(shader, m_Result.EnvCubeMap, face, 0);
+				return true;
+			});
+		}
+
+		// Then let OpenGL generate mipmaps from the first mip face (combatting visible dots artifact)
+		m_Steps.push_back([this]()
+		{
+			m_Result.EnvCubeMap->GenerateMipmaps();
+			m_HdrTexture = nullptr;
+			return true;
+		});
+
+		for (uint32_t face = 0; face < 6; face++)
+		{
+			m_Steps.push_back([this, face]()
+			{
+				const Ref<Shader>& shader = s_IBLBakerData.Shaders[Utils::IrradianceConvolutionShader];
+				shader->Bind();
+				shader->SetInt("environmentMap", 1);
+				m_Result.EnvCubeMap->Bind(1);
+				RenderFace(shader, m_Result.IrradianceMap, face, 0);
+				return true;
+			});
+		}
+
+		for (uint32_t mip = 0; mip < Utils::PrefilterMipLevels; mip++)
+		{
+			for (uint32_t face = 0; face < 6; face++)
+			{
+				m_Steps.push_back([this, face, mip]()
+				{
+					const Ref<Shader>& shader = s_IBLBakerData.Shaders[Utils::PrefilterShader];
+					shader->Bind();
+					shader->SetInt("environmentMap", 1);
+					shader->SetFloat("roughness", (float)mip / (float)(Utils::PrefilterMipLevels - 1));
+					m_Result.EnvCubeMap->Bind(1);
+					RenderFace(shader, m_Result.PrefilterMap, face, mip);
+					return true;
+				});
+			}
+		}
+
+		// 2D LUT from the BRDF equations used
+		m_Steps.push_back([this]()
+		{
+			if (m_Result.BrdfLUT)
+				return true;
+
+			s_IBLBakerData.Shaders[Utils::BrdfShader]->Bind();
+			m_CaptureGraph.Reset();
+			RenderGraphResource capture = m_CaptureGraph.CreateTarget("BRDF LUT", Utils::GetCaptureSpecification(Utils::BrdfLUTSize));
+			m_CaptureGraph.AddPass("BRDF LUT", {}, capture, [&](const RenderGraph& graph)
+			{
+				RenderCommand::Clear();
+				PrimitiveCache::Draw(PrimitiveCache::FullscreenTriangle);
+				m_Result.BrdfLUT = Texture2D::Create(graph.GetFrameBuffer(capture));
+			}, true);
+			m_CaptureGraph.Execute();
+			return true;
+		});
+
+		m_Steps.push_back([this]()
+		{
+			if (!IsReady(m_IrradianceSH))
+				return false;
+
+			m_Result.IrradianceSH = m_IrradianceSH.get();
+			m_Image = HdrImage();
+
+			m_CaptureGraph.Reset();
+			m_CaptureGraph.ReleaseFrameBuffers();
+			return true;
+		});
+
+		// Every face and level is copied into a pixel pack buffer, which a worker writes out once the copies have arrived
+		m_Steps.push_back([this]()
+		{
+			if (!m_Key)
+				return true;
+
+			size_t size = 0;
+			for (uint32_t map = 0; map < IBLCache::MapCount; map++)
+			{
+				m_CacheMaps[map] = IBLCache::GetMapLayout(m_Result, map);
+				size += m_CacheMaps[map].GetSize();
+			}
+
+			m_Readback = TextureReadback::Create((uint32_t)size);
+			uint32_t offset = 0;
+			for (uint32_t map = 0; map < IBLCache::MapCount; map++)
+			{
+				Ref<Texture> texture = IBLCache::GetMap(m_Result, map);
+				const IBLCache::MapLayout& layout = m_CacheMaps[map];
+				for (uint32_t level = 0; level < layout.MipLevels; level++)
+				{
+					for (uint32_t face = 0; face < layout.FaceCount; face++)
+					{
+						m_Readback->Queue(texture, face, level, offset);
+						offset += layout.GetLevelSize(level);
+					}
+				}
+			}
+			m_Readback->Submit();
+			return true;
+		});
+
+		m_Steps.push_back([this]()
+		{
+			if (!m_Readback)
+				return true;
+			if (!m_Readback->IsComplete(m_Blocking))
+				return false;
+
+			const void* texels = m_Readback->GetData();
+			SphericalHarmonics irradianceSH = m_Result.IrradianceSH;
+			m_CacheWrite = std::async(std::launch::async, [this, texels, irradianceSH]()
+			{
+				return IBLCache::Write(m_CachePath, m_Key, irradianceSH, m_CacheMaps, texels);
+			});
+			return true;
+		});
+
+		// The readback buffer stays mapped until the file is written
+		m_Steps.push_back([this]()
+		{
+			if (!m_CacheWrite.valid())
+				return true;
+			if (!IsReady(m_CacheWrite))
+				return false;
+
+			if (m_CacheWrite.get())
+				HZ_CORE_INFO("Saved IBL maps to '{0}'", m_CachePath);
+			m_Readback = nullptr;
+			return true;
+		});
+	}
+
+}
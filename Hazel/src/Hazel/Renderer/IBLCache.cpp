@@ -0,0 +1,196 @@
+#include "Hazel/Renderer/IBLCache.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		static constexpr uint32_t IBLCacheMagic = 0x4C424948; // "HIBL"
+		static constexpr uint32_t IBLCacheVersion = 2;
+
+		// Followed by the irradiance SH coefficients, then the textures
+		struct IBLCacheHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t Key;
+			uint32_t TextureCount;
+			uint32_t SHCoefficientCount;
+		};
+
+		static bool IsValidLayout(const IBLCache::MapLayout& layout, uint32_t faceCount)
+		{
+			// The size limit keeps a damaged file from asking for gigabytes of texels
+			return layout.FaceCount == faceCount && layout.Width > 0 && layout.Height > 0 && layout.Width <= 16384 && layout.Height <= 16384
+				&& layout.MipLevels > 0 && (std::max(layout.Width, layout.Height) >> (layout.MipLevels - 1)) > 0
+				&& GetTextureFormatTexelSize((TextureFormat)layout.Format) > 0;
+		}
+
+	}
+
+	uint32_t IBLCache::MapLayout::GetLevelSize(uint32_t level) const
+	{
+		uint32_t width = std::max(Width >> level, 1u);
+		uint32_t height = std::max(Height >> level, 1u);
+		return width * height * GetTextureFormatTexelSize((TextureFormat)Format);
+	}
+
+	size_t IBLCache::MapLayout::GetSize() const
+	{
+		size_t size = 0;
+		for (uint32_t level = 0; level < MipLevels; level++)
+			size += (size_t)GetLevelSize(level) * FaceCount;
+		return size;
+	}
+
+	uint64_t IBLCache::ComputeKey(const std::vector<std::string>& sourcePaths)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		auto hashBytes = [&hash](const uint8_t* bytes, size_t size)
+		{
+			for (size_t i = 0; i < size; i++)
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+		};
+
+		std::vector<uint8_t> buffer(1 << 20);
+		for (const std::string& path : sourcePaths)
+		{
+			std::ifstream stream(path, std::ios::binary);
+			if (!stream)
+			{
+				HZ_CORE_WARN("IBL cache source '{0}' could not be read", path);
+				return 0;
+			}
+
+			uint64_t fileSize = 0;
+			while (stream)
+			{
+				stream.read((char*)buffer.data(), buffer.size());
+				size_t count = (size_t)stream.gcount();
+				hashBytes(buffer.data(), count);
+				fileSize += count;
+			}
+
+			// Keeps "ab" + "c" and "a" + "bc" apart
+			hashBytes((const uint8_t*)&fileSize, sizeof(fileSize));
+		}
+		return hash;
+	}
+
+	Ref<Texture> IBLCache::GetMap(const IBLData& data, uint32_t map)
+	{
+		switch (map)
+		{
+			case 0: return data.EnvCubeMap;
+			case 1: return data.IrradianceMap;
+			case 2: return data.PrefilterMap;
+			case 3: return data.BrdfLUT;
+		}
+		return nullptr;
+	}
+
+	IBLCache::MapLayout IBLCache::GetMapLayout(const IBLData& data, uint32_t map)
+	{
+		Ref<Texture> texture = GetMap(data, map);
+		MapLayout layout;
+		layout.FaceCount = map == 3 ? 1 : 6;
+		layout.Width = texture->GetWidth();
+		layout.Height = texture->GetHeight();
+		layout.MipLevels = texture->GetMipLevelCount();
+		layout.Format = (uint32_t)texture->GetFormat();
+		return layout;
+	}
+
+	bool IBLCache::Read(const std::string& path, uint64_t key, Contents& contents)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+
+		Utils::IBLCacheHeader header;
+		if (!stream.read((char*)&header, sizeof(header)) || header.Magic != Utils::IBLCacheMagic)
+		{
+			HZ_CORE_WARN("'{0}' is not an IBL cache", path);
+			return false;
+		}
+		if (header.Version != Utils::IBLCacheVersion || header.Key != key || header.TextureCount != MapCount
+			|| header.SHCoefficientCount != SphericalHarmonics::CoefficientCount)
+		{
+			HZ_CORE_INFO("IBL cache '{0}' is out of date", path);
+			return false;
+		}
+
+		if (!stream.read((char*)contents.IrradianceSH.Coefficients, sizeof(contents.IrradianceSH.Coefficients)))
+			return false;
+
+		contents.Texels.clear();
+		for (uint32_t map = 0; map < MapCount; map++)
+		{
+			MapLayout& layout = contents.Maps[map];
+			if (!stream.read((char*)&layout, sizeof(layout)) || !Utils::IsValidLayout(layout, map == 3 ? 1 : 6))
+				return false;
+			if (map < 3 ? (TextureFormat)layout.Format != TextureFormat::RGB16F : layout.MipLevels != 1)
+				return false;
+
+			size_t offset = contents.Texels.size();
+			contents.Texels.resize(offset + layout.GetSize());
+			if (!stream.read((char*)contents.Texels.data() + offset, layout.GetSize()))
+				return false;
+		}
+		return true;
+	}
+
+	bool IBLCache::Write(const std::string& path, uint64_t key, const SphericalHarmonics& irradianceSH,
+		const MapLayout (&maps)[MapCount], const void* texels)
+	{
+		std::filesystem::path filePath(path);
+		std::error_code error;
+		if (filePath.has_parent_path())
+			std::filesystem::create_directories(filePath.parent_path(), error);
+
+		// Written next to the real file and renamed at the end, so an interrupted save never leaves a truncated cache behind
+		std::filesystem::path tempPath = filePath;
+		tempPath += ".tmp";
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+			{
+				HZ_CORE_WARN("Could not write IBL cache '{0}'", path);
+				return false;
+			}
+
+			Utils::IBLCacheHeader header = { Utils::IBLCacheMagic, Utils::IBLCacheVersion, key, MapCount, SphericalHarmonics::CoefficientCount };
+			stream.write((const char*)&header, sizeof(header));
+			stream.write((const char*)irradianceSH.Coefficients, sizeof(irradianceSH.Coefficients));
+
+			// Each map's layout record is followed by its texels
+			const char* mapTexels = (const char*)texels;
+			for (const MapLayout& layout : maps)
+			{
+				stream.write((const char*)&layout, sizeof(layout));
+				stream.write(mapTexels, layout.GetSize());
+				mapTexels += layout.GetSize();
+			}
+
+			if (!stream)
+			{
+				HZ_CORE_WARN("Could not write IBL cache '{0}'", path);
+				stream.close();
+				std::filesystem::remove(tempPath, error);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tempPath, filePath, error);
+		if (error)
+		{
+			HZ_CORE_WARN("Could not write IBL cache '{0}': {1}", path, error.message());
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+		return true;
+	}
+
+}
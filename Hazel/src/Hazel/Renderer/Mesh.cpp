@@ -0,0 +1,59 @@
+#include "Hazel/Renderer/Mesh.h"
+
+#include "Hazel/Renderer/MeshImporter.h"
+#include "Hazel/Math/Math.h"
+
+#include <glm/gtc/packing.hpp>
+
+namespace Hazel {
+
+	Mesh::Mesh(std::vector<MeshVertex> vertices, std::vector<uint32_t> indices, const std::string& path)
+		: m_Vertices(std::move(vertices)), m_Indices(std::move(indices)), m_Path(path)
+	{
+		HZ_CORE_ASSERT(!m_Vertices.empty() && m_Indices.size() % 3 == 0, "Invalid mesh data!");
+
+		m_Bounds = AABB(m_Vertices[0].Position, m_Vertices[0].Position);
+		for (const MeshVertex& vertex : m_Vertices)
+		{
+			m_Bounds.Min = glm::min(m_Bounds.Min, vertex.Position);
+			m_Bounds.Max = glm::max(m_Bounds.Max, vertex.Position);
+		}
+
+		m_VertexBuffer = CreateVertexBuffer(m_Vertices);
+
+		if (m_Vertices.size() <= std::numeric_limits<uint16_t>::max() + 1)
+		{
+			std::vector<uint16_t> shortIndices(m_Indices.begin(), m_Indices.end());
+			m_IndexBuffer = IndexBuffer::Create(shortIndices.data(), (uint32_t)shortIndices.size());
+		}
+		else
+		{
+			m_IndexBuffer = IndexBuffer::Create(m_Indices.data(), (uint32_t)m_Indices.size());
+		}
+	}
+
+	Ref<Mesh> Mesh::Create(const std::string& path)
+	{
+		return MeshImporter::Import(path);
+	}
+
+	Ref<VertexBuffer> Mesh::CreateVertexBuffer(const std::vector<MeshVertex>& vertices)
+	{
+		std::vector<PackedMeshVertex> packed(vertices.size());
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			packed[i].Position = vertices[i].Position;
+			packed[i].Normal = glm::packSnorm2x16(Math::OctahedralEncode(vertices[i].Normal));
+			packed[i].TexCoord = glm::packHalf2x16(vertices[i].TexCoord);
+		}
+
+		Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(packed.data(), (uint32_t)(packed.size() * sizeof(PackedMeshVertex)));
+		vertexBuffer->SetLayout({
+			{ ShaderDataType::Float3,     "a_Position"	},
+			{ ShaderDataType::Short2Norm, "a_Normal"	},
+			{ ShaderDataType::Half2,      "a_TexCoord"	},
+		});
+		return vertexBuffer;
+	}
+
+}
@@ -0,0 +1,725 @@
+#include "Hazel/Renderer/MeshImporter.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		struct VertexHash
+		{
+			size_t operator()(const MeshVertex& vertex) const
+			{
+				// FNV-1a over the raw bytes, MeshVertex has no padding
+				const uint8_t* bytes = (const uint8_t*)&vertex;
+				uint64_t hash = 14695981039346656037ull;
+				for (size_t i = 0; i < sizeof(MeshVertex); i++)
+					hash = (hash ^ bytes[i]) * 1099511628211ull;
+				return (size_t)hash;
+			}
+		};
+
+		struct VertexEqual
+		{
+			bool operator()(const MeshVertex& a, const MeshVertex& b) const
+			{
+				return memcmp(&a, &b, sizeof(MeshVertex)) == 0;
+			}
+		};
+
+		// Tuning constants from Forsyth's reference implementation
+		static constexpr uint32_t VertexCacheSize = 32;
+		static constexpr float CacheDecayPower = 1.5f;
+		static constexpr float LastTriangleScore = 0.75f;
+		static constexpr float ValenceBoostScale = 2.0f;
+		static constexpr float ValenceBoostPower = 0.5f;
+
+		static float VertexCacheScore(int32_t cachePosition, uint32_t liveTriangles)
+		{
+			if (liveTriangles == 0)
+				return -1.0f;
+
+			float score = 0.0f;
+			if (cachePosition >= 0)
+			{
+				// The last triangle's vertices get a fixed score so the next triangle does not just reuse one edge
+				if (cachePosition < 3)
+					score = LastTriangleScore;
+				else
+					score = std::pow(1.0f - (float)(cachePosition - 3) / (float)(VertexCacheSize - 3), CacheDecayPower);
+			}
+
+			// Finish off vertices with few triangles left, so they can leave the cache for good
+			score += ValenceBoostScale * std::pow((float)liveTriangles, -ValenceBoostPower);
+			return score;
+		}
+
+		static void ParseFloats(const char* str, float* out, uint32_t count)
+		{
+			char* end;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				out[i] = std::strtof(str, &end);
+				str = end;
+			}
+		}
+
+		// OBJ indices are 1-based, negative ones count back from the end of the list so far
+		static bool ResolveObjIndex(long index, size_t size, size_t& result)
+		{
+			if (index > 0 && (size_t)index <= size)
+				result = (size_t)index - 1;
+			else if (index < 0 && (size_t)(-index) <= size)
+				result = size + index;
+			else
+				return false;
+			return true;
+		}
+
+		// glTF binary container
+		static constexpr uint32_t GlbMagic = 0x46546C67;		// "glTF"
+		static constexpr uint32_t GlbChunkJson = 0x4E4F534A;	// "JSON"
+		static constexpr uint32_t GlbChunkBin = 0x004E4942;		// "BIN\0"
+
+		static constexpr uint32_t GltfTriangles = 4;
+
+		struct GltfAccessor
+		{
+			const uint8_t* Data = nullptr;
+			uint32_t Count = 0;
+			uint32_t Stride = 0;
+			uint32_t ComponentType = 0;
+			uint32_t Components = 0;
+			bool Normalized = false;
+		};
+
+		static uint32_t GltfComponentSize(uint32_t componentType)
+		{
+			switch (componentType)
+			{
+				case 5120: // BYTE
+				case 5121: // UNSIGNED_BYTE
+					return 1;
+				case 5122: // SHORT
+				case 5123: // UNSIGNED_SHORT
+					return 2;
+				case 5125: // UNSIGNED_INT
+				case 5126: // FLOAT
+					return 4;
+			}
+			return 0;
+		}
+
+		static uint32_t GltfComponentCount(const std::string& type)
+		{
+			if (type == "SCALAR")	return 1;
+			if (type == "VEC2")		return 2;
+			if (type == "VEC3")		return 3;
+			if (type == "VEC4")		return 4;
+			if (type == "MAT4")		return 16;
+			return 0;
+		}
+
+		// Only accessors into the GLB's own binary chunk are supported
+		static bool GetGltfAccessor(const YAML::Node& gltf, const std::vector<uint8_t>& bin, uint32_t index, GltfAccessor& result)
+		{
+			YAML::Node accessor = gltf["accessors"][index];
+			if (!accessor || !accessor["bufferView"])
+				return false;
+
+			result.Count = accessor["count"].as<uint32_t>();
+			result.ComponentType = accessor["componentType"].as<uint32_t>();
+			result.Components = GltfComponentCount(accessor["type"].as<std::string>());
+			result.Normalized = accessor["normalized"].as<bool>(false);
+
+			YAML::Node view = gltf["bufferViews"][accessor["bufferView"].as<uint32_t>()];
+			if (!view || view["buffer"].as<uint32_t>(0) != 0)
+				return false;
+
+			uint32_t elementSize = GltfComponentSize(result.ComponentType) * result.Components;
+			if (elementSize == 0)
+				return false;
+
+			size_t offset = view["byteOffset"].as<size_t>(0) + accessor["byteOffset"].as<size_t>(0);
+			result.Stride = view["byteStride"].as<uint32_t>(0);
+			if (result.Stride == 0)
+				result.Stride = elementSize;
+
+			if (result.Count && offset + (size_t)result.Stride * (result.Count - 1) + elementSize > bin.size())
+				return false;
+
+			result.Data = bin.data() + offset;
+			return true;
+		}
+
+		static void ReadGltfFloats(const GltfAccessor& accessor, uint32_t element, float* out, uint32_t count)
+		{
+			const uint8_t* data = accessor.Data + (size_t)element * accessor.Stride;
+			uint32_t componentSize = GltfComponentSize(accessor.ComponentType);
+			for (uint32_t i = 0; i < std::min(count, accessor.Components); i++)
+			{
+				const uint8_t* component = data + i * componentSize;
+				switch (accessor.ComponentType)
+				{
+					case 5126: memcpy(&out[i], component, sizeof(float)); break;
+					case 5120: { int8_t v; memcpy(&v, component, 1); out[i] = accessor.Normalized ? std::max(v / 127.0f, -1.0f) : (float)v; break; }
+					case 5121: { uint8_t v = *component; out[i] = accessor.Normalized ? v / 255.0f : (float)v; break; }
+					case 5122: { int16_t v; memcpy(&v, component, 2); out[i] = accessor.Normalized ? std::max(v / 32767.0f, -1.0f) : (float)v; break; }
+					case 5123: { uint16_t v; memcpy(&v, component, 2); out[i] = accessor.Normalized ? v / 65535.0f : (float)v; break; }
+					case 5125: { uint32_t v; memcpy(&v, component, 4); out[i] = (float)v; break; }
+				}
+			}
+		}
+
+		static uint32_t ReadGltfIndex(const GltfAccessor& accessor, uint32_t element)
+		{
+			const uint8_t* data = accessor.Data + (size_t)element * accessor.Stride;
+			switch (accessor.ComponentType)
+			{
+				case 5121: return *data;
+				case 5123: { uint16_t v; memcpy(&v, data, 2); return v; }
+				case 5125: { uint32_t v; memcpy(&v, data, 4); return v; }
+			}
+			return std::numeric_limits<uint32_t>::max();
+		}
+
+		static glm::mat4 GetGltfNodeTransform(const YAML::Node& node)
+		{
+			if (YAML::Node matrix = node["matrix"])
+			{
+				// Column-major, same as glm
+				glm::mat4 result;
+				for (uint32_t i = 0; i < 16; i++)
+					result[i / 4][i % 4] = matrix[i].as<float>();
+				return result;
+			}
+
+			glm::vec3 translation(0.0f), scale(1.0f);
+			glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+			if (YAML::Node t = node["translation"])
+				translation = { t[0].as<float>(), t[1].as<float>(), t[2].as<float>() };
+			if (YAML::Node r = node["rotation"])
+				rotation = glm::quat(r[3].as<float>(), r[0].as<float>(), r[1].as<float>(), r[2].as<float>());
+			if (YAML::Node s = node["scale"])
+				scale = { s[0].as<float>(), s[1].as<float>(), s[2].as<float>() };
+
+			return glm::translate(glm::mat4(1.0f), translation)
+				* glm::mat4_cast(rotation)
+				* glm::scale(glm::mat4(1.0f), scale);
+		}
+
+		static bool AppendGltfPrimitive(const YAML::Node& gltf, const std::vector<uint8_t>& bin, const YAML::Node& primitive, const glm::mat4& transform,
+			std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices, bool& hasNormals)
+		{
+			if (primitive["mode"].as<uint32_t>(GltfTriangles) != GltfTriangles)
+			{
+				HZ_CORE_WARN("Skipping non-triangle glTF primitive");
+				return true;
+			}
+
+			YAML::Node attributes = primitive["attributes"];
+			GltfAccessor positions, normals, texCoords;
+			if (!attributes["POSITION"] || !GetGltfAccessor(gltf, bin, attributes["POSITION"].as<uint32_t>(), positions))
+				return false;
+			bool hasNormalAttribute = attributes["NORMAL"] && GetGltfAccessor(gltf, bin, attributes["NORMAL"].as<uint32_t>(), normals);
+			bool hasTexCoords = attributes["TEXCOORD_0"] && GetGltfAccessor(gltf, bin, attributes["TEXCOORD_0"].as<uint32_t>(), texCoords);
+			hasNormals &= hasNormalAttribute;
+
+			glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+			uint32_t baseVertex = (uint32_t)vertices.size();
+			for (uint32_t i = 0; i < positions.Count; i++)
+			{
+				MeshVertex& vertex = vertices.emplace_back();
+
+				float position[3] = {};
+				ReadGltfFloats(positions, i, position, 3);
+				vertex.Position = glm::vec3(transform * glm::vec4(position[0], position[1], position[2], 1.0f));
+
+				// A missing or zero normal can't be normalized, the mesh gets generated normals instead
+				float normal[3] = {};
+				if (hasNormalAttribute && i < normals.Count)
+					ReadGltfFloats(normals, i, normal, 3);
+				vertex.Normal = normalMatrix * glm::vec3(normal[0], normal[1], normal[2]);
+				float normalLength = glm::length(vertex.Normal);
+				if (normalLength > 0.0f)
+					vertex.Normal /= normalLength;
+				else
+					hasNormals = false;
+
+				// glTF puts the texture origin at the top left, our images are flipped on load
+				float texCoord[2] = {};
+				if (hasTexCoords && i < texCoords.Count)
+					ReadGltfFloats(texCoords, i, texCoord, 2);
+				vertex.TexCoord = glm::vec2(texCoord[0], 1.0f - texCoord[1]);
+			}
+
+			// A mirroring transform flips the winding
+			bool flipWinding = glm::determinant(glm::mat3(transform)) < 0.0f;
+			auto appendTriangle = [&](uint32_t i0, uint32_t i1, uint32_t i2)
+			{
+				indices.push_back(baseVertex + i0);
+				indices.push_back(baseVertex + (flipWinding ? i2 : i1));
+				indices.push_back(baseVertex + (flipWinding ? i1 : i2));
+			};
+
+			if (primitive["indices"])
+			{
+				GltfAccessor indexAccessor;
+				if (!GetGltfAccessor(gltf, bin, primitive["indices"].as<uint32_t>(), indexAccessor))
+					return false;
+
+				for (uint32_t i = 0; i + 2 < indexAccessor.Count; i += 3)
+				{
+					uint32_t i0 = ReadGltfIndex(indexAccessor, i);
+					uint32_t i1 = ReadGltfIndex(indexAccessor, i + 1);
+					uint32_t i2 = ReadGltfIndex(indexAccessor, i + 2);
+					if (i0 >= positions.Count || i1 >= positions.Count || i2 >= positions.Count)
+						return false;
+					appendTriangle(i0, i1, i2);
+				}
+			}
+			else
+			{
+				for (uint32_t i = 0; i + 2 < positions.Count; i += 3)
+					appendTriangle(i, i + 1, i + 2);
+			}
+			return true;
+		}
+
+		static bool AppendGltfNode(const YAML::Node& gltf, const std::vector<uint8_t>& bin, uint32_t nodeIndex, const glm::mat4& parentTransform,
+			std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices, bool& hasNormals, uint32_t depth = 0)
+		{
+			// glTF forbids cycles, the depth limit only guards against malformed files
+			YAML::Node node = gltf["nodes"][nodeIndex];
+			if (!node || depth > 64)
+				return false;
+
+			glm::mat4 transform = parentTransform * GetGltfNodeTransform(node);
+			if (node["mesh"])
+			{
+				YAML::Node mesh = gltf["meshes"][node["mesh"].as<uint32_t>()];
+				for (const YAML::Node& primitive : mesh["primitives"])
+				{
+					if (!AppendGltfPrimitive(gltf, bin, primitive, transform, vertices, indices, hasNormals))
+						return false;
+				}
+			}
+
+			for (const YAML::Node& child : node["children"])
+			{
+				if (!AppendGltfNode(gltf, bin, child.as<uint32_t>(), transform, vertices, indices, hasNormals, depth + 1))
+					return false;
+			}
+			return true;
+		}
+
+	}
+
+	Ref<Mesh> MeshImporter::Import(const std::string& path)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		std::string extension = std::filesystem::path(path).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower(c); });
+
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		bool hasNormals = true;
+		bool loaded = false;
+		if (extension == ".obj")
+			loaded = LoadOBJ(path, vertices, indices, hasNormals);
+		else if (extension == ".glb")
+			loaded = LoadGLB(path, vertices, indices, hasNormals);
+		else
+			HZ_CORE_ERROR("Unsupported mesh format '{0}'", extension);
+
+		if (!loaded || indices.empty())
+		{
+			HZ_CORE_ERROR("Failed to import mesh '{0}'", path);
+			return nullptr;
+		}
+
+		uint32_t sourceVertexCount = (uint32_t)vertices.size();
+		Deduplicate(vertices, indices);
+		if (!hasNormals)
+			GenerateNormals(vertices, indices);
+		OptimizeVertexCache(indices, (uint32_t)vertices.size());
+		OptimizeVertexFetch(vertices, indices);
+
+		auto end = std::chrono::high_resolution_clock::now();
+		HZ_CORE_INFO("Imported mesh '{0}': {1} -> {2} vertices, {3} triangles in {4} ms", path, sourceVertexCount, vertices.size(),
+			indices.size() / 3, std::chrono::duration<float, std::milli>(end - start).count());
+
+		return CreateRef<Mesh>(std::move(vertices), std::move(indices), path);
+	}
+
+	void MeshImporter::Deduplicate(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		std::unordered_map<MeshVertex, uint32_t, Utils::VertexHash, Utils::VertexEqual> unique;
+		unique.reserve(vertices.size());
+
+		std::vector<MeshVertex> result;
+		std::vector<uint32_t> remap(vertices.size());
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			auto [it, inserted] = unique.try_emplace(vertices[i], (uint32_t)result.size());
+			if (inserted)
+				result.push_back(vertices[i]);
+			remap[i] = it->second;
+		}
+
+		for (uint32_t& index : indices)
+			index = remap[index];
+		vertices.swap(result);
+	}
+
+	void MeshImporter::OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount)
+	{
+		using namespace Utils;
+
+		const uint32_t invalid = std::numeric_limits<uint32_t>::max();
+		uint32_t triangleCount = (uint32_t)indices.size() / 3;
+		if (triangleCount == 0)
+			return;
+
+		// Triangles using each vertex, packed per vertex. The first liveTriangles[v] entries are the ones not emitted yet.
+		std::vector<uint32_t> liveTriangles(vertexCount, 0);
+		for (uint32_t index : indices)
+			liveTriangles[index]++;
+
+		std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+		for (uint32_t v = 0; v < vertexCount; v++)
+			adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+
+		std::vector<uint32_t> adjacency(indices.size());
+		{
+			std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (uint32_t t = 0; t < triangleCount; t++)
+			{
+				for (uint32_t k = 0; k < 3; k++)
+					adjacency[fill[indices[t * 3 + k]]++] = t;
+			}
+		}
+
+		std::vector<float> vertexScores(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; v++)
+			vertexScores[v] = VertexCacheScore(-1, liveTriangles[v]);
+
+		std::vector<float> triangleScores(triangleCount);
+		for (uint32_t t = 0; t < triangleCount; t++)
+			triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+
+		uint32_t bestTriangle = (uint32_t)(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+
+		uint32_t cache[VertexCacheSize + 3];
+		uint32_t cacheSize = 0;
+		uint32_t scanCursor = 0;
+		for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+		{
+			if (bestTriangle == invalid)
+			{
+				// Nothing in the cache touches a live triangle, continue with the next unemitted one
+				while (emitted[scanCursor])
+					scanCursor++;
+				bestTriangle = scanCursor;
+			}
+
+			const uint32_t* triangle = &indices[bestTriangle * 3];
+			result.insert(result.end(), triangle, triangle + 3);
+			emitted[bestTriangle] = true;
+
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				uint32_t v = triangle[k];
+				uint32_t* begin = &adjacency[adjacencyOffsets[v]];
+				uint32_t* end = begin + liveTriangles[v];
+				std::swap(*std::find(begin, end, bestTriangle), *(end - 1));
+				liveTriangles[v]--;
+			}
+
+			// The triangle's vertices move to the front, everything else shifts back and may fall out
+			uint32_t newCache[VertexCacheSize + 3];
+			uint32_t newCacheSize = 0;
+			for (uint32_t k = 0; k < 3; k++)
+				newCache[newCacheSize++] = triangle[k];
+			for (uint32_t i = 0; i < cacheSize; i++)
+			{
+				uint32_t v = cache[i];
+				if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+					newCache[newCacheSize++] = v;
+			}
+
+			// Rescore every vertex whose position changed and push the difference into its live triangles
+			for (uint32_t i = 0; i < newCacheSize; i++)
+			{
+				uint32_t v = newCache[i];
+				float score = VertexCacheScore(i < VertexCacheSize ? (int32_t)i : -1, liveTriangles[v]);
+				float delta = score - vertexScores[v];
+				vertexScores[v] = score;
+
+				for (uint32_t j = 0; j < liveTriangles[v]; j++)
+					triangleScores[adjacency[adjacencyOffsets[v] + j]] += delta;
+			}
+
+			cacheSize = std::min(newCacheSize, VertexCacheSize);
+			std::copy(newCache, newCache + cacheSize, cache);
+
+			// Only triangles touching the cache changed score, the best of them goes next
+			bestTriangle = invalid;
+			float bestScore = -1.0f;
+			for (uint32_t i = 0; i < cacheSize; i++)
+			{
+				uint32_t v = cache[i];
+				for (uint32_t j = 0; j < liveTriangles[v]; j++)
+				{
+					uint32_t t = adjacency[adjacencyOffsets[v] + j];
+					if (triangleScores[t] > bestScore)
+					{
+						bestScore = triangleScores[t];
+						bestTriangle = t;
+					}
+				}
+			}
+		}
+
+		indices.swap(result);
+	}
+
+	void MeshImporter::OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		const uint32_t invalid = std::numeric_limits<uint32_t>::max();
+		std::vector<uint32_t> remap(vertices.size(), invalid);
+
+		std::vector<MeshVertex> result;
+		result.reserve(vertices.size());
+		for (uint32_t& index : indices)
+		{
+			if (remap[index] == invalid)
+			{
+				remap[index] = (uint32_t)result.size();
+				result.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+
+		vertices.swap(result);
+	}
+
+	void MeshImporter::GenerateNormals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices)
+	{
+		for (MeshVertex& vertex : vertices)
+			vertex.Normal = glm::vec3(0.0f);
+
+		// Unnormalized cross products weight every face by its area
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			MeshVertex& v0 = vertices[indices[i]];
+			MeshVertex& v1 = vertices[indices[i + 1]];
+			MeshVertex& v2 = vertices[indices[i + 2]];
+			glm::vec3 normal = glm::cross(v1.Position - v0.Position, v2.Position - v0.Position);
+			v0.Normal += normal;
+			v1.Normal += normal;
+			v2.Normal += normal;
+		}
+
+		for (MeshVertex& vertex : vertices)
+		{
+			float length = glm::length(vertex.Normal);
+			vertex.Normal = length > 0.0f ? vertex.Normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+		}
+	}
+
+	bool MeshImporter::LoadOBJ(const std::string& path, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices, bool& hasNormals)
+	{
+		std::ifstream stream(path);
+		if (!stream)
+		{
+			HZ_CORE_ERROR("Could not open mesh file '{0}'", path);
+			return false;
+		}
+
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec3> normals;
+		std::vector<glm::vec2> texCoords;
+		std::vector<MeshVertex> face;
+
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			const char* str = line.c_str();
+			while (*str == ' ' || *str == '\t')
+				str++;
+
+			if (str[0] == 'v' && (str[1] == ' ' || str[1] == '\t'))
+			{
+				glm::vec3& position = positions.emplace_back();
+				Utils::ParseFloats(str + 2, &position.x, 3);
+			}
+			else if (str[0] == 'v' && str[1] == 'n')
+			{
+				glm::vec3& normal = normals.emplace_back();
+				Utils::ParseFloats(str + 2, &normal.x, 3);
+			}
+			else if (str[0] == 'v' && str[1] == 't')
+			{
+				glm::vec2& texCoord = texCoords.emplace_back();
+				Utils::ParseFloats(str + 2, &texCoord.x, 2);
+			}
+			else if (str[0] == 'f' && (str[1] == ' ' || str[1] == '\t'))
+			{
+				// v, v/vt, v//vn or v/vt/vn per corner
+				face.clear();
+				str++;
+				while (true)
+				{
+					while (*str == ' ' || *str == '\t')
+						str++;
+					if (*str == '\0' || *str == '\r' || *str == '#')
+						break;
+
+					char* end;
+					long positionIndex = std::strtol(str, &end, 10), texCoordIndex = 0, normalIndex = 0;
+					str = end;
+					if (*str == '/')
+					{
+						str++;
+						if (*str != '/')
+						{
+							texCoordIndex = std::strtol(str, &end, 10);
+							str = end;
+						}
+						if (*str == '/')
+						{
+							str++;
+							normalIndex = std::strtol(str, &end, 10);
+							str = end;
+						}
+					}
+
+					size_t index;
+					MeshVertex& vertex = face.emplace_back();
+					vertex = {};
+					if (!Utils::ResolveObjIndex(positionIndex, positions.size(), index))
+					{
+						HZ_CORE_ERROR("Invalid face index in '{0}'", path);
+						return false;
+					}
+					vertex.Position = positions[index];
+
+					if (texCoordIndex && Utils::ResolveObjIndex(texCoordIndex, texCoords.size(), index))
+						vertex.TexCoord = texCoords[index];
+
+					if (normalIndex && Utils::ResolveObjIndex(normalIndex, normals.size(), index) && glm::length(normals[index]) > 0.0f)
+						vertex.Normal = normals[index];
+					else
+						hasNormals = false;
+
+					// Skip anything unparsed in this corner
+					while (*str && *str != ' ' && *str != '\t')
+						str++;
+				}
+
+				// Polygons are fanned around their first corner
+				for (size_t i = 1; i + 1 < face.size(); i++)
+				{
+					indices.push_back((uint32_t)vertices.size());
+					vertices.push_back(face[0]);
+					indices.push_back((uint32_t)vertices.size());
+					vertices.push_back(face[i]);
+					indices.push_back((uint32_t)vertices.size());
+					vertices.push_back(face[i + 1]);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool MeshImporter::LoadGLB(const std::string& path, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices, bool& hasNormals)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+		{
+			HZ_CORE_ERROR("Could not open mesh file '{0}'", path);
+			return false;
+		}
+		std::vector<uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+		// 12 byte header, then length-prefixed chunks: JSON first, optionally BIN
+		uint32_t header[3];
+		if (data.size() < sizeof(header))
+			return false;
+		memcpy(header, data.data(), sizeof(header));
+		if (header[0] != Utils::GlbMagic || header[1] != 2)
+		{
+			HZ_CORE_ERROR("'{0}' is not a glTF 2.0 binary", path);
+			return false;
+		}
+
+		std::string json;
+		std::vector<uint8_t> bin;
+		size_t offset = sizeof(header);
+		while (offset + 8 <= data.size())
+		{
+			uint32_t chunkLength, chunkType;
+			memcpy(&chunkLength, &data[offset], 4);
+			memcpy(&chunkType, &data[offset + 4], 4);
+			offset += 8;
+			if (offset + chunkLength > data.size())
+				return false;
+
+			if (chunkType == Utils::GlbChunkJson)
+				json.assign((const char*)&data[offset], chunkLength);
+			else if (chunkType == Utils::GlbChunkBin && bin.empty())
+				bin.assign(data.begin() + offset, data.begin() + offset + chunkLength);
+			offset += chunkLength;
+		}
+
+		// JSON is valid flow-style YAML, so the scene serializer's parser reads it as-is
+		try
+		{
+			YAML::Node gltf = YAML::Load(json);
+
+			YAML::Node scenes = gltf["scenes"];
+			if (scenes && scenes.size() > 0)
+			{
+				YAML::Node scene = scenes[gltf["scene"].as<uint32_t>(0)];
+				for (const YAML::Node& node : scene["nodes"])
+				{
+					if (!Utils::AppendGltfNode(gltf, bin, node.as<uint32_t>(), glm::mat4(1.0f), vertices, indices, hasNormals))
+						return false;
+				}
+			}
+			else
+			{
+				// No scene graph, take every mesh untransformed
+				for (const YAML::Node& mesh : gltf["meshes"])
+				{
+					for (const YAML::Node& primitive : mesh["primitives"])
+					{
+						if (!Utils::AppendGltfPrimitive(gltf, bin, primitive, glm::mat4(1.0f), vertices, indices, hasNormals))
+							return false;
+					}
+				}
+			}
+		}
+		catch (const YAML::Exception& e)
+		{
+			HZ_CORE_ERROR("Invalid glTF in '{0}': {1}", path, e.what());
+			return false;
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,309 @@
+#include "Hazel/Renderer/OcclusionCuller.h"
+
+#include "Hazel/Core/JobSystem.h"
+
+#include <xmmintrin.h>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		// HiZ levels a band reduces on its own, until a band is down to a single row
+		static constexpr uint32_t OcclusionBandLevels = 4;
+		static_assert(OcclusionCuller::BandHeight == 1 << OcclusionBandLevels, "Band levels must match the band height");
+		static_assert(OcclusionCuller::Height % OcclusionCuller::BandHeight == 0, "Bands must tile the depth buffer");
+		static_assert(OcclusionCuller::Width % 4 == 0, "Rows are rasterized four pixels at a time");
+
+		// Closer to the eye than this the projection blows up, boxes with such corners are never culled nor occlude
+		static constexpr float OcclusionMinW = 1e-4f;
+
+		// Box corner i takes max.x when bit 0 is set, max.y for bit 1 and max.z for bit 2.
+		// Quads are counter-clockwise seen from outside.
+		static constexpr uint8_t BoxFaces[6][4] =
+		{
+			{ 0, 4, 6, 2 }, { 1, 3, 7, 5 }, // -x, +x
+			{ 0, 1, 5, 4 }, { 2, 6, 7, 3 }, // -y, +y
+			{ 0, 2, 3, 1 }, { 4, 5, 7, 6 }  // -z, +z
+		};
+
+		static glm::vec3 GetCorner(const AABB& box, uint32_t corner)
+		{
+			return { corner & 1 ? box.Max.x : box.Min.x, corner & 2 ? box.Max.y : box.Min.y, corner & 4 ? box.Max.z : box.Min.z };
+		}
+
+		static uint32_t GetLevelWidth(uint32_t level) { return std::max(OcclusionCuller::Width >> level, 1u); }
+		static uint32_t GetLevelHeight(uint32_t level) { return std::max(OcclusionCuller::Height >> level, 1u); }
+
+	}
+
+	OcclusionCuller::OcclusionCuller()
+	{
+		for (uint32_t level = 0; ; level++)
+		{
+			m_Levels.emplace_back(Utils::GetLevelWidth(level) * Utils::GetLevelHeight(level), 1.0f);
+			if (Utils::GetLevelWidth(level) == 1 && Utils::GetLevelHeight(level) == 1)
+				break;
+		}
+	}
+
+	void OcclusionCuller::Begin(const glm::mat4& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		m_Occluders.clear();
+	}
+
+	void OcclusionCuller::AddOccluder(const AABB& localBounds, const glm::mat4& transform)
+	{
+		glm::mat4 toClip = m_ViewProjection * transform;
+
+		glm::vec3 screen[8];
+		uint32_t outsideAll = 0x1F;
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec4 clip = toClip * glm::vec4(Utils::GetCorner(localBounds, i), 1.0f);
+			if (clip.w <= Utils::OcclusionMinW)
+				return;
+
+			uint32_t outside = (clip.x < -clip.w) | (clip.x > clip.w) << 1 | (clip.y < -clip.w) << 2 | (clip.y > clip.w) << 3 | (clip.z > clip.w) << 4;
+			outsideAll &= outside;
+
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			screen[i] = { (ndc.x * 0.5f + 0.5f) * Width, (ndc.y * 0.5f + 0.5f) * Height, ndc.z * 0.5f + 0.5f };
+		}
+
+		// Every corner beyond the same plane, nothing of it is on screen
+		if (outsideAll)
+			return;
+
+		ScreenBox box;
+
+		// The front faces give the depth. A mirroring transform turns them inside out.
+		bool mirrored = glm::determinant(glm::mat3(transform)) < 0.0f;
+		for (const uint8_t* face : Utils::BoxFaces)
+		{
+			const glm::vec3& v0 = screen[face[0]];
+			const glm::vec3& v1 = screen[face[mirrored ? 3 : 1]];
+			const glm::vec3& v2 = screen[face[2]];
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+			if (area <= 0.0f || box.PlaneCount == ScreenBox::MaxPlanes)
+				continue;
+
+			// Depth is affine in screen space, pushed to the farthest value inside the pixel
+			float planeA = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+			float planeB = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+			float planeC = v0.z - planeA * v0.x - planeB * v0.y;
+			box.PlaneA[box.PlaneCount] = planeA;
+			box.PlaneB[box.PlaneCount] = planeB;
+			box.PlaneC[box.PlaneCount] = planeC + 0.5f * (planeA + planeB) + 0.5f * (std::abs(planeA) + std::abs(planeB));
+			box.PlaneCount++;
+		}
+		if (box.PlaneCount == 0)
+			return;
+
+		// Unused planes repeat the first one, so the rasterizer can always take the max of all of them
+		for (uint32_t i = box.PlaneCount; i < ScreenBox::MaxPlanes; i++)
+		{
+			box.PlaneA[i] = box.PlaneA[0];
+			box.PlaneB[i] = box.PlaneB[0];
+			box.PlaneC[i] = box.PlaneC[0];
+		}
+
+		// Silhouette: the counter-clockwise convex hull of the corners (Andrew's monotone chain).
+		// Covering it as a whole leaves no cracks between the faces.
+		glm::vec2 points[8];
+		for (uint32_t i = 0; i < 8; i++)
+			points[i] = glm::vec2(screen[i]);
+		std::sort(points, points + 8, [](const glm::vec2& a, const glm::vec2& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+
+		auto turn = [](const glm::vec2& a, const glm::vec2& b, const glm::vec2& c) { return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x); };
+		glm::vec2 hull[16];
+		uint32_t hullCount = 0;
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			while (hullCount >= 2 && turn(hull[hullCount - 2], hull[hullCount - 1], points[i]) <= 0.0f)
+				hullCount--;
+			hull[hullCount++] = points[i];
+		}
+		for (int32_t i = 6, lower = hullCount + 1; i >= 0; i--)
+		{
+			while ((int32_t)hullCount >= lower && turn(hull[hullCount - 2], hull[hullCount - 1], points[i]) <= 0.0f)
+				hullCount--;
+			hull[hullCount++] = points[i];
+		}
+		hullCount--; // The last point closes the loop
+		if (hullCount < 3)
+			return;
+
+		glm::vec2 minScreen = hull[0], maxScreen = hull[0];
+		for (uint32_t edge = 0; edge < hullCount; edge++)
+		{
+			const glm::vec2& a = hull[edge];
+			const glm::vec2& b = hull[(edge + 1) % hullCount];
+			float edgeA = a.y - b.y;
+			float edgeB = b.x - a.x;
+			float edgeC = -(edgeA * a.x + edgeB * a.y);
+
+			// Sampled at the pixel center, minus the most the edge function drops towards a pixel corner,
+			// which only accepts pixels the silhouette covers completely
+			box.EdgeA[edge] = edgeA;
+			box.EdgeB[edge] = edgeB;
+			box.EdgeC[edge] = edgeC + 0.5f * (edgeA + edgeB) - 0.5f * (std::abs(edgeA) + std::abs(edgeB));
+
+			minScreen = glm::min(minScreen, a);
+			maxScreen = glm::max(maxScreen, a);
+		}
+		box.EdgeCount = hullCount;
+
+		float minX = std::max(std::floor(minScreen.x), 0.0f);
+		float maxX = std::min(std::ceil(maxScreen.x) - 1.0f, (float)Width - 1.0f);
+		float minY = std::max(std::floor(minScreen.y), 0.0f);
+		float maxY = std::min(std::ceil(maxScreen.y) - 1.0f, (float)Height - 1.0f);
+		if (minX > maxX || minY > maxY)
+			return;
+
+		box.MinX = (int32_t)minX;
+		box.MaxX = (int32_t)maxX;
+		box.MinY = (int32_t)minY;
+		box.MaxY = (int32_t)maxY;
+		m_Occluders.push_back(box);
+	}
+
+	void OcclusionCuller::Rasterize()
+	{
+		JobSystem::ParallelFor(Height / BandHeight, 1, [this](uint32_t begin, uint32_t end, uint32_t thread)
+		{
+			for (uint32_t band = begin; band < end; band++)
+				RasterizeBand(band);
+		});
+
+		// The top of the pyramid is a few hundred texels, not worth splitting up
+		for (uint32_t level = Utils::OcclusionBandLevels + 1; level < m_Levels.size(); level++)
+			BuildLevel(level, 0, Utils::GetLevelHeight(level));
+	}
+
+	void OcclusionCuller::RasterizeBand(uint32_t band)
+	{
+		int32_t bandMinY = band * BandHeight;
+		int32_t bandMaxY = bandMinY + BandHeight - 1;
+
+		float* depth = m_Levels[0].data();
+		std::fill(depth + bandMinY * Width, depth + (bandMaxY + 1) * Width, 1.0f);
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 four = _mm_set1_ps(4.0f);
+		__m128 edgeA[ScreenBox::MaxEdges], rowEdgeC[ScreenBox::MaxEdges];
+		__m128 planeA[ScreenBox::MaxPlanes], rowPlaneC[ScreenBox::MaxPlanes];
+		for (const ScreenBox& box : m_Occluders)
+		{
+			int32_t minY = std::max(box.MinY, bandMinY);
+			int32_t maxY = std::min(box.MaxY, bandMaxY);
+			if (minY > maxY)
+				continue;
+
+			// Four pixels at a time from an aligned start, the edge tests mask off the extra ones
+			int32_t minX = box.MinX & ~3;
+			__m128 startX = _mm_add_ps(_mm_set1_ps((float)minX), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+			for (uint32_t edge = 0; edge < box.EdgeCount; edge++)
+				edgeA[edge] = _mm_set1_ps(box.EdgeA[edge]);
+			for (uint32_t plane = 0; plane < ScreenBox::MaxPlanes; plane++)
+				planeA[plane] = _mm_set1_ps(box.PlaneA[plane]);
+
+			for (int32_t y = minY; y <= maxY; y++)
+			{
+				float fy = (float)y;
+				for (uint32_t edge = 0; edge < box.EdgeCount; edge++)
+					rowEdgeC[edge] = _mm_set1_ps(box.EdgeB[edge] * fy + box.EdgeC[edge]);
+				for (uint32_t plane = 0; plane < ScreenBox::MaxPlanes; plane++)
+					rowPlaneC[plane] = _mm_set1_ps(box.PlaneB[plane] * fy + box.PlaneC[plane]);
+
+				float* row = depth + y * Width;
+				__m128 x = startX;
+				for (int32_t px = minX; px <= box.MaxX; px += 4, x = _mm_add_ps(x, four))
+				{
+					__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], x), rowEdgeC[0]), zero);
+					for (uint32_t edge = 1; edge < box.EdgeCount; edge++)
+						inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[edge], x), rowEdgeC[edge]), zero));
+					if (!_mm_movemask_ps(inside))
+						continue;
+
+					__m128 boxDepth = _mm_max_ps(_mm_add_ps(_mm_mul_ps(planeA[0], x), rowPlaneC[0]), _mm_add_ps(_mm_mul_ps(planeA[1], x), rowPlaneC[1]));
+					boxDepth = _mm_max_ps(boxDepth, _mm_add_ps(_mm_mul_ps(planeA[2], x), rowPlaneC[2]));
+
+					__m128 current = _mm_loadu_ps(row + px);
+					__m128 nearest = _mm_min_ps(current, boxDepth);
+					_mm_storeu_ps(row + px, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+				}
+			}
+		}
+
+		for (uint32_t level = 1; level <= Utils::OcclusionBandLevels && level < m_Levels.size(); level++)
+			BuildLevel(level, bandMinY >> level, (bandMaxY + 1) >> level);
+	}
+
+	void OcclusionCuller::BuildLevel(uint32_t level, uint32_t beginRow, uint32_t endRow)
+	{
+		uint32_t sourceWidth = Utils::GetLevelWidth(level - 1);
+		uint32_t sourceHeight = Utils::GetLevelHeight(level - 1);
+		uint32_t width = Utils::GetLevelWidth(level);
+		const float* source = m_Levels[level - 1].data();
+		float* target = m_Levels[level].data();
+
+		for (uint32_t y = beginRow; y < endRow; y++)
+		{
+			const float* row0 = source + std::min(y * 2, sourceHeight - 1) * sourceWidth;
+			const float* row1 = source + std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth;
+			for (uint32_t x = 0; x < width; x++)
+			{
+				uint32_t x0 = std::min(x * 2, sourceWidth - 1);
+				uint32_t x1 = std::min(x * 2 + 1, sourceWidth - 1);
+				target[y * width + x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+			}
+		}
+	}
+
+	bool OcclusionCuller::IsOccluded(const AABB& bounds) const
+	{
+		if (m_Occluders.empty())
+			return false;
+
+		glm::vec3 minNdc(std::numeric_limits<float>::max());
+		glm::vec3 maxNdc(std::numeric_limits<float>::lowest());
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec4 clip = m_ViewProjection * glm::vec4(Utils::GetCorner(bounds, i), 1.0f);
+			if (clip.w <= Utils::OcclusionMinW)
+				return false;
+
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			minNdc = glm::min(minNdc, ndc);
+			maxNdc = glm::max(maxNdc, ndc);
+		}
+
+		// Off screen, that is up to frustum culling
+		if (maxNdc.x < -1.0f || minNdc.x > 1.0f || maxNdc.y < -1.0f || minNdc.y > 1.0f)
+			return false;
+
+		int32_t x0 = (int32_t)std::max((minNdc.x * 0.5f + 0.5f) * Width, 0.0f);
+		int32_t x1 = (int32_t)std::min((maxNdc.x * 0.5f + 0.5f) * Width, (float)Width - 1.0f);
+		int32_t y0 = (int32_t)std::max((minNdc.y * 0.5f + 0.5f) * Height, 0.0f);
+		int32_t y1 = (int32_t)std::min((maxNdc.y * 0.5f + 0.5f) * Height, (float)Height - 1.0f);
+
+		// The finest level where the rectangle spans at most 2x2 texels
+		uint32_t level = 0;
+		while (level + 1 < m_Levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+			level++;
+
+		const float* depth = m_Levels[level].data();
+		uint32_t width = Utils::GetLevelWidth(level);
+		float farthest = 0.0f;
+		for (int32_t y = y0 >> level; y <= y1 >> level; y++)
+		{
+			for (int32_t x = x0 >> level; x <= x1 >> level; x++)
+				farthest = std::max(farthest, depth[y * width + x]);
+		}
+
+		float nearest = minNdc.z * 0.5f + 0.5f;
+		return nearest > farthest;
+	}
+
+}
@@ -0,0 +1,215 @@
+#include "Hazel/Renderer/PrimitiveCache.h"
+
+#include "Hazel/Renderer/RenderCommand.h"
+#include "Hazel/Renderer/MeshImporter.h"
+
+#include <glm/gtc/constants.hpp>
+
+namespace Hazel {
+
+	struct PrimitiveCacheData
+	{
+		static constexpr uint32_t SphereLodSegments[PrimitiveCache::SphereLodCount] = { 64, 32, 16, 8 };
+
+		std::vector<Primitive> Primitives;
+		std::unordered_map<std::string, uint32_t> Names;
+	};
+
+	static PrimitiveCacheData s_PrimitiveData;
+
+	namespace Utils {
+
+		// Unit sphere centred at the origin, (segments + 1)^2 vertices
+		static void BuildUnitSphere(uint32_t segments, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+		{
+			constexpr float pi = glm::pi<float>();
+
+			vertices.clear();
+			indices.clear();
+			vertices.reserve((segments + 1) * (segments + 1));
+			indices.reserve(segments * segments * 6);
+
+			for (uint32_t x = 0; x <= segments; x++)
+			{
+				for (uint32_t y = 0; y <= segments; y++)
+				{
+					float xSegment = (float)x / (float)segments;
+					float ySegment = (float)y / (float)segments;
+					float xPos = std::cos(xSegment * 2.0f * pi) * std::sin(ySegment * pi);
+					float yPos = std::cos(ySegment * pi);
+					float zPos = std::sin(xSegment * 2.0f * pi) * std::sin(ySegment * pi);
+
+					MeshVertex& vertex = vertices.emplace_back();
+					vertex.Position = glm::vec3(xPos, yPos, zPos);
+					vertex.Normal = glm::vec3(xPos, yPos, zPos);
+					vertex.TexCoord = glm::vec2(xSegment, ySegment);
+				}
+			}
+
+			// Vertices are laid out column by column, (segments + 1) per column
+			for (uint32_t y = 0; y < segments; y++)
+			{
+				for (uint32_t x = 0; x < segments; x++)
+				{
+					indices.push_back(y * (segments + 1) + x);
+					indices.push_back((y + 1) * (segments + 1) + x);
+					indices.push_back((y + 1) * (segments + 1) + x + 1);
+
+					indices.push_back(y * (segments + 1) + x);
+					indices.push_back((y + 1) * (segments + 1) + x + 1);
+					indices.push_back(y * (segments + 1) + x + 1);
+				}
+			}
+		}
+
+	}
+
+	void PrimitiveCache::Init()
+	{
+		float cubeVertices[] = {
+			// back face
+			-1.0f, -1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 0.0f, 0.0f, // bottom-left
+			 1.0f,  1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 1.0f, 1.0f, // top-right
+			 1.0f, -1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 1.0f, 0.0f, // bottom-right         
+			 1.0f,  1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 1.0f, 1.0f, // top-right
+			-1.0f, -1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 0.0f, 0.0f, // bottom-left
+			-1.0f,  1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 0.0f, 1.0f, // top-left
+			// front face
+			-1.0f, -1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, 0.0f, // bottom-left
+			 1.0f, -1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, 0.0f, // bottom-right
+			 1.0f,  1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, 1.0f, // top-right
+			 1.0f,  1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, 1.0f, // top-right
+			-1.0f,  1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, 1.0f, // top-left
+			-1.0f, -1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, 0.0f, // bottom-left
+			// left face
+			-1.0f,  1.0f,  1.0f, -1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-right
+			-1.0f,  1.0f, -1.0f, -1.0f,  0.0f,  0.0f, 1.0f, 1.0f, // top-left
+			-1.0f, -1.0f, -1.0f, -1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-left
+			-1.0f, -1.0f, -1.0f, -1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-left
+			-1.0f, -1.0f,  1.0f, -1.0f,  0.0f,  0.0f, 0.0f, 0.0f, // bottom-right
+			-1.0f,  1.0f,  1.0f, -1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-right
+			// right face
+			 1.0f,  1.0f,  1.0f,  1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-left
+			 1.0f, -1.0f, -1.0f,  1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-right
+			 1.0f,  1.0f, -1.0f,  1.0f,  0.0f,  0.0f, 1.0f, 1.0f, // top-right         
+			 1.0f, -1.0f, -1.0f,  1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-right
+			 1.0f,  1.0f,  1.0f,  1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-left
+			 1.0f, -1.0f,  1.0f,  1.0f,  0.0f,  0.0f, 0.0f, 0.0f, // bottom-left     
+			 // bottom face
+			 -1.0f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f, 0.0f, 1.0f, // top-right
+			  1.0f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f, 1.0f, 1.0f, // top-left
+			  1.0f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f, // bottom-left
+			  1.0f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f, // bottom-left
+			 -1.0f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f, 0.0f, 0.0f, // bottom-right
+			 -1.0f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f, 0.0f, 1.0f, // top-right
+			 // top face
+			 -1.0f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f, 0.0f, 1.0f, // top-left
+			  1.0f,  1.0f , 1.0f,  0.0f,  1.0f,  0.0f, 1.0f, 0.0f, // bottom-right
+			  1.0f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f, 1.0f, 1.0f, // top-right     
+			  1.0f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f, 1.0f, 0.0f, // bottom-right
+			 -1.0f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f, 0.0f, 1.0f, // top-left
+			 -1.0f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f, 0.0f, 0.0f  // bottom-left        
+		};
+		Ref<VertexBuffer> cubeVBO = VertexBuffer::Create(cubeVertices, sizeof(cubeVertices));
+		cubeVBO->SetLayout({
+			{ ShaderDataType::Float3, "aPos"	},
+			{ ShaderDataType::Float3, "aNormal"	},
+			{ ShaderDataType::Float2, "aTexCoord"	},
+		});
+		Register("Cube", cubeVBO, nullptr, 36);
+
+		float quadVertices[] = {
+			// positions        // texture Coords
+			-1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
+			-1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+			 1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
+
+			-1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+			 1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
+			 1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+		};
+		Ref<VertexBuffer> quadVBO = VertexBuffer::Create(quadVertices, sizeof(quadVertices));
+		quadVBO->SetLayout({
+			{ ShaderDataType::Float3, "aPos"	},
+			{ ShaderDataType::Float2, "aTexCoord"	},
+		});
+		Register("Quad", quadVBO, nullptr, 6);
+
+		// Texcoords reach 2 at the far corners, so they are 0 to 1 across the screen
+		float triangleVertices[] = {
+			-1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+			 3.0f, -1.0f, 0.0f, 2.0f, 0.0f,
+			-1.0f,  3.0f, 0.0f, 0.0f, 2.0f,
+		};
+		Ref<VertexBuffer> triangleVBO = VertexBuffer::Create(triangleVertices, sizeof(triangleVertices));
+		triangleVBO->SetLayout({
+			{ ShaderDataType::Float3, "aPos"	},
+			{ ShaderDataType::Float2, "aTexCoord"	},
+		});
+		Register("FullscreenTriangle", triangleVBO, nullptr, 3);
+
+		// Spheres go through the same cache and fetch optimization as imported meshes
+		std::vector<MeshVertex> sphereVertices;
+		std::vector<uint32_t> sphereIndices;
+		for (uint32_t lod = 0; lod < SphereLodCount; lod++)
+		{
+			Utils::BuildUnitSphere(s_PrimitiveData.SphereLodSegments[lod], sphereVertices, sphereIndices);
+			MeshImporter::OptimizeVertexCache(sphereIndices, (uint32_t)sphereVertices.size());
+			MeshImporter::OptimizeVertexFetch(sphereVertices, sphereIndices);
+
+			Ref<VertexBuffer> sphereVBO = Mesh::CreateVertexBuffer(sphereVertices);
+			std::vector<uint16_t> shortIndices(sphereIndices.begin(), sphereIndices.end());
+			Ref<IndexBuffer> sphereIBO = IndexBuffer::Create(shortIndices.data(), (uint32_t)shortIndices.size());
+			uint32_t id = Register("SphereLod" + std::to_string(lod), sphereVBO, sphereIBO, (uint32_t)shortIndices.size());
+			s_PrimitiveData.Primitives[id].VertexCount = (uint32_t)sphereVertices.size();
+		}
+
+		HZ_CORE_ASSERT(s_PrimitiveData.Primitives.size() == BuiltinCount, "Built-in primitives out of order!");
+	}
+
+	uint32_t PrimitiveCache::Register(const std::string& name, const Ref<VertexBuffer>& vertexBuffer, const Ref<IndexBuffer>& indexBuffer, uint32_t count)
+	{
+		HZ_CORE_ASSERT(s_PrimitiveData.Names.find(name) == s_PrimitiveData.Names.end(), "Primitive already registered!");
+
+		uint32_t id = (uint32_t)s_PrimitiveData.Primitives.size();
+		Primitive& primitive = s_PrimitiveData.Primitives.emplace_back();
+		primitive.Name = name;
+		primitive.VertexBuffer = vertexBuffer;
+		primitive.IndexBuffer = indexBuffer;
+		primitive.Count = count;
+		primitive.VertexArray = VertexArray::Create();
+		primitive.VertexArray->AddVertexBuffer(vertexBuffer);
+		if (indexBuffer)
+			primitive.VertexArray->SetIndexBuffer(indexBuffer);
+
+		s_PrimitiveData.Names[name] = id;
+		return id;
+	}
+
+	uint32_t PrimitiveCache::Find(const std::string& name)
+	{
+		auto it = s_PrimitiveData.Names.find(name);
+		return it != s_PrimitiveData.Names.end() ? it->second : InvalidId;
+	}
+
+	const Primitive& PrimitiveCache::Get(uint32_t id)
+	{
+		HZ_CORE_ASSERT(id < s_PrimitiveData.Primitives.size(), "Invalid primitive id!");
+		return s_PrimitiveData.Primitives[id];
+	}
+
+	void PrimitiveCache::Draw(uint32_t id)
+	{
+		const Primitive& primitive = Get(id);
+		if (primitive.IndexBuffer)
+			RenderCommand::DrawIndexed(primitive.VertexArray, primitive.Count);
+		else
+			RenderCommand::DrawArrays(primitive.VertexArray, primitive.Count);
+	}
+
+	uint32_t PrimitiveCache::GetSphereLodSegments(uint32_t lod)
+	{
+		return PrimitiveCacheData::SphereLodSegments[lod];
+	}
+
+}
@@ -0,0 +1,253 @@
+#include "Hazel/Renderer/RenderGraph.h"
+
+namespace Hazel {
+
+	namespace Utils {
+
+		// Everything but the size matches
+		static bool HasSameAttachments(const FramebufferSpecification& a, const FramebufferSpecification& b)
+		{
+			if (a.Samples != b.Samples || a.SwapChainTarget != b.SwapChainTarget)
+				return false;
+
+			const auto& attachmentsA = a.Attachments.Attachments;
+			const auto& attachmentsB = b.Attachments.Attachments;
+			if (attachmentsA.size() != attachmentsB.size())
+				return false;
+
+			for (size_t i = 0; i < attachmentsA.size(); i++)
+			{
+				if (attachmentsA[i].TextureFormat != attachmentsB[i].TextureFormat)
+					return false;
+			}
+			return true;
+		}
+
+		static bool IsCompatible(const FramebufferSpecification& a, const FramebufferSpecification& b)
+		{
+			return a.Width == b.Width && a.Height == b.Height && HasSameAttachments(a, b);
+		}
+
+	}
+
+	Ref<FrameBuffer> FrameBufferPool::Acquire(const FramebufferSpecification& spec)
+	{
+		for (Entry& entry : m_Entries)
+		{
+			if (!entry.InUse && Utils::IsCompatible(entry.FrameBuffer->GetSpecification(), spec))
+			{
+				entry.InUse = true;
+				entry.LastUsedFrame = m_Frame;
+				return entry.FrameBuffer;
+			}
+		}
+
+		// A new size for the same attachments usually means a resize. Idle framebuffers of the old sizes won't be
+		// asked for again, so they are freed now instead of piling up while a viewport is dragged.
+		m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(), [&spec](const Entry& entry)
+		{
+			return !entry.InUse && Utils::HasSameAttachments(entry.FrameBuffer->GetSpecification(), spec);
+		}), m_Entries.end());
+
+		Entry& entry = m_Entries.emplace_back();
+		entry.FrameBuffer = FrameBuffer::Create(spec);
+		entry.InUse = true;
+		entry.LastUsedFrame = m_Frame;
+		m_CreatedCount++;
+		return entry.FrameBuffer;
+	}
+
+	void FrameBufferPool::Release(const Ref<FrameBuffer>& frameBuffer)
+	{
+		for (Entry& entry : m_Entries)
+		{
+			if (entry.FrameBuffer == frameBuffer)
+			{
+				HZ_CORE_ASSERT(entry.InUse, "Framebuffer released twice!");
+				entry.InUse = false;
+				entry.LastUsedFrame = m_Frame;
+				return;
+			}
+		}
+
+		HZ_CORE_ASSERT(false, "Framebuffer does not belong to this pool!");
+	}
+
+	void FrameBufferPool::EndFrame()
+	{
+		m_Frame++;
+		m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(), [this](const Entry& entry)
+		{
+			return !entry.InUse && m_Frame - entry.LastUsedFrame > MaxIdleFrames;
+		}), m_Entries.end());
+	}
+
+	void FrameBufferPool::Clear()
+	{
+		m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(), [](const Entry& entry) { return !entry.InUse; }), m_Entries.end());
+	}
+
+	void RenderGraph::Reset()
+	{
+		// Outputs kept their framebuffers past Execute
+		for (Target& target : m_Targets)
+		{
+			if (!target.Imported && target.FrameBuffer)
+				m_Pool.Release(target.FrameBuffer);
+		}
+
+		m_Targets.clear();
+		m_Passes.clear();
+		m_Pool.EndFrame();
+	}
+
+	RenderGraphResource RenderGraph::CreateTarget(const std::string& name, const FramebufferSpecification& spec)
+	{
+		Target& target = m_Targets.emplace_back();
+		target.Name = name;
+		target.Specification = spec;
+		return (RenderGraphResource)m_Targets.size() - 1;
+	}
+
+	RenderGraphResource RenderGraph::ImportTarget(const std::string& name, const Ref<FrameBuffer>& frameBuffer)
+	{
+		Target& target = m_Targets.emplace_back();
+		target.Name = name;
+		target.Specification = frameBuffer->GetSpecification();
+		target.FrameBuffer = frameBuffer;
+		target.Imported = true;
+		return (RenderGraphResource)m_Targets.size() - 1;
+	}
+
+	void RenderGraph::MarkOutput(RenderGraphResource target)
+	{
+		HZ_CORE_ASSERT(target < m_Targets.size(), "Invalid render graph target!");
+		m_Targets[target].Output = true;
+	}
+
+	void RenderGraph::AddPass(const std::string& name, const std::vector<RenderGraphResource>& reads, RenderGraphResource target,
+		const ExecuteFunction& execute, bool hasSideEffects)
+	{
+		HZ_CORE_ASSERT(target == InvalidResource || target < m_Targets.size(), "Invalid render graph target!");
+
+		Pass& pass = m_Passes.emplace_back();
+		pass.Name = name;
+		pass.Reads = reads;
+		pass.Target = target;
+		pass.Execute = execute;
+		pass.HasSideEffects = hasSideEffects;
+	}
+
+	void RenderGraph::Cull()
+	{
+		// Passes only depend on earlier ones, so walking backwards sees every consumer before its producers.
+		// Rendering to a target builds on what earlier passes left in it, so those stay too.
+		std::vector<bool> needed(m_Targets.size());
+		for (size_t i = 0; i < m_Targets.size(); i++)
+			needed[i] = m_Targets[i].Imported || m_Targets[i].Output;
+
+		for (auto pass = m_Passes.rbegin(); pass != m_Passes.rend(); ++pass)
+		{
+			pass->Culled = !pass->HasSideEffects && (pass->Target == InvalidResource || !needed[pass->Target]);
+			if (pass->Culled)
+				continue;
+
+			for (RenderGraphResource read : pass->Reads)
+				needed[read] = true;
+		}
+	}
+
+	void RenderGraph::ComputeLifetimes()
+	{
+		for (uint32_t i = 0; i < m_Passes.size(); i++)
+		{
+			const Pass& pass = m_Passes[i];
+			if (pass.Culled)
+				continue;
+
+			auto extend = [this, i](RenderGraphResource resource)
+			{
+				Target& target = m_Targets[resource];
+				target.FirstPass = std::min(target.FirstPass, i);
+				target.LastPass = std::max(target.LastPass, i);
+			};
+			for (RenderGraphResource read : pass.Reads)
+				extend(read);
+			if (pass.Target != InvalidResource)
+				extend(pass.Target);
+		}
+	}
+
+	void RenderGraph::Execute()
+	{
+		Cull();
+		ComputeLifetimes();
+
+		// Targets each pass acquires before it runs and releases after, in pass order
+		uint32_t passCount = (uint32_t)m_Passes.size();
+		std::vector<std::vector<RenderGraphResource>> acquires(passCount), releases(passCount);
+		for (RenderGraphResource i = 0; i < m_Targets.size(); i++)
+		{
+			const Target& target = m_Targets[i];
+			if (target.Imported || target.FirstPass == InvalidResource)
+				continue;
+
+			acquires[target.FirstPass].push_back(i);
+			if (!target.Output)
+				releases[target.LastPass].push_back(i);
+		}
+
+		m_Stats = Statistics();
+		m_Stats.Passes = passCount;
+		m_Stats.Targets = (uint32_t)m_Targets.size();
+
+		std::vector<Ref<FrameBuffer>> used;
+		for (uint32_t i = 0; i < passCount; i++)
+		{
+			const Pass& pass = m_Passes[i];
+			if (pass.Culled)
+			{
+				m_Stats.CulledPasses++;
+				continue;
+			}
+
+			for (RenderGraphResource resource : acquires[i])
+			{
+				Target& target = m_Targets[resource];
+				target.FrameBuffer = m_Pool.Acquire(target.Specification);
+				if (std::find(used.begin(), used.end(), target.FrameBuffer) == used.end())
+					used.push_back(target.FrameBuffer);
+			}
+
+			if (pass.Target != InvalidResource)
+				m_Targets[pass.Target].FrameBuffer->Bind();
+			pass.Execute(*this);
+			if (pass.Target != InvalidResource)
+				m_Targets[pass.Target].FrameBuffer->Unbind();
+
+			for (RenderGraphResource resource : releases[i])
+			{
+				Target& target = m_Targets[resource];
+				m_Pool.Release(target.FrameBuffer);
+				target.FrameBuffer = nullptr;
+			}
+		}
+
+		m_Stats.FrameBuffersUsed = (uint32_t)used.size();
+		m_Stats.PooledFrameBuffers = m_Pool.GetFrameBufferCount();
+		m_Stats.FrameBuffersCreated = m_Pool.GetCreatedCount();
+	}
+
+	const Ref<FrameBuffer>& RenderGraph::GetFrameBuffer(RenderGraphResource target) const
+	{
+		HZ_CORE_ASSERT(target < m_Targets.size(), "Invalid render graph target!");
+		HZ_CORE_ASSERT(m_Targets[target].FrameBuffer, "Render graph target is not allocated!");
+		return m_Targets[target].FrameBuffer;
+	}
+
+	void RenderGraph::ReleaseFrameBuffers()
+	{
+		m_Pool.Clear();
+	}
+
+}
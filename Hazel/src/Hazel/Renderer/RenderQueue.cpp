@@ -0,0 +1,104 @@
+#include "Hazel/Renderer/RenderQueue.h"
+
+namespace Hazel {
+
+	static constexpr uint32_t s_MaterialBits = 14;
+	static constexpr uint32_t s_MeshBits = 10;
+	static constexpr uint32_t s_ShaderBits = 6;
+	static constexpr uint32_t s_DepthBits = 32;
+	static constexpr uint32_t s_PassShift = 62;
+
+	static constexpr uint32_t s_StateBits = s_ShaderBits + s_MeshBits + s_MaterialBits;
+	static constexpr uint64_t s_MaterialMask = (1ull << s_MaterialBits) - 1;
+	static constexpr uint64_t s_MeshMask = (1ull << s_MeshBits) - 1;
+	static constexpr uint64_t s_ShaderMask = (1ull << s_ShaderBits) - 1;
+
+	// Bit pattern of a non-negative float orders the same way as its value
+	static uint32_t DepthToBits(float depth)
+	{
+		depth = std::max(depth, 0.0f);
+		uint32_t bits;
+		memcpy(&bits, &depth, sizeof(float));
+		return bits;
+	}
+
+	uint64_t RenderQueue::MakeKey(Pass pass, uint32_t shader, uint32_t mesh, uint32_t material, float depth)
+	{
+		HZ_CORE_ASSERT(shader <= s_ShaderMask, "Shader id does not fit in the sort key!");
+		HZ_CORE_ASSERT(mesh <= s_MeshMask, "Mesh id does not fit in the sort key!");
+		HZ_CORE_ASSERT(material <= s_MaterialMask, "Material id does not fit in the sort key!");
+
+		uint64_t state = ((uint64_t)shader << (s_MeshBits + s_MaterialBits)) | ((uint64_t)mesh << s_MaterialBits) | (uint64_t)material;
+		uint64_t key = (uint64_t)pass << s_PassShift;
+		if (pass == Pass::Opaque)
+			key |= (state << s_DepthBits) | DepthToBits(depth);
+		else
+			key |= ((uint64_t)(~DepthToBits(depth)) << s_StateBits) | state;
+		return key;
+	}
+
+	RenderQueue::Pass RenderQueue::GetPass(uint64_t key)
+	{
+		return (Pass)(key >> s_PassShift);
+	}
+
+	uint32_t RenderQueue::GetShader(uint64_t key)
+	{
+		uint64_t state = GetPass(key) == Pass::Opaque ? key >> s_DepthBits : key;
+		return (uint32_t)((state >> (s_MeshBits + s_MaterialBits)) & s_ShaderMask);
+	}
+
+	uint32_t RenderQueue::GetMesh(uint64_t key)
+	{
+		uint64_t state = GetPass(key) == Pass::Opaque ? key >> s_DepthBits : key;
+		return (uint32_t)((state >> s_MaterialBits) & s_MeshMask);
+	}
+
+	uint32_t RenderQueue::GetMaterial(uint64_t key)
+	{
+		uint64_t state = GetPass(key) == Pass::Opaque ? key >> s_DepthBits : key;
+		return (uint32_t)(state & s_MaterialMask);
+	}
+
+	void RenderQueue::Sort()
+	{
+		size_t count = m_Packets.size();
+		if (count < 2)
+			return;
+
+		// One read pass builds the histograms of all eight key bytes
+		uint32_t histograms[8][256] = {};
+		for (const DrawPacket& packet : m_Packets)
+		{
+			for (uint32_t byte = 0; byte < 8; byte++)
+				histograms[byte][(packet.SortKey >> (byte * 8)) & 0xFF]++;
+		}
+
+		m_Scratch.resize(count);
+		DrawPacket* src = m_Packets.data();
+		DrawPacket* dst = m_Scratch.data();
+		for (uint32_t byte = 0; byte < 8; byte++)
+		{
+			uint32_t shift = byte * 8;
+			uint32_t* histogram = histograms[byte];
+			if (histogram[(src[0].SortKey >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < 256; bucket++)
+			{
+				uint32_t bucketCount = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += bucketCount;
+			}
+
+			for (size_t i = 0; i < count; i++)
+				dst[histogram[(src[i].SortKey >> shift) & 0xFF]++] = src[i];
+			std::swap(src, dst);
+		}
+
+		if (src != m_Packets.data())
+			m_Packets.swap(m_Scratch);
+	}
+
+}
@@ -2,6 +2,7 @@
 
 #include "Hazel/Renderer/Renderer2D.h"
 #include "Hazel/Renderer/Renderer3D.h"
+#include "Hazel/Renderer/PrimitiveCache.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
 namespace Hazel {
@@ -11,7 +12,8 @@ namespace Hazel {
 	void Renderer::Init()
 	{
 		RenderCommand::Init();
-		//Renderer2D::Init();
+		PrimitiveCache::Init();
+		Renderer2D::Init();
 		Renderer3D::Init();
 	}
 
@@ -1,32 +1,38 @@
 #include "Hazel/Renderer/Renderer2D.h"
 
 #include "Hazel/Renderer/VertexArray.h"
+#include "Hazel/Renderer/RingBuffer.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/RenderCommand.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 namespace Hazel {
 
-	struct QuadVertex
+	// Quads and circles are drawn instanced over a static unit quad, one record per primitive. The quad is flat,
+	// so only the x, y and translation columns of its transform are kept. Colors are stored as 8-bit unorm,
+	// so they are clamped to [0, 1].
+	struct QuadInstance
 	{
-		glm::vec3 Position;
-		glm::vec4 Color;
-		glm::vec2 TexCoord;
-		float TexIndex;
-		float TilingFactor;
+		glm::vec3 AxisX; // Transform columns 0, 1 and 3
+		glm::vec3 AxisY;
+		glm::vec3 Translation;
+		uint32_t Color;
+		glm::vec4 TexRect; // Min, max
+		uint32_t TexIndexTiling; // Half2: texture index, tiling factor
 
 		// Editor-only
 		int EntityID;
 	};
 
-	struct CircleVertex
+	struct CircleInstance
 	{
-		glm::vec3 WorldPosition;
-		glm::vec3 LocalPosition;
-		glm::vec4 Color;
-		float Thickness;
-		float Fade;
+		glm::vec3 AxisX; // Transform columns 0, 1 and 3
+		glm::vec3 AxisY;
+		glm::vec3 Translation;
+		uint32_t Color;
+		uint32_t ThicknessFade; // Half2
 
 		// Editor-only
 		int EntityID;
@@ -35,7 +41,7 @@ namespace Hazel {
 	struct LineVertex
 	{
 		glm::vec3 Position;
-		glm::vec4 Color;
+		uint32_t Color;
 
 		// Editor-only
 		int EntityID;
@@ -45,37 +51,54 @@ namespace Hazel {
 	{
 		static const uint32_t MaxQuads = 20000;
 		static const uint32_t MaxVertices = MaxQuads * 4;
-		static const uint32_t MaxIndices = MaxQuads * 6;
+		// Batches start in the current ring buffer segment as long as this much of it is left
+		static const uint32_t MinBatchQuads = MaxQuads / 16;
+		static const uint32_t MinBatchVertices = MaxVertices / 16;
 		static const uint32_t MaxTextureSlots = 32; // TODO: RenderCaps
+		// Vertex sizes before the layouts were packed and instanced, for the statistics
+		static const uint32_t UnpackedQuadVertexSize = 48;
+		static const uint32_t UnpackedCircleVertexSize = 52;
+		static const uint32_t UnpackedLineVertexSize = 32;
+
+		Ref<VertexBuffer> UnitQuadVertexBuffer;
 
 		Ref<VertexArray> QuadVertexArray;
-		Ref<VertexBuffer> QuadVertexBuffer;
+		Ref<RingBuffer> QuadInstanceBuffer;
 		Ref<Shader> QuadShader;
 		Ref<Texture> WhiteTexture;
 
 		Ref<VertexArray> CircleVertexArray;
-		Ref<VertexBuffer> CircleVertexBuffer;
+		Ref<RingBuffer> CircleInstanceBuffer;
 		Ref<Shader> CircleShader;
 
 		Ref<VertexArray> LineVertexArray;
-		Ref<VertexBuffer> LineVertexBuffer;
+		Ref<RingBuffer> LineVertexBuffer;
 		Ref<Shader> LineShader;
 
-		uint32_t QuadIndexCount = 0;
-		QuadVertex* QuadVertexBufferBase = nullptr;
-		QuadVertex* QuadVertexBufferPtr = nullptr;
+		// Batches are written straight into the mapped ring buffers, at the base instance or vertex reserved for them
+		uint32_t QuadInstanceCount = 0;
+		uint32_t QuadInstanceCapacity = 0;
+		QuadInstance* QuadInstanceBufferBase = nullptr;
+		QuadInstance* QuadInstanceBufferPtr = nullptr;
+		uint32_t QuadBaseInstance = 0;
 
-		uint32_t CircleIndexCount = 0;
-		CircleVertex* CircleVertexBufferBase = nullptr;
-		CircleVertex* CircleVertexBufferPtr = nullptr;
+		uint32_t CircleInstanceCount = 0;
+		uint32_t CircleInstanceCapacity = 0;
+		CircleInstance* CircleInstanceBufferBase = nullptr;
+		CircleInstance* CircleInstanceBufferPtr = nullptr;
+		uint32_t CircleBaseInstance = 0;
 
 		uint32_t LineVertexCount = 0;
+		uint32_t LineVertexCapacity = 0;
 		LineVertex* LineVertexBufferBase = nullptr;
 		LineVertex* LineVertexBufferPtr = nullptr;
+		uint32_t LineBaseVertex = 0;
 
 		float LineWidth = 2.0f;
 
-		std::array<Ref<Texture>, MaxTextureSlots> TextureSlots;
+		std::array<const Texture*, MaxTextureSlots> TextureSlots;
+		// Textures handed in by Ref are held until their batch is flushed, DrawQuads callers keep their own alive
+		std::array<Ref<Texture>, MaxTextureSlots> TextureSlotRefs;
 		uint32_t TextureSlotIndex = 1; // 0 = white texture
 
 		glm::vec4 QuadVertexPositions[4];
@@ -85,68 +108,98 @@ namespace Hazel {
 
 	static Renderer2DData s_DataR2D;
 
+	namespace Utils {
+
+		// Slot of the texture in the current batch, taking a new one if needed. -1 when the batch is out of slots.
+		static int32_t FindTextureSlot(const Texture2D* texture)
+		{
+			for (uint32_t i = 1; i < s_DataR2D.TextureSlotIndex; i++)
+			{
+				if (*s_DataR2D.TextureSlots[i] == *texture)
+					return (int32_t)i;
+			}
+
+			if (s_DataR2D.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+				return -1;
+
+			uint32_t slot = s_DataR2D.TextureSlotIndex++;
+			s_DataR2D.TextureSlots[slot] = texture;
+			return (int32_t)slot;
+		}
+
+		static int32_t FindTextureSlot(const Ref<Texture2D>& texture)
+		{
+			uint32_t slotCount = s_DataR2D.TextureSlotIndex;
+			int32_t slot = FindTextureSlot(texture.get());
+			if (slot >= (int32_t)slotCount)
+				s_DataR2D.TextureSlotRefs[slot] = texture;
+			return slot;
+		}
+
+	}
+
 	void Renderer2D::Init()
 	{
-		// Quad
-		s_DataR2D.QuadVertexArray = VertexArray::Create();
+		s_DataR2D.QuadVertexPositions[0] = { -0.5, -0.5, 0.0f, 1.0f };
+		s_DataR2D.QuadVertexPositions[1] = { 0.5, -0.5, 0.0f, 1.0f };
+		s_DataR2D.QuadVertexPositions[2] = { 0.5,  0.5, 0.0f, 1.0f };
+		s_DataR2D.QuadVertexPositions[3] = { -0.5,  0.5, 0.0f, 1.0f };
 
-		s_DataR2D.QuadVertexBuffer = VertexBuffer::Create(s_DataR2D.MaxVertices * sizeof(QuadVertex));
-		s_DataR2D.QuadVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "a_Position"	},
-			{ ShaderDataType::Float4, "a_Color"		    },
-			{ ShaderDataType::Float2, "a_TexCoord"	    },
-			{ ShaderDataType::Float,  "a_TexIndex"	    },
-			{ ShaderDataType::Float,  "a_TilingFactor"  },
-			{ ShaderDataType::Int,	  "a_EntityID"	    },
+		// Unit quad, shared by the quad and circle instances
+		glm::vec2 unitQuad[4];
+		for (uint32_t i = 0; i < 4; i++)
+			unitQuad[i] = s_DataR2D.QuadVertexPositions[i];
+		s_DataR2D.UnitQuadVertexBuffer = VertexBuffer::Create(unitQuad, sizeof(unitQuad));
+		s_DataR2D.UnitQuadVertexBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Position" },
 			});
-		s_DataR2D.QuadVertexArray->AddVertexBuffer(s_DataR2D.QuadVertexBuffer);
 
-		s_DataR2D.QuadVertexBufferBase = new QuadVertex[s_DataR2D.MaxVertices];
+		uint32_t quadIndices[6] = { 0, 1, 2, 2, 3, 0 };
+		Ref<IndexBuffer> quadIB = IndexBuffer::Create(quadIndices, 6);
 
-		uint32_t* quadIndices = new uint32_t[s_DataR2D.MaxIndices];
-		uint32_t offet = 0;
-		for (uint32_t i = 0; i < s_DataR2D.MaxIndices; i += 6)
-		{
-			quadIndices[i + 0] = offet + 0;
-			quadIndices[i + 1] = offet + 1;
-			quadIndices[i + 2] = offet + 2;
-			quadIndices[i + 3] = offet + 2;
-			quadIndices[i + 4] = offet + 3;
-			quadIndices[i + 5] = offet + 0;
-
-			offet += 4;
-		}
-		Ref<IndexBuffer> quadIB = IndexBuffer::Create(quadIndices, s_DataR2D.MaxIndices);
+		// Quad
+		s_DataR2D.QuadVertexArray = VertexArray::Create();
+		s_DataR2D.QuadVertexArray->AddVertexBuffer(s_DataR2D.UnitQuadVertexBuffer);
+
+		s_DataR2D.QuadInstanceBuffer = RingBuffer::Create(s_DataR2D.MaxQuads * sizeof(QuadInstance));
+		s_DataR2D.QuadInstanceBuffer->SetLayout({
+			{ ShaderDataType::Float3,     "a_AxisX"		    },
+			{ ShaderDataType::Float3,     "a_AxisY"		    },
+			{ ShaderDataType::Float3,     "a_Translation"	    },
+			{ ShaderDataType::UByte4Norm, "a_Color"		    },
+			{ ShaderDataType::Float4,     "a_TexRect"	    },
+			{ ShaderDataType::Half2,      "a_TexIndexTiling"  },
+			{ ShaderDataType::Int,	      "a_EntityID"	    },
+			});
+		s_DataR2D.QuadVertexArray->AddInstanceBuffer(s_DataR2D.QuadInstanceBuffer);
 		s_DataR2D.QuadVertexArray->SetIndexBuffer(quadIB);
-		delete[] quadIndices;
 
 		// Circles
 		s_DataR2D.CircleVertexArray = VertexArray::Create();
-
-		s_DataR2D.CircleVertexBuffer = VertexBuffer::Create(s_DataR2D.MaxVertices * sizeof(CircleVertex));
-		s_DataR2D.CircleVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "a_WorldPosition"	},
-			{ ShaderDataType::Float3, "a_LocalPosition"	},
-			{ ShaderDataType::Float4, "a_Color"		},
-			{ ShaderDataType::Float,  "a_Thickness"	},
-			{ ShaderDataType::Float,  "a_Fade"		},
-			{ ShaderDataType::Int,	  "a_EntityID"	},
+		s_DataR2D.CircleVertexArray->AddVertexBuffer(s_DataR2D.UnitQuadVertexBuffer);
+
+		s_DataR2D.CircleInstanceBuffer = RingBuffer::Create(s_DataR2D.MaxQuads * sizeof(CircleInstance));
+		s_DataR2D.CircleInstanceBuffer->SetLayout({
+			{ ShaderDataType::Float3,     "a_AxisX"		},
+			{ ShaderDataType::Float3,     "a_AxisY"		},
+			{ ShaderDataType::Float3,     "a_Translation"	},
+			{ ShaderDataType::UByte4Norm, "a_Color"		},
+			{ ShaderDataType::Half2,      "a_ThicknessFade"	},
+			{ ShaderDataType::Int,	      "a_EntityID"	},
 			});
-		s_DataR2D.CircleVertexArray->AddVertexBuffer(s_DataR2D.CircleVertexBuffer);
+		s_DataR2D.CircleVertexArray->AddInstanceBuffer(s_DataR2D.CircleInstanceBuffer);
 		s_DataR2D.CircleVertexArray->SetIndexBuffer(quadIB); // Use quad IB
-		s_DataR2D.CircleVertexBufferBase = new CircleVertex[s_DataR2D.MaxVertices];
 
 		// Lines
 		s_DataR2D.LineVertexArray = VertexArray::Create();
 
-		s_DataR2D.LineVertexBuffer = VertexBuffer::Create(s_DataR2D.MaxVertices * sizeof(LineVertex));
+		s_DataR2D.LineVertexBuffer = RingBuffer::Create(s_DataR2D.MaxVertices * sizeof(LineVertex));
 		s_DataR2D.LineVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "a_Position"	},
-			{ ShaderDataType::Float4, "a_Color"	},
-			{ ShaderDataType::Int,	  "a_EntityID"	},
+			{ ShaderDataType::Float3,     "a_Position"	},
+			{ ShaderDataType::UByte4Norm, "a_Color"	},
+			{ ShaderDataType::Int,	      "a_EntityID"	},
 			});
 		s_DataR2D.LineVertexArray->AddVertexBuffer(s_DataR2D.LineVertexBuffer);
-		s_DataR2D.LineVertexBufferBase = new LineVertex[s_DataR2D.MaxVertices];
 
 
 		s_DataR2D.WhiteTexture = Texture2D::Create(1, 1);
@@ -165,12 +218,7 @@ namespace Hazel {
 		s_DataR2D.QuadShader->SetIntArray("u_Textures", samplers, s_DataR2D.MaxTextureSlots);
 
 		// Set first texture slot to 0
-		s_DataR2D.TextureSlots[0] = s_DataR2D.WhiteTexture;
-
-		s_DataR2D.QuadVertexPositions[0] = { -0.5, -0.5, 0.0f, 1.0f };
-		s_DataR2D.QuadVertexPositions[1] = { 0.5, -0.5, 0.0f, 1.0f };
-		s_DataR2D.QuadVertexPositions[2] = { 0.5,  0.5, 0.0f, 1.0f };
-		s_DataR2D.QuadVertexPositions[3] = { -0.5,  0.5, 0.0f, 1.0f };
+		s_DataR2D.TextureSlots[0] = s_DataR2D.WhiteTexture.get();
 	}
 
 	void Renderer2D::Shutdown()
@@ -217,52 +265,78 @@ namespace Hazel {
 
 	void Renderer2D::StartBatch()
 	{
-		s_DataR2D.QuadIndexCount = 0;
-		s_DataR2D.QuadVertexBufferPtr = s_DataR2D.QuadVertexBufferBase;
-
-		s_DataR2D.CircleIndexCount = 0;
-		s_DataR2D.CircleVertexBufferPtr = s_DataR2D.CircleVertexBufferBase;
-
+		// A batch reserves what is left of the current segment and Flush only commits what was written, so the
+		// batches of a frame share a segment and the ring only moves on, and may wait on the GPU, once one fills up.
+		// Reserving without committing takes no space, so primitives a batch doesn't use cost nothing.
+		RingBuffer::Allocation quads = s_DataR2D.QuadInstanceBuffer->ReserveAvailable(Renderer2DData::MinBatchQuads * sizeof(QuadInstance),
+			Renderer2DData::MaxQuads * sizeof(QuadInstance), sizeof(QuadInstance));
+		s_DataR2D.QuadInstanceCount = 0;
+		s_DataR2D.QuadInstanceCapacity = quads.Size / sizeof(QuadInstance);
+		s_DataR2D.QuadInstanceBufferBase = (QuadInstance*)quads.Data;
+		s_DataR2D.QuadInstanceBufferPtr = s_DataR2D.QuadInstanceBufferBase;
+		s_DataR2D.QuadBaseInstance = quads.Offset / sizeof(QuadInstance);
+
+		RingBuffer::Allocation circles = s_DataR2D.CircleInstanceBuffer->ReserveAvailable(Renderer2DData::MinBatchQuads * sizeof(CircleInstance),
+			Renderer2DData::MaxQuads * sizeof(CircleInstance), sizeof(CircleInstance));
+		s_DataR2D.CircleInstanceCount = 0;
+		s_DataR2D.CircleInstanceCapacity = circles.Size / sizeof(CircleInstance);
+		s_DataR2D.CircleInstanceBufferBase = (CircleInstance*)circles.Data;
+		s_DataR2D.CircleInstanceBufferPtr = s_DataR2D.CircleInstanceBufferBase;
+		s_DataR2D.CircleBaseInstance = circles.Offset / sizeof(CircleInstance);
+
+		RingBuffer::Allocation lines = s_DataR2D.LineVertexBuffer->ReserveAvailable(Renderer2DData::MinBatchVertices * sizeof(LineVertex),
+			Renderer2DData::MaxVertices * sizeof(LineVertex), sizeof(LineVertex));
 		s_DataR2D.LineVertexCount = 0;
+		s_DataR2D.LineVertexCapacity = lines.Size / sizeof(LineVertex);
+		s_DataR2D.LineVertexBufferBase = (LineVertex*)lines.Data;
 		s_DataR2D.LineVertexBufferPtr = s_DataR2D.LineVertexBufferBase;
+		s_DataR2D.LineBaseVertex = lines.Offset / sizeof(LineVertex);
 
+		for (uint32_t i = 1; i < s_DataR2D.TextureSlotIndex; i++)
+			s_DataR2D.TextureSlotRefs[i] = nullptr;
 		s_DataR2D.TextureSlotIndex = 1;
 	}
 
 	void Renderer2D::Flush()
 	{
-		if (s_DataR2D.QuadIndexCount)
+		if (s_DataR2D.QuadInstanceCount)
 		{
-			uint32_t dataSize = (uint8_t*)s_DataR2D.QuadVertexBufferPtr - (uint8_t*)s_DataR2D.QuadVertexBufferBase;
-			s_DataR2D.QuadVertexBuffer->SetData(s_DataR2D.QuadVertexBufferBase, dataSize);
+			uint32_t dataSize = s_DataR2D.QuadInstanceCount * sizeof(QuadInstance);
+			s_DataR2D.QuadInstanceBuffer->Commit(dataSize);
+			s_DataR2D.Stats.VertexBytes += dataSize;
+			s_DataR2D.Stats.UnpackedVertexBytes += s_DataR2D.QuadInstanceCount * 4 * Renderer2DData::UnpackedQuadVertexSize;
 
 			// Bind textures
 			for (uint32_t i = 0; i < s_DataR2D.TextureSlotIndex; i++)
 				s_DataR2D.TextureSlots[i]->Bind(i);
 
 			s_DataR2D.QuadShader->Bind();
-			RenderCommand::DrawIndexed(s_DataR2D.QuadVertexArray, s_DataR2D.QuadIndexCount);
+			RenderCommand::DrawIndexedInstanced(s_DataR2D.QuadVertexArray, 6, s_DataR2D.QuadInstanceCount, s_DataR2D.QuadBaseInstance);
 			s_DataR2D.Stats.DrawCalls++;
 		}
 
-		if (s_DataR2D.CircleIndexCount)
+		if (s_DataR2D.CircleInstanceCount)
 		{
-			uint32_t dataSize = (uint8_t*)s_DataR2D.CircleVertexBufferPtr - (uint8_t*)s_DataR2D.CircleVertexBufferBase;
-			s_DataR2D.CircleVertexBuffer->SetData(s_DataR2D.CircleVertexBufferBase, dataSize);
+			uint32_t dataSize = s_DataR2D.CircleInstanceCount * sizeof(CircleInstance);
+			s_DataR2D.CircleInstanceBuffer->Commit(dataSize);
+			s_DataR2D.Stats.VertexBytes += dataSize;
+			s_DataR2D.Stats.UnpackedVertexBytes += s_DataR2D.CircleInstanceCount * 4 * Renderer2DData::UnpackedCircleVertexSize;
 
 			s_DataR2D.CircleShader->Bind();
-			RenderCommand::DrawIndexed(s_DataR2D.CircleVertexArray, s_DataR2D.CircleIndexCount);
+			RenderCommand::DrawIndexedInstanced(s_DataR2D.CircleVertexArray, 6, s_DataR2D.CircleInstanceCount, s_DataR2D.CircleBaseInstance);
 			s_DataR2D.Stats.DrawCalls++;
 		}
 
 		if (s_DataR2D.LineVertexCount)
 		{
 			uint32_t dataSize = (uint8_t*)s_DataR2D.LineVertexBufferPtr - (uint8_t*)s_DataR2D.LineVertexBufferBase;
-			s_DataR2D.LineVertexBuffer->SetData(s_DataR2D.LineVertexBufferBase, dataSize);
+			s_DataR2D.LineVertexBuffer->Commit(dataSize);
+			s_DataR2D.Stats.VertexBytes += dataSize;
+			s_DataR2D.Stats.UnpackedVertexBytes += dataSize / sizeof(LineVertex) * Renderer2DData::UnpackedLineVertexSize;
 
 			s_DataR2D.LineShader->Bind();
 			RenderCommand::SetLineWidth(s_DataR2D.LineWidth);
-			RenderCommand::DrawLines(s_DataR2D.LineVertexArray, s_DataR2D.LineVertexCount);
+			RenderCommand::DrawLines(s_DataR2D.LineVertexArray, s_DataR2D.LineVertexCount, s_DataR2D.LineBaseVertex);
 			s_DataR2D.Stats.DrawCalls++;
 		}
 	}
@@ -273,6 +347,44 @@ namespace Hazel {
 		StartBatch();
 	}
 
+	float Renderer2D::GetTextureIndex(const Ref<Texture2D>& texture)
+	{
+		if (!texture)
+			return 0.0f; // White Texture
+
+		int32_t slot = Utils::FindTextureSlot(texture);
+		if (slot < 0)
+		{
+			NextBatch();
+			slot = Utils::FindTextureSlot(texture);
+		}
+		return (float)slot;
+	}
+
+	void Renderer2D::SubmitQuad(const glm::vec3& axisX, const glm::vec3& axisY, const glm::vec3& translation, const Ref<Texture2D>& texture,
+		float tilingFactor, const glm::vec4& color, const glm::vec4& texRect, int entityID)
+	{
+		// Writing past the reserved batch would land in ring buffer space a pending draw may still read
+		if (s_DataR2D.QuadInstanceCount >= s_DataR2D.QuadInstanceCapacity)
+			NextBatch();
+
+		// After the batch check, a texture slot taken here must not be reset by it
+		float textureIndex = GetTextureIndex(texture);
+
+		QuadInstance& instance = *s_DataR2D.QuadInstanceBufferPtr++;
+		instance.AxisX = axisX;
+		instance.AxisY = axisY;
+		instance.Translation = translation;
+		instance.Color = glm::packUnorm4x8(color);
+		instance.TexRect = texRect;
+		instance.TexIndexTiling = glm::packHalf2x16({ textureIndex, tilingFactor });
+		instance.EntityID = entityID;
+
+		s_DataR2D.QuadInstanceCount++;
+
+		s_DataR2D.Stats.QuadCount++;
+	}
+
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
 	{
 		DrawQuad({ position.x, position.y, 0.0f }, size, color);
@@ -280,10 +392,7 @@ namespace Hazel {
 
 	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
 	{
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		DrawQuad(transform, color);
+		SubmitQuad({ size.x, 0.0f, 0.0f }, { 0.0f, size.y, 0.0f }, position, nullptr, 1.0f, color, { 0.0f, 0.0f, 1.0f, 1.0f }, -1);
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D> texture, float tilingFactor, const glm::vec4& tintColor)
@@ -293,78 +402,74 @@ namespace Hazel {
 
 	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D> texture, float tilingFactor, const glm::vec4& tintColor)
 	{
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		DrawQuad(transform, texture, tilingFactor, tintColor);
+		SubmitQuad({ size.x, 0.0f, 0.0f }, { 0.0f, size.y, 0.0f }, position, texture, tilingFactor, tintColor, { 0.0f, 0.0f, 1.0f, 1.0f }, -1);
 	}
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color, int entityID)
 	{
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-		constexpr float textureIndex = 0.0f; // White Texture;
-		constexpr float tilingFactor = 1.0f;
-
-		if (s_DataR2D.QuadIndexCount >= Renderer2DData::MaxIndices)
-			NextBatch();
-
-		for (size_t i = 0; i < quadVertexCount; i++)
-		{
-			s_DataR2D.QuadVertexBufferPtr->Position = transform * s_DataR2D.QuadVertexPositions[i];
-			s_DataR2D.QuadVertexBufferPtr->Color = color;
-			s_DataR2D.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_DataR2D.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_DataR2D.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_DataR2D.QuadVertexBufferPtr->EntityID = entityID;
-			s_DataR2D.QuadVertexBufferPtr++;
-		}
-
-		s_DataR2D.QuadIndexCount += 6;
-
-		s_DataR2D.Stats.QuadCount++;
+		SubmitQuad(transform[0], transform[1], transform[3], nullptr, 1.0f, color, { 0.0f, 0.0f, 1.0f, 1.0f }, entityID);
 	}
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D> texture, float tilingFactor, const glm::vec4& tintColor, int entityID)
 	{
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-
-		float textureIndex = 0.0f;
+		SubmitQuad(transform[0], transform[1], transform[3], texture, tilingFactor, tintColor, { 0.0f, 0.0f, 1.0f, 1.0f }, entityID);
+	}
 
-		if (s_DataR2D.QuadIndexCount >= Renderer2DData::MaxIndices)
-			NextBatch();
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	{
+		const glm::vec2* texCoords = subTexture->GetTexCoords();
+		SubmitQuad(transform[0], transform[1], transform[3], subTexture->GetTexture(), tilingFactor, tintColor,
+			{ texCoords[0].x, texCoords[0].y, texCoords[2].x, texCoords[2].y }, entityID);
+	}
 
-		for (uint32_t i = 0; i < s_DataR2D.TextureSlotIndex; i++)
+	void Renderer2D::DrawQuads(uint32_t count, const glm::mat4* transforms, const glm::vec4* colors, const Texture2D* const* textures,
+		const glm::vec4* texRects, const float* tilingFactors, const int* entityIDs)
+	{
+		uint32_t i = 0;
+		while (i < count)
 		{
-			if (*s_DataR2D.TextureSlots[i] == *texture)
+			if (s_DataR2D.QuadInstanceCount >= s_DataR2D.QuadInstanceCapacity)
+				NextBatch();
+
+			// Fill the rest of the batch, or up to the first texture it has no slot left for. The slot is only
+			// looked up when the texture changes, sorted or repeated textures cost nothing.
+			uint32_t first = i;
+			uint32_t end = std::min(count, i + s_DataR2D.QuadInstanceCapacity - s_DataR2D.QuadInstanceCount);
+			const Texture2D* runTexture = nullptr;
+			float textureIndex = 0.0f; // White Texture
+			QuadInstance* instance = s_DataR2D.QuadInstanceBufferPtr;
+			for (; i < end; i++, instance++)
 			{
-				textureIndex = (float)i;
-				break;
+				const Texture2D* texture = textures ? textures[i] : nullptr;
+				if (texture != runTexture)
+				{
+					int32_t slot = texture ? Utils::FindTextureSlot(texture) : 0;
+					if (slot < 0)
+						break;
+
+					runTexture = texture;
+					textureIndex = (float)slot;
+				}
+
+				const glm::mat4& transform = transforms[i];
+				instance->AxisX = transform[0];
+				instance->AxisY = transform[1];
+				instance->Translation = transform[3];
+				instance->Color = glm::packUnorm4x8(colors[i]);
+				instance->TexRect = texRects ? texRects[i] : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+				instance->TexIndexTiling = glm::packHalf2x16({ textureIndex, texture && tilingFactors ? tilingFactors[i] : 1.0f });
+				instance->EntityID = entityIDs ? entityIDs[i] : -1;
 			}
-		}
 
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = (float)s_DataR2D.TextureSlotIndex;
-			s_DataR2D.TextureSlots[textureIndex] = texture;
-			s_DataR2D.TextureSlotIndex++;
-		}
+			uint32_t written = i - first;
+			s_DataR2D.QuadInstanceBufferPtr += written;
+			s_DataR2D.QuadInstanceCount += written;
+			s_DataR2D.Stats.QuadCount += written;
 
-		for (size_t i = 0; i < quadVertexCount; i++)
-		{
-			s_DataR2D.QuadVertexBufferPtr->Position = transform * s_DataR2D.QuadVertexPositions[i];
-			s_DataR2D.QuadVertexBufferPtr->Color = tintColor;
-			s_DataR2D.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_DataR2D.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_DataR2D.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_DataR2D.QuadVertexBufferPtr->EntityID = entityID;
-			s_DataR2D.QuadVertexBufferPtr++;
+			// Stopped on a texture without a slot
+			if (i < end)
+				NextBatch();
 		}
-
-		s_DataR2D.QuadIndexCount += 6;
-
-		s_DataR2D.Stats.QuadCount++;
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color)
@@ -374,31 +479,7 @@ namespace Hazel {
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
 	{
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-		constexpr float textureIndex = 0.0f; // White Texture;
-		constexpr float tilingFactor = 1.0f;
-
-		if (s_DataR2D.QuadIndexCount >= Renderer2DData::MaxIndices)
-			NextBatch();
-
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		for (size_t i = 0; i < quadVertexCount; i++)
-		{
-			s_DataR2D.QuadVertexBufferPtr->Position = transform * s_DataR2D.QuadVertexPositions[i];
-			s_DataR2D.QuadVertexBufferPtr->Color = color;
-			s_DataR2D.QuadVertexBufferPtr->TexCoord = textureCoords[0];
-			s_DataR2D.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_DataR2D.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_DataR2D.QuadVertexBufferPtr++;
-		}
-
-		s_DataR2D.QuadIndexCount += 6;
-
-		s_DataR2D.Stats.QuadCount++;
+		DrawRotatedQuad(position, size, rotation, nullptr, 1.0f, color);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D> texture, float tilingFactor, const glm::vec4& tintColor)
@@ -408,67 +489,28 @@ namespace Hazel {
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D> texture, float tilingFactor, const glm::vec4& tintColor)
 	{
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-
-		float textureIndex = 0.0f;
-
-		if (s_DataR2D.QuadIndexCount >= Renderer2DData::MaxIndices)
-			NextBatch();
-
-		for (uint32_t i = 0; i < s_DataR2D.TextureSlotIndex; i++)
-		{
-			if (*s_DataR2D.TextureSlots[i] == *texture)
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			textureIndex = (float)s_DataR2D.TextureSlotIndex;
-			s_DataR2D.TextureSlots[textureIndex] = texture;
-			s_DataR2D.TextureSlotIndex++;
-		}
-
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-
-		for (size_t i = 0; i < quadVertexCount; i++)
-		{
-			s_DataR2D.QuadVertexBufferPtr->Position = transform * s_DataR2D.QuadVertexPositions[i];
-			s_DataR2D.QuadVertexBufferPtr->Color = tintColor;
-			s_DataR2D.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-			s_DataR2D.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_DataR2D.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_DataR2D.QuadVertexBufferPtr++;
-		}
-
-		s_DataR2D.QuadIndexCount += 6;
-
-		s_DataR2D.Stats.QuadCount++;
+		// Columns of translate * rotateZ * scale, without building the matrices
+		float c = std::cos(rotation);
+		float s = std::sin(rotation);
+		SubmitQuad({ c * size.x, s * size.x, 0.0f }, { -s * size.y, c * size.y, 0.0f }, position, texture, tilingFactor, tintColor,
+			{ 0.0f, 0.0f, 1.0f, 1.0f }, -1);
 	}
 
 	void Renderer2D::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int entityID)
 	{
-		// TODO: implement for circle
-		//if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-		//	NextBatch();
+		// Writing past the reserved batch would land in ring buffer space a pending draw may still read
+		if (s_DataR2D.CircleInstanceCount >= s_DataR2D.CircleInstanceCapacity)
+			NextBatch();
 
-		for (size_t i = 0; i < 4; i++)
-		{
-			s_DataR2D.CircleVertexBufferPtr->WorldPosition = transform * s_DataR2D.QuadVertexPositions[i];
-			s_DataR2D.CircleVertexBufferPtr->LocalPosition = s_DataR2D.QuadVertexPositions[i] * 2.0f;
-			s_DataR2D.CircleVertexBufferPtr->Color = color;
-			s_DataR2D.CircleVertexBufferPtr->Thickness = thickness;
-			s_DataR2D.CircleVertexBufferPtr->Fade = fade;
-			s_DataR2D.CircleVertexBufferPtr->EntityID = entityID;
-			s_DataR2D.CircleVertexBufferPtr++;
-		}
+		CircleInstance& instance = *s_DataR2D.CircleInstanceBufferPtr++;
+		instance.AxisX = transform[0];
+		instance.AxisY = transform[1];
+		instance.Translation = transform[3];
+		instance.Color = glm::packUnorm4x8(color);
+		instance.ThicknessFade = glm::packHalf2x16({ thickness, fade });
+		instance.EntityID = entityID;
 
-		s_DataR2D.CircleIndexCount += 6;
+		s_DataR2D.CircleInstanceCount++;
 
 		s_DataR2D.Stats.QuadCount++;
 	}
@@ -485,13 +527,17 @@ namespace Hazel {
 
 	void Renderer2D::DrawLines(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID)
 	{
+		if (s_DataR2D.LineVertexCount + 2 > s_DataR2D.LineVertexCapacity)
+			NextBatch();
+
+		uint32_t packedColor = glm::packUnorm4x8(color);
 		s_DataR2D.LineVertexBufferPtr->Position = p0;
-		s_DataR2D.LineVertexBufferPtr->Color = color;
+		s_DataR2D.LineVertexBufferPtr->Color = packedColor;
 		s_DataR2D.LineVertexBufferPtr->EntityID = entityID;
 		s_DataR2D.LineVertexBufferPtr++;
 
 		s_DataR2D.LineVertexBufferPtr->Position = p1;
-		s_DataR2D.LineVertexBufferPtr->Color = color;
+		s_DataR2D.LineVertexBufferPtr->Color = packedColor;
 		s_DataR2D.LineVertexBufferPtr->EntityID = entityID;
 		s_DataR2D.LineVertexBufferPtr++;
 
@@ -525,10 +571,11 @@ namespace Hazel {
 
 	void Renderer2D::DrawSprite(const glm::mat4& transform, SpriteRendererComponent& src, int entityID)
 	{
-		if (src.Texture)
-			DrawQuad(transform, src.Texture, src.TilingFactor, src.Color, entityID);
+		if (src.AtlasPage && src.TilingFactor == 1.0f)
+			SubmitQuad(transform[0], transform[1], transform[3], src.AtlasPage, 1.0f, src.Color, src.AtlasRect, entityID);
 		else
-			DrawQuad(transform, src.Color, entityID);
+			SubmitQuad(transform[0], transform[1], transform[3], src.Texture, src.Texture ? src.TilingFactor : 1.0f, src.Color,
+				{ 0.0f, 0.0f, 1.0f, 1.0f }, entityID);
 	}
 
 	void Renderer2D::ResetStats()
@@ -2,39 +2,206 @@
 
 #include "Hazel/Core/ResourceManager.h"
 #include "Hazel/Renderer/FrameBuffer.h"
+#include "Hazel/Renderer/PrimitiveCache.h"
 
 #include "Hazel/Renderer/VertexArray.h"
+#include "Hazel/Renderer/RingBuffer.h"
 #include "Hazel/Renderer/Shader.h"
+#include "Hazel/Renderer/UniformBuffer.h"
+#include "Hazel/Renderer/StorageBuffer.h"
 #include "Hazel/Renderer/RenderCommand.h"
+#include "Hazel/Renderer/RenderQueue.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <chrono>
 
 namespace Hazel {
 
-	struct SphereVertex
+	struct MeshInstance
 	{
-		glm::vec3 Position;
-		glm::vec3 Normal;
-		glm::vec2 TexCoord;
+		glm::mat4 ModelMatrix;
+		glm::mat3 NormalMatrix;
+		glm::vec4 Albedo; // Rgb, Opacity
+		glm::vec3 Material; // Metallic, Roughness, Ao
 
 		// Editor-only
 		int EntityID;
+
+		int MaterialIndex; // Into the material storage buffer
+	};
+
+	// Material maps are copied into texture arrays grouped by size and format, one layer per map
+	struct TextureArrayGroup
+	{
+		static const uint32_t InitialLayers = 4;
+
+		uint32_t Width = 0, Height = 0;
+		TextureFormat Format = TextureFormat::None;
+		Ref<Texture2DArray> Array;
+		// Source of every layer, kept to refill the array when it grows. Null for free layers.
+		std::vector<Ref<Texture2D>> Layers;
+		// Material maps sampling each layer, a layer is freed when its count drops to zero
+		std::vector<uint32_t> LayerRefs;
+		std::vector<uint32_t> FreeLayers;
+		// Layers were added since the mips were last generated
+		bool MipsDirty = false;
+	};
+
+	// The array group each map kind samples from. Instances whose maps live in the same groups can be drawn together.
+	struct SphereTextureSet
+	{
+		static const uint32_t MapCount = 5;
+
+		uint32_t Groups[MapCount] = {};
+
+		bool operator==(const SphereTextureSet& other) const
+		{
+			return std::equal(Groups, Groups + MapCount, other.Groups);
+		}
+	};
+
+	struct SphereMaterial
+	{
+		PbrMaterialTexture MaterialTexture;
+		bool UseTexture = false;
+		uint32_t TextureSet = 0;
+		uint32_t Layers[SphereTextureSet::MapCount] = {};
+	};
+
+	// std140 layouts of the uniform blocks in Renderer3D_Sphere.glsl / Renderer3D_Line.glsl
+	struct CameraData
+	{
+		glm::mat4 ViewProjection;
+		glm::vec4 Position;
+		glm::mat4 View;
+	};
+
+	struct LightData
+	{
+		glm::vec4 DirectionalLightDirection;
+		glm::vec4 DirectionalLightColor;
+		glm::uvec4 ClusterGrid; // Froxel counts in x, y, z
+		glm::vec4 ClusterDepth; // Near, far, slice = log(depth) * z + w
+	};
+
+	struct EnvironmentData
+	{
+		glm::vec4 IrradianceSH[SphericalHarmonics::CoefficientCount]; // rgb, w unused
+		int UseIrradianceSH;
+		int Padding[3];
+	};
+
+	// std430 layouts of the light storage blocks in Renderer3D_Sphere.glsl
+	struct PointLightData
+	{
+		glm::vec4 PositionRange; // World position, range
+		glm::vec4 Color;
+	};
+
+	struct LightCluster
+	{
+		uint32_t Offset; // Into the light index list
+		uint32_t Count;
+	};
+
+	// Froxels a point light touches, inclusive
+	struct LightClusterBounds
+	{
+		glm::uvec3 Min;
+		glm::uvec3 Max;
+	};
+
+	// std430 layout of the material storage block in Renderer3D_Sphere.glsl
+	struct MaterialData
+	{
+		int UseTexture;
+		int Layers[SphereTextureSet::MapCount]; // Albedo, Normal, Metallic, Roughness, Ao
+		int Padding[2];
 	};
 
 	struct LineVertex
 	{
 		glm::vec3 Position;
-		glm::vec4 Color;
+		uint32_t Color; // RGBA8
 
 		// Editor-only
 		int EntityID;
 	};
 
+	// An instance recorded off the render thread whose material or geometry is used for the first time.
+	// Creating those touches GPU resources, so they are resolved when the lists are merged.
+	struct DeferredInstance
+	{
+		uint32_t Instance; // Into the list's instances
+		const PbrMaterialTexture* MaterialTexture; // Null if the material is known
+		const Ref<Mesh>* Mesh; // Null if the geometry is known
+		uint32_t Geometry;
+		float Opacity;
+		float Depth;
+	};
+
+	// Written by one thread only, aligned so neighbouring lists don't share a cache line
+	struct alignas(64) CommandList
+	{
+		std::vector<MeshInstance> Instances;
+		std::vector<DrawPacket> Packets; // Index is into Instances
+		std::vector<DeferredInstance> Deferred;
+		std::vector<std::pair<int, uint32_t>> SphereLods; // Entity, LOD chosen
+		uint32_t SphereCount = 0;
+		uint32_t MeshCount = 0;
+		uint32_t Triangles = 0;
+		float RecordTime = 0.0f; // ms
+	};
+
+	// Everything instanced through the sphere shader: the sphere LODs first, then every mesh drawn so far
+	struct Geometry
+	{
+		Ref<Mesh> Mesh; // Null for the built-in spheres
+		Ref<VertexArray> VertexArray;
+		Ref<VertexBuffer> VertexBuffer;
+		Ref<IndexBuffer> IndexBuffer;
+		uint32_t IndexCount = 0;
+		uint32_t VertexCount = 0;
+	};
+
+	// Sphere LODs chosen in the last scene drawn from one camera, by entity, so hysteresis compares against what
+	// that camera showed. Read while recording, rebuilt from the scene's choices in EndScene.
+	struct SphereLodHistory
+	{
+		std::unordered_map<int, uint32_t> Lods;
+		uint32_t LastScene = 0;
+	};
+
 	struct Renderer3DData
 	{
+		// Initial capacities, the buffers grow past these when a batch needs more
 		static const uint32_t MaxVertices = 100000;
-		static const uint32_t MaxIndices = 100000;
+		static const uint32_t MaxInstances = 10000;
+		static const uint32_t MaxMaterials = 64;
+		static const uint32_t MaxPointLights = 1024;
+		static const uint32_t MaxLightIndices = 16384;
+		static const uint32_t SphereShaderID = 0;
+		// Size of a line vertex with a float color, for the stats
+		static const uint32_t UnpackedLineVertexSize = 32;
+		// Geometry ids share the 10-bit mesh field of the sort key
+		static const uint32_t MaxGeometries = 1024;
+
+		// Light grid: screen tiles in x and y, exponential view depth slices in z
+		static const uint32_t ClusterGridX = 16;
+		static const uint32_t ClusterGridY = 9;
+		static const uint32_t ClusterGridZ = 24;
+		static const uint32_t ClusterCount = ClusterGridX * ClusterGridY * ClusterGridZ;
+
+		// LOD n is used while the projected radius, as a fraction of half the viewport height, is at least SphereLodCoverage[n]
+		static const uint32_t SphereLodCount = PrimitiveCache::SphereLodCount;
+		static constexpr float SphereLodCoverage[SphereLodCount - 1] = { 0.3f, 0.12f, 0.03f };
+		// How far past a threshold a sphere has to move before it switches LOD
+		static constexpr float SphereLodHysteresis = 0.1f;
+		// Scenes a camera can go undrawn before its LOD history is dropped
+		static const uint32_t SphereLodHistoryLifetime = 120;
 
 		glm::mat4 ViewProjection;
 		glm::mat4 ViewMatrix;
@@ -43,33 +210,365 @@ namespace Hazel {
 		// IBL
 		Ref<Shader> IBL_BackgroundShader;
 
-		// Sphere
+		// Sphere and mesh
 		Ref<Shader> SphereShader;
-		Ref<VertexArray> SphereVertexArray;
-		Ref<VertexBuffer> SphereVertexBuffer;
-		Ref<IndexBuffer> SphereIndexBuffer;
-		uint32_t SphereIndexCount = 0;
-		SphereVertex* SphereVertexBufferBase = nullptr;
-		SphereVertex* SphereVertexBufferPtr = nullptr;
-		uint32_t* SphereIndexBufferBase = nullptr;
-		uint32_t* SphereIndexBufferPtr = nullptr;
+		std::vector<Geometry> Geometries;
+		std::unordered_map<const Mesh*, uint32_t> MeshGeometries;
+		float SphereLodBias = 0.0f;
+		std::unordered_map<const Camera*, SphereLodHistory> SphereLodHistories;
+		SphereLodHistory* CurrentLodHistory = nullptr;
+		std::vector<std::pair<int, uint32_t>> SphereLods; // Chosen this scene
+		uint32_t SceneCount = 0;
+
+		// Sorted instances are written straight into the mapped ring, draws start at its base instance
+		Ref<RingBuffer> InstanceBuffer;
+		uint32_t InstanceCount = 0;
+		uint32_t InstanceCapacity = 0;
+		// Material 0 and texture set 0 are untextured, the rest one material per map set
+		std::vector<SphereMaterial> SphereMaterials;
+		std::vector<uint32_t> FreeSphereMaterials;
+		std::vector<SphereTextureSet> SphereTextureSets;
+		std::vector<TextureArrayGroup> TextureArrays;
+		// Scratch for ReleaseUnusedMaterials
+		std::unordered_map<const Texture2D*, long> HeldMaps;
+
+		// Instances in submission order, the queue decides the order they are uploaded and drawn in
+		std::vector<MeshInstance> Instances;
+		RenderQueue Queue;
+
+		// One per recording thread, merged into Instances and Queue by SubmitRecorded
+		std::vector<CommandList> CommandLists;
+		uint32_t CommandListCount = 0;
+
+		// Uniform buffers
+		Ref<UniformBuffer> CameraUniformBuffer;
+		Ref<UniformBuffer> LightUniformBuffer;
+		Ref<UniformBuffer> EnvironmentUniformBuffer;
+		Ref<StorageBuffer> MaterialBuffer;
+
+		// Only re-uploaded when the coefficients or the toggle change
+		EnvironmentData Environment = {};
+		bool EnvironmentDirty = true;
+		uint32_t EnvironmentVersion = 0;
+
+		// Clustered lights, rebuilt on the CPU every scene
+		Ref<StorageBuffer> PointLightBuffer;
+		Ref<StorageBuffer> LightClusterBuffer;
+		Ref<StorageBuffer> LightIndexBuffer;
+		std::vector<PointLightData> PointLights;
+		std::vector<LightClusterBounds> PointLightClusters;
+		std::vector<LightCluster> LightClusters;
+		std::vector<uint32_t> LightIndices;
 
 		// Line
 		Ref<Shader> LineShader;
 		Ref<VertexArray> LineVertexArray;
-		Ref<VertexBuffer> LineVertexBuffer;
+		Ref<RingBuffer> LineVertexBuffer;
 		uint32_t LineVertexCount = 0;
 		LineVertex* LineVertexBufferBase = nullptr;
 		LineVertex* LineVertexBufferPtr = nullptr;
+		uint32_t LineVertexCapacity = 0;
 		float LineWidth = 2.0f;
 
-		PbrMaterialTexture PbrTex;
-
 		Renderer3D::Statistics Stats;
 	};
 
 	static Renderer3DData s_DataR3D;
 
+	static uint32_t GrowCapacity(uint32_t capacity, uint32_t required)
+	{
+		while (capacity < required)
+			capacity *= 2;
+		return capacity;
+	}
+
+	static void BuildGeometryVertexArray(Geometry& geometry)
+	{
+		geometry.VertexArray = VertexArray::Create();
+		geometry.VertexArray->AddVertexBuffer(geometry.VertexBuffer);
+		geometry.VertexArray->AddInstanceBuffer(s_DataR3D.InstanceBuffer);
+		geometry.VertexArray->SetIndexBuffer(geometry.IndexBuffer);
+	}
+
+	static void ResizeInstanceBuffer(uint32_t capacity)
+	{
+		s_DataR3D.InstanceCapacity = capacity;
+
+		s_DataR3D.InstanceBuffer = RingBuffer::Create(capacity * sizeof(MeshInstance));
+		s_DataR3D.InstanceBuffer->SetLayout({
+			{ ShaderDataType::Mat4,   "a_ModelMatrix"	},
+			{ ShaderDataType::Mat3,   "a_NormalMatrix"	},
+			{ ShaderDataType::Float4, "a_Albedo"		},
+			{ ShaderDataType::Float3, "a_Material"		},
+			{ ShaderDataType::Int,	  "a_EntityID"		},
+			{ ShaderDataType::Int,	  "a_MaterialIndex"	},
+		});
+
+		// Attribute bindings point at the old buffer, so the VAOs are rebuilt around the new one
+		for (Geometry& geometry : s_DataR3D.Geometries)
+			BuildGeometryVertexArray(geometry);
+
+		s_DataR3D.Stats.BuffersAllocated++;
+	}
+
+	static const uint32_t InvalidIndex = 0xFFFFFFFF;
+
+	// Read-only, safe to call while recording in parallel. Returns InvalidIndex if the mesh hasn't been drawn yet.
+	static uint32_t FindMeshGeometry(const Mesh* mesh)
+	{
+		auto it = s_DataR3D.MeshGeometries.find(mesh);
+		return it != s_DataR3D.MeshGeometries.end() ? it->second : InvalidIndex;
+	}
+
+	// Returns the geometry id of a mesh, its vertex array is created the first time the mesh is drawn
+	static uint32_t GetMeshGeometry(const Ref<Mesh>& mesh)
+	{
+		if (uint32_t id = FindMeshGeometry(mesh.get()); id != InvalidIndex)
+			return id;
+
+		HZ_CORE_ASSERT(s_DataR3D.Geometries.size() < Renderer3DData::MaxGeometries, "Too many meshes!");
+		uint32_t id = (uint32_t)s_DataR3D.Geometries.size();
+		Geometry& geometry = s_DataR3D.Geometries.emplace_back();
+		geometry.Mesh = mesh;
+		geometry.VertexBuffer = mesh->GetVertexBuffer();
+		geometry.IndexBuffer = mesh->GetIndexBuffer();
+		geometry.IndexCount = (uint32_t)mesh->GetIndices().size();
+		geometry.VertexCount = (uint32_t)mesh->GetVertices().size();
+		BuildGeometryVertexArray(geometry);
+
+		s_DataR3D.MeshGeometries[mesh.get()] = id;
+		return id;
+	}
+
+	static void ResizeLineVertexBuffer(uint32_t capacity)
+	{
+		LineVertex* base = new LineVertex[capacity];
+		if (s_DataR3D.LineVertexBufferBase)
+		{
+			std::copy(s_DataR3D.LineVertexBufferBase, s_DataR3D.LineVertexBufferPtr, base);
+			delete[] s_DataR3D.LineVertexBufferBase;
+		}
+		s_DataR3D.LineVertexBufferBase = base;
+		s_DataR3D.LineVertexBufferPtr = base + s_DataR3D.LineVertexCount;
+		s_DataR3D.LineVertexCapacity = capacity;
+
+		s_DataR3D.LineVertexBuffer = RingBuffer::Create(capacity * sizeof(LineVertex));
+		s_DataR3D.LineVertexBuffer->SetLayout({
+			{ ShaderDataType::Float3, "a_Position"	},
+			{ ShaderDataType::UByte4Norm, "a_Color"	},
+			{ ShaderDataType::Int,	  "a_EntityID"	},
+		});
+
+		s_DataR3D.LineVertexArray = VertexArray::Create();
+		s_DataR3D.LineVertexArray->AddVertexBuffer(s_DataR3D.LineVertexBuffer);
+
+		s_DataR3D.Stats.BuffersAllocated++;
+	}
+
+	// Materials live in one storage buffer and are written only when the material is created
+	static void WriteMaterial(uint32_t index)
+	{
+		const SphereMaterial& sphereMaterial = s_DataR3D.SphereMaterials[index];
+
+		uint32_t requiredSize = (uint32_t)(s_DataR3D.SphereMaterials.size() * sizeof(MaterialData));
+		if (requiredSize > s_DataR3D.MaterialBuffer->GetSize())
+		{
+			s_DataR3D.MaterialBuffer->Resize(GrowCapacity(s_DataR3D.MaterialBuffer->GetSize(), requiredSize));
+			s_DataR3D.Stats.BuffersAllocated++;
+
+			for (uint32_t i = 0; i < index; i++)
+				WriteMaterial(i);
+		}
+
+		MaterialData material = {};
+		material.UseTexture = sphereMaterial.UseTexture ? 1 : 0;
+		for (uint32_t map = 0; map < SphereTextureSet::MapCount; map++)
+			material.Layers[map] = (int)sphereMaterial.Layers[map];
+		s_DataR3D.MaterialBuffer->SetData(&material, sizeof(MaterialData), index * sizeof(MaterialData));
+		s_DataR3D.Stats.BytesUploaded += sizeof(MaterialData);
+	}
+
+	// Finds or adds the array group matching the texture and returns (group, layer)
+	static std::pair<uint32_t, uint32_t> AddToTextureArray(const Ref<Texture2D>& texture)
+	{
+		auto& groups = s_DataR3D.TextureArrays;
+		uint32_t groupIndex = 0;
+		for (; groupIndex < groups.size(); groupIndex++)
+		{
+			const TextureArrayGroup& group = groups[groupIndex];
+			if (group.Width == texture->GetWidth() && group.Height == texture->GetHeight() && group.Format == texture->GetFormat())
+				break;
+		}
+
+		if (groupIndex == groups.size())
+		{
+			TextureArrayGroup& group = groups.emplace_back();
+			group.Width = texture->GetWidth();
+			group.Height = texture->GetHeight();
+			group.Format = texture->GetFormat();
+		}
+
+		TextureArrayGroup& group = groups[groupIndex];
+		for (uint32_t layer = 0; layer < group.Layers.size(); layer++)
+		{
+			if (group.Layers[layer] == texture)
+			{
+				group.LayerRefs[layer]++;
+				return { groupIndex, layer };
+			}
+		}
+
+		uint32_t layer;
+		if (!group.FreeLayers.empty())
+		{
+			layer = group.FreeLayers.back();
+			group.FreeLayers.pop_back();
+			group.Layers[layer] = texture;
+			group.LayerRefs[layer] = 1;
+		}
+		else
+		{
+			layer = (uint32_t)group.Layers.size();
+			group.Layers.push_back(texture);
+			group.LayerRefs.push_back(1);
+		}
+
+		if (!group.Array || group.Layers.size() > group.Array->GetLayerCount())
+		{
+			uint32_t capacity = group.Array ? GrowCapacity(group.Array->GetLayerCount(), (uint32_t)group.Layers.size()) : TextureArrayGroup::InitialLayers;
+			group.Array = Texture2DArray::Create(group.Width, group.Height, capacity, group.Format);
+			for (uint32_t i = 0; i < layer; i++)
+			{
+				if (group.Layers[i])
+					group.Array->CopyLayer(group.Layers[i], i);
+			}
+			s_DataR3D.Stats.BuffersAllocated++;
+		}
+
+		group.Array->CopyLayer(texture, layer);
+		group.MipsDirty = true;
+		return { groupIndex, layer };
+	}
+
+	static void ReleaseTextureArrayLayer(uint32_t groupIndex, uint32_t layer)
+	{
+		TextureArrayGroup& group = s_DataR3D.TextureArrays[groupIndex];
+		if (--group.LayerRefs[layer] == 0)
+		{
+			group.Layers[layer] = nullptr;
+			group.FreeLayers.push_back(layer);
+		}
+	}
+
+	static std::array<const Ref<Texture2D>*, SphereTextureSet::MapCount> GetMaterialMaps(const PbrMaterialTexture& materialTexture)
+	{
+		return { &materialTexture.AlbedoMap, &materialTexture.NormalMap, &materialTexture.MetallicMap,
+			&materialTexture.RoughnessMap, &materialTexture.AoMap };
+	}
+
+	// Read-only, safe to call while recording in parallel. Returns InvalidIndex if the material doesn't exist yet.
+	static uint32_t FindSphereMaterial(const PbrMaterialTexture& materialTexture)
+	{
+		const auto& materials = s_DataR3D.SphereMaterials;
+		for (size_t i = 1; i < materials.size(); i++)
+		{
+			const PbrMaterialTexture& other = materials[i].MaterialTexture;
+			if (other.AlbedoMap == materialTexture.AlbedoMap && other.NormalMap == materialTexture.NormalMap
+				&& other.MetallicMap == materialTexture.MetallicMap && other.RoughnessMap == materialTexture.RoughnessMap
+				&& other.AoMap == materialTexture.AoMap)
+				return (uint32_t)i;
+		}
+		return InvalidIndex;
+	}
+
+	static uint32_t GetSphereMaterial(const PbrMaterialTexture& materialTexture)
+	{
+		if (uint32_t index = FindSphereMaterial(materialTexture); index != InvalidIndex)
+			return index;
+
+		auto& materials = s_DataR3D.SphereMaterials;
+		uint32_t index;
+		if (!s_DataR3D.FreeSphereMaterials.empty())
+		{
+			index = s_DataR3D.FreeSphereMaterials.back();
+			s_DataR3D.FreeSphereMaterials.pop_back();
+		}
+		else
+		{
+			index = (uint32_t)materials.size();
+			materials.emplace_back();
+		}
+
+		SphereMaterial& material = materials[index];
+		material.MaterialTexture = materialTexture;
+		material.UseTexture = true;
+
+		auto maps = GetMaterialMaps(material.MaterialTexture);
+		SphereTextureSet textureSet;
+		for (uint32_t map = 0; map < SphereTextureSet::MapCount; map++)
+		{
+			auto [group, layer] = AddToTextureArray(*maps[map]);
+			textureSet.Groups[map] = group;
+			material.Layers[map] = layer;
+		}
+
+		auto& textureSets = s_DataR3D.SphereTextureSets;
+		auto it = std::find(textureSets.begin() + 1, textureSets.end(), textureSet);
+		material.TextureSet = (uint32_t)(it - textureSets.begin());
+		if (it == textureSets.end())
+			textureSets.push_back(textureSet);
+
+		WriteMaterial(index);
+		return index;
+	}
+
+	// A material is unused once one of its maps is held by nothing but the renderer, no component can ask for it
+	// again. Its slot and the array layers no other material samples are freed for reuse.
+	static void ReleaseUnusedMaterials()
+	{
+		auto& materials = s_DataR3D.SphereMaterials;
+		auto& held = s_DataR3D.HeldMaps;
+		held.clear();
+		for (const SphereMaterial& material : materials)
+		{
+			if (material.UseTexture)
+			{
+				for (const Ref<Texture2D>* map : GetMaterialMaps(material.MaterialTexture))
+					held[map->get()]++;
+			}
+		}
+		for (const TextureArrayGroup& group : s_DataR3D.TextureArrays)
+		{
+			for (const Ref<Texture2D>& layer : group.Layers)
+			{
+				if (layer)
+					held[layer.get()]++;
+			}
+		}
+
+		for (uint32_t index = 1; index < materials.size(); index++)
+		{
+			SphereMaterial& material = materials[index];
+			if (!material.UseTexture)
+				continue;
+
+			auto maps = GetMaterialMaps(material.MaterialTexture);
+			bool unused = std::any_of(maps.begin(), maps.end(), [&](const Ref<Texture2D>* map)
+			{
+				return map->use_count() <= held[map->get()];
+			});
+			if (!unused)
+				continue;
+
+			const SphereTextureSet& textureSet = s_DataR3D.SphereTextureSets[material.TextureSet];
+			for (uint32_t map = 0; map < SphereTextureSet::MapCount; map++)
+				ReleaseTextureArrayLayer(textureSet.Groups[map], material.Layers[map]);
+
+			material = SphereMaterial();
+			s_DataR3D.FreeSphereMaterials.push_back(index);
+		}
+	}
+
 	void Renderer3D::Init()
 	{
 		// IBL
@@ -77,8 +576,39 @@ namespace Hazel {
 
 		// Sphere
 		s_DataR3D.SphereShader = Shader::Create("../../assets/shaders/Renderer3D_Sphere.glsl");
-		s_DataR3D.SphereVertexBufferBase = new SphereVertex[s_DataR3D.MaxVertices];
-		s_DataR3D.SphereIndexBufferBase = new uint32_t[s_DataR3D.MaxIndices];
+
+		// The sphere meshes are shared with the primitive cache and take geometry ids 0 to SphereLodCount - 1,
+		// only instance data is streamed per frame
+		for (uint32_t i = 0; i < s_DataR3D.SphereLodCount; i++)
+		{
+			const Primitive& sphere = PrimitiveCache::Get(PrimitiveCache::GetSphereLod(i));
+			Geometry& lod = s_DataR3D.Geometries.emplace_back();
+			lod.VertexBuffer = sphere.VertexBuffer;
+			lod.IndexBuffer = sphere.IndexBuffer;
+			lod.IndexCount = sphere.Count;
+			lod.VertexCount = sphere.VertexCount;
+		}
+
+		ResizeInstanceBuffer(s_DataR3D.MaxInstances);
+
+		// Uniform buffers
+		s_DataR3D.CameraUniformBuffer = UniformBuffer::Create(sizeof(CameraData), 0);
+		s_DataR3D.LightUniformBuffer = UniformBuffer::Create(sizeof(LightData), 1);
+		s_DataR3D.EnvironmentUniformBuffer = UniformBuffer::Create(sizeof(EnvironmentData), 2);
+		s_DataR3D.Environment.UseIrradianceSH = 1;
+		SetIrradianceSH(ResourceManager::Get()->GetIrradianceSH());
+		s_DataR3D.EnvironmentVersion = ResourceManager::Get()->GetEnvironmentVersion();
+
+		// Storage buffers
+		s_DataR3D.PointLightBuffer = StorageBuffer::Create(s_DataR3D.MaxPointLights * sizeof(PointLightData), 0);
+		s_DataR3D.LightClusterBuffer = StorageBuffer::Create(s_DataR3D.ClusterCount * sizeof(LightCluster), 1);
+		s_DataR3D.LightIndexBuffer = StorageBuffer::Create(s_DataR3D.MaxLightIndices * sizeof(uint32_t), 2);
+		s_DataR3D.LightClusters.resize(s_DataR3D.ClusterCount);
+
+		s_DataR3D.MaterialBuffer = StorageBuffer::Create(s_DataR3D.MaxMaterials * sizeof(MaterialData), 3);
+		s_DataR3D.SphereMaterials.emplace_back();
+		s_DataR3D.SphereTextureSets.emplace_back();
+		WriteMaterial(0);
 
 		s_DataR3D.SphereShader->Bind();
 
@@ -86,50 +616,226 @@ namespace Hazel {
 		s_DataR3D.SphereShader->SetInt("prefilterMap", 1);
 		s_DataR3D.SphereShader->SetInt("brdfLUT", 2);
 
-		s_DataR3D.SphereShader->SetInt("u_AlbedoMap", 3);
-		s_DataR3D.SphereShader->SetInt("u_NormalMap", 4);
-		s_DataR3D.SphereShader->SetInt("u_MetallicMap", 5);
-		s_DataR3D.SphereShader->SetInt("u_RoughnessMap", 6);
-		s_DataR3D.SphereShader->SetInt("u_AoMap", 7);
+		s_DataR3D.SphereShader->SetInt("u_AlbedoMaps", 3);
+		s_DataR3D.SphereShader->SetInt("u_NormalMaps", 4);
+		s_DataR3D.SphereShader->SetInt("u_MetallicMaps", 5);
+		s_DataR3D.SphereShader->SetInt("u_RoughnessMaps", 6);
+		s_DataR3D.SphereShader->SetInt("u_AoMaps", 7);
 
 		// Lines
 		s_DataR3D.LineShader = Shader::Create("../../assets/shaders/Renderer3D_Line.glsl");
-		s_DataR3D.LineVertexBufferBase = new LineVertex[s_DataR3D.MaxVertices];
+		ResizeLineVertexBuffer(s_DataR3D.MaxVertices);
+	}
+
+	// Grows a storage buffer so it holds at least size bytes
+	static void ReserveStorage(const Ref<StorageBuffer>& buffer, uint32_t size)
+	{
+		if (size <= buffer->GetSize())
+			return;
+
+		buffer->Resize(GrowCapacity(buffer->GetSize(), size));
+		s_DataR3D.Stats.BuffersAllocated++;
+	}
+
+	// Assigns every point light to the view-space froxels its range sphere overlaps and uploads the per-froxel light lists
+	static void BuildLightClusters(const LightParams& lightParams, LightData& lights)
+	{
+		const glm::mat4& view = s_DataR3D.ViewMatrix;
+		const glm::mat4& projection = s_DataR3D.ProjectionMatrix;
+
+		// Clip planes recovered from the projection, perspective when the w row is (0, 0, -1, 0)
+		float nearClip, farClip;
+		if (projection[3][3] == 0.0f)
+		{
+			nearClip = projection[3][2] / (projection[2][2] - 1.0f);
+			farClip = projection[3][2] / (projection[2][2] + 1.0f);
+		}
+		else
+		{
+			nearClip = (projection[3][2] + 1.0f) / projection[2][2];
+			farClip = (projection[3][2] - 1.0f) / projection[2][2];
+		}
+
+		// Slices are exponential in depth, everything in front of sliceNear collapses into slice 0
+		const glm::uvec3 grid = { Renderer3DData::ClusterGridX, Renderer3DData::ClusterGridY, Renderer3DData::ClusterGridZ };
+		float sliceNear = std::max(nearClip, 0.01f);
+		float sliceScale = (float)grid.z / std::log(std::max(farClip, sliceNear * 2.0f) / sliceNear);
+		float sliceBias = -std::log(sliceNear) * sliceScale;
+		auto depthToSlice = [&](float depth)
+		{
+			float slice = std::log(std::max(depth, sliceNear)) * sliceScale + sliceBias;
+			return (uint32_t)glm::clamp(slice, 0.0f, (float)(grid.z - 1));
+		};
+		auto ndcToTile = [](float ndc, uint32_t tiles)
+		{
+			return (uint32_t)glm::clamp((ndc * 0.5f + 0.5f) * (float)tiles, 0.0f, (float)(tiles - 1));
+		};
+
+		auto& pointLights = s_DataR3D.PointLights;
+		auto& lightBounds = s_DataR3D.PointLightClusters;
+		auto& clusters = s_DataR3D.LightClusters;
+		auto& indices = s_DataR3D.LightIndices;
+		pointLights.clear();
+		lightBounds.clear();
+		indices.clear();
+		for (LightCluster& cluster : clusters)
+			cluster = { 0, 0 };
+
+		for (size_t i = 0; i < lightParams.PointLightPositions.size(); i++)
+		{
+			float range = lightParams.PointLightRanges[i];
+			glm::vec3 center = view * glm::vec4(lightParams.PointLightPositions[i], 1.0f);
+			float minDepth = -center.z - range;
+			float maxDepth = -center.z + range;
+			if (range <= 0.0f || maxDepth < nearClip || minDepth > farClip)
+				continue;
+
+			// The screen footprint of the sphere's view-space box, clamped to the depth range, is bounded by its corners
+			minDepth = std::max(minDepth, nearClip);
+			maxDepth = std::min(maxDepth, farClip);
+			glm::vec2 ndcMin(std::numeric_limits<float>::max()), ndcMax(std::numeric_limits<float>::lowest());
+			for (uint32_t corner = 0; corner < 8; corner++)
+			{
+				glm::vec4 p = {
+					center.x + ((corner & 1) ? range : -range),
+					center.y + ((corner & 2) ? range : -range),
+					(corner & 4) ? -maxDepth : -minDepth,
+					1.0f
+				};
+				glm::vec4 clip = projection * p;
+				glm::vec2 ndc = glm::vec2(clip) / clip.w;
+				ndcMin = glm::min(ndcMin, ndc);
+				ndcMax = glm::max(ndcMax, ndc);
+			}
+			if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f)
+				continue;
+
+			LightClusterBounds& bounds = lightBounds.emplace_back();
+			bounds.Min = { ndcToTile(ndcMin.x, grid.x), ndcToTile(ndcMin.y, grid.y), depthToSlice(minDepth) };
+			bounds.Max = { ndcToTile(ndcMax.x, grid.x), ndcToTile(ndcMax.y, grid.y), depthToSlice(maxDepth) };
+
+			PointLightData& light = pointLights.emplace_back();
+			light.PositionRange = glm::vec4(lightParams.PointLightPositions[i], range);
+			light.Color = glm::vec4(lightParams.PointLightColors[i], 1.0f);
+		}
+
+		// Count, prefix sum, then scatter, so every froxel's list is contiguous
+		auto forEachCluster = [&](const LightClusterBounds& bounds, auto&& func)
+		{
+			for (uint32_t z = bounds.Min.z; z <= bounds.Max.z; z++)
+				for (uint32_t y = bounds.Min.y; y <= bounds.Max.y; y++)
+					for (uint32_t x = bounds.Min.x; x <= bounds.Max.x; x++)
+						func(clusters[x + grid.x * (y + grid.y * z)]);
+		};
+
+		for (const LightClusterBounds& bounds : lightBounds)
+			forEachCluster(bounds, [](LightCluster& cluster) { cluster.Count++; });
+
+		uint32_t indexCount = 0;
+		for (LightCluster& cluster : clusters)
+		{
+			cluster.Offset = indexCount;
+			indexCount += cluster.Count;
+			cluster.Count = 0;
+		}
+
+		indices.resize(indexCount);
+		for (uint32_t light = 0; light < (uint32_t)lightBounds.size(); light++)
+			forEachCluster(lightBounds[light], [&](LightCluster& cluster) { indices[cluster.Offset + cluster.Count++] = light; });
+
+		uint32_t lightDataSize = (uint32_t)(pointLights.size() * sizeof(PointLightData));
+		uint32_t clusterDataSize = (uint32_t)(clusters.size() * sizeof(LightCluster));
+		uint32_t indexDataSize = indexCount * sizeof(uint32_t);
+		ReserveStorage(s_DataR3D.PointLightBuffer, lightDataSize);
+		ReserveStorage(s_DataR3D.LightIndexBuffer, indexDataSize);
+		if (lightDataSize)
+			s_DataR3D.PointLightBuffer->SetData(pointLights.data(), lightDataSize);
+		if (indexDataSize)
+			s_DataR3D.LightIndexBuffer->SetData(indices.data(), indexDataSize);
+		s_DataR3D.LightClusterBuffer->SetData(clusters.data(), clusterDataSize);
+
+		lights.ClusterGrid = glm::uvec4(grid, 0);
+		lights.ClusterDepth = { nearClip, farClip, sliceScale, sliceBias };
+
+		s_DataR3D.Stats.PointLights += (uint32_t)pointLights.size();
+		s_DataR3D.Stats.LightIndices += indexCount;
+		s_DataR3D.Stats.BytesUploaded += lightDataSize + clusterDataSize + indexDataSize;
+	}
+
+	static void UploadSceneData(const glm::mat4& viewProjection, const glm::vec3& cameraPosition, const LightParams& lightParams)
+	{
+		CameraData camera;
+		camera.ViewProjection = viewProjection;
+		camera.Position = glm::vec4(cameraPosition, 1.0f);
+		camera.View = s_DataR3D.ViewMatrix;
+		s_DataR3D.CameraUniformBuffer->SetData(&camera, sizeof(CameraData));
+
+		LightData lights = {};
+		lights.DirectionalLightDirection = glm::vec4(lightParams.DirectionalLightDirection, 0.0f);
+		lights.DirectionalLightColor = glm::vec4(lightParams.DirectionalLightColor, 1.0f);
+		BuildLightClusters(lightParams, lights);
+		s_DataR3D.LightUniformBuffer->SetData(&lights, sizeof(LightData));
+
+		s_DataR3D.Stats.BytesUploaded += sizeof(CameraData) + sizeof(LightData);
+
+		// Picks up the coefficients of a newly baked environment
+		uint32_t environmentVersion = ResourceManager::Get()->GetEnvironmentVersion();
+		if (environmentVersion != s_DataR3D.EnvironmentVersion)
+		{
+			Renderer3D::SetIrradianceSH(ResourceManager::Get()->GetIrradianceSH());
+			s_DataR3D.EnvironmentVersion = environmentVersion;
+		}
+
+		if (s_DataR3D.EnvironmentDirty)
+		{
+			s_DataR3D.EnvironmentUniformBuffer->SetData(&s_DataR3D.Environment, sizeof(EnvironmentData));
+			s_DataR3D.EnvironmentDirty = false;
+			s_DataR3D.Stats.BytesUploaded += sizeof(EnvironmentData);
+		}
 	}
 
-	void Renderer3D::BeginScene(const Camera& camera, const glm::mat4& transform)
+	static void BeginSphereLodHistory(const Camera* camera)
+	{
+		uint32_t scene = ++s_DataR3D.SceneCount;
+		for (auto it = s_DataR3D.SphereLodHistories.begin(); it != s_DataR3D.SphereLodHistories.end();)
+		{
+			if (it->first != camera && scene - it->second.LastScene > Renderer3DData::SphereLodHistoryLifetime)
+				it = s_DataR3D.SphereLodHistories.erase(it);
+			else
+				++it;
+		}
+
+		s_DataR3D.CurrentLodHistory = &s_DataR3D.SphereLodHistories[camera];
+		s_DataR3D.CurrentLodHistory->LastScene = scene;
+		s_DataR3D.SphereLods.clear();
+	}
+
+	void Renderer3D::BeginScene(const Camera& camera, const glm::mat4& transform, const LightParams& lightParams)
 	{
 		glm::mat4 viewProj = camera.GetProjection() * glm::inverse(transform);
 
-		s_DataR3D.SphereShader->Bind();
-		s_DataR3D.SphereShader->SetMat4("u_ViewProjection", viewProj);
+		s_DataR3D.ViewMatrix = glm::inverse(transform);
+		s_DataR3D.ProjectionMatrix = camera.GetProjection();
+		s_DataR3D.ViewProjection = viewProj;
 
-		s_DataR3D.LineShader->Bind();
-		s_DataR3D.LineShader->SetMat4("u_ViewProjection", viewProj);
+		UploadSceneData(viewProj, glm::vec3(transform[3]), lightParams);
+		BeginSphereLodHistory(&camera);
 
 		StartBatch();
 	}
 
-	void Renderer3D::BeginScene(const EditorCamera& camera)
+	void Renderer3D::BeginScene(const EditorCamera& camera, const LightParams& lightParams)
 	{
 		RenderCommand::DisableDepthTest();
 		DrawIBLBackground(camera);
 		RenderCommand::EnableDepthTest();
 
-		glm::mat4 viewProj = camera.GetViewProjection();
-		glm::vec3 camPos = camera.GetPosition();
-
 		s_DataR3D.ViewMatrix = camera.GetViewMatrix();
 		s_DataR3D.ProjectionMatrix = camera.GetProjection();
 		s_DataR3D.ViewProjection = camera.GetViewProjection();
 
-		s_DataR3D.SphereShader->Bind();
-		s_DataR3D.SphereShader->SetMat4("u_ViewProjection", viewProj);
-		s_DataR3D.SphereShader->SetFloat3("u_CamPos", camPos);
-
-		s_DataR3D.LineShader->Bind();
-		s_DataR3D.LineShader->SetMat4("u_ViewProjection", viewProj);
-		s_DataR3D.LineShader->SetFloat3("u_CamPos", camPos);
+		UploadSceneData(camera.GetViewProjection(), camera.GetPosition(), lightParams);
+		BeginSphereLodHistory(&camera);
 
 		StartBatch();
 	}
@@ -137,13 +843,19 @@ namespace Hazel {
 	void Renderer3D::EndScene()
 	{
 		Flush();
+		ReleaseUnusedMaterials();
+
+		SphereLodHistory& history = *s_DataR3D.CurrentLodHistory;
+		history.Lods.clear();
+		history.Lods.insert(s_DataR3D.SphereLods.begin(), s_DataR3D.SphereLods.end());
+		s_DataR3D.SphereLods.clear();
 	}
 
 	void Renderer3D::StartBatch()
 	{
-		s_DataR3D.SphereIndexCount = 0;
-		s_DataR3D.SphereVertexBufferPtr = s_DataR3D.SphereVertexBufferBase;
-		s_DataR3D.SphereIndexBufferPtr = s_DataR3D.SphereIndexBufferBase;
+		s_DataR3D.InstanceCount = 0;
+		s_DataR3D.Instances.clear();
+		s_DataR3D.Queue.Clear();
 
 		s_DataR3D.LineVertexCount = 0;
 		s_DataR3D.LineVertexBufferPtr = s_DataR3D.LineVertexBufferBase;
@@ -151,62 +863,121 @@ namespace Hazel {
 
 	void Renderer3D::Flush()
 	{
-		if(s_DataR3D.SphereIndexCount)
-		{
-			// VAO
-			s_DataR3D.SphereVertexArray = VertexArray::Create();
-			// VBO
-			uint32_t dataSize = (uint8_t*)s_DataR3D.SphereVertexBufferPtr - (uint8_t*)s_DataR3D.SphereVertexBufferBase;
-			s_DataR3D.SphereVertexBuffer = VertexBuffer::Create(s_DataR3D.SphereVertexBufferBase, dataSize);
-			s_DataR3D.SphereVertexBuffer->SetLayout({
-				{ ShaderDataType::Float3, "a_Position"	},
-				{ ShaderDataType::Float3, "a_Normal"	},
-				{ ShaderDataType::Float2, "a_TexCoord"	},
-				{ ShaderDataType::Int,	  "a_EntityID"	},
-			});
-			s_DataR3D.SphereVertexArray->AddVertexBuffer(s_DataR3D.SphereVertexBuffer);
-			// IBO
-			s_DataR3D.SphereIndexBuffer =  IndexBuffer::Create(s_DataR3D.SphereIndexBufferBase, s_DataR3D.SphereIndexCount);
-			s_DataR3D.SphereVertexArray->SetIndexBuffer(s_DataR3D.SphereIndexBuffer);
-
-			// Bind textures
-			ResourceManager::Get()->GetCubeTexture("IrradianceMap")->Bind(0);
-			ResourceManager::Get()->GetCubeTexture("PrefilterMap")->Bind(1);
-			ResourceManager::Get()->Get2DTexture("BrdfLUTTexture")->Bind(2);
-
-			if(s_DataR3D.PbrTex.AlbedoMap)
-				s_DataR3D.PbrTex.AlbedoMap->Bind(3);
-			if (s_DataR3D.PbrTex.NormalMap)
-				s_DataR3D.PbrTex.NormalMap->Bind(4);
-			if (s_DataR3D.PbrTex.MetallicMap)
-				s_DataR3D.PbrTex.MetallicMap->Bind(5);
-			if (s_DataR3D.PbrTex.RoughnessMap)
-				s_DataR3D.PbrTex.RoughnessMap->Bind(6);
-			if (s_DataR3D.PbrTex.AoMap)
-				s_DataR3D.PbrTex.AoMap->Bind(7);
-
-			s_DataR3D.SphereShader->Bind();
-			RenderCommand::DrawIndexed(s_DataR3D.SphereVertexArray, s_DataR3D.SphereIndexCount);
-			s_DataR3D.Stats.DrawCalls++;
+		if (s_DataR3D.InstanceCount)
+		{
+			if (s_DataR3D.InstanceCount > s_DataR3D.InstanceCapacity)
+				ResizeInstanceBuffer(GrowCapacity(s_DataR3D.InstanceCapacity, s_DataR3D.InstanceCount));
+
+			// Mips are regenerated once for all the layers added since the last flush
+			for (TextureArrayGroup& group : s_DataR3D.TextureArrays)
+			{
+				if (group.MipsDirty)
+				{
+					group.Array->GenerateMipmaps();
+					group.MipsDirty = false;
+				}
+			}
+
+			RenderQueue& queue = s_DataR3D.Queue;
+
+			auto sortStart = std::chrono::high_resolution_clock::now();
+			queue.Sort();
+			auto sortEnd = std::chrono::high_resolution_clock::now();
+			s_DataR3D.Stats.SortTime += std::chrono::duration<float, std::milli>(sortEnd - sortStart).count();
+
+			// Instances are written in sorted order so every run of equal state is one contiguous instance range
+			uint32_t dataSize = s_DataR3D.InstanceCount * sizeof(MeshInstance);
+			RingBuffer::Allocation allocation = s_DataR3D.InstanceBuffer->Allocate(dataSize, sizeof(MeshInstance));
+			MeshInstance* instances = (MeshInstance*)allocation.Data;
+			for (uint32_t i = 0; i < queue.GetSize(); i++)
+				instances[i] = s_DataR3D.Instances[queue[i].Index];
+			uint32_t baseInstance = allocation.Offset / sizeof(MeshInstance);
+			s_DataR3D.Stats.BytesUploaded += dataSize;
+
+			// Only state that differs from the previous run is applied
+			const uint32_t none = 0xFFFFFFFF;
+			uint32_t boundShader = none, boundMesh = none, boundTextures = none;
+			RenderQueue::Pass currentPass = RenderQueue::Pass::Opaque;
+
+			uint32_t runStart = 0;
+			while (runStart < queue.GetSize())
+			{
+				uint64_t key = queue[runStart].SortKey;
+				RenderQueue::Pass pass = RenderQueue::GetPass(key);
+				uint32_t shader = RenderQueue::GetShader(key);
+				uint32_t mesh = RenderQueue::GetMesh(key);
+				uint32_t textureSet = RenderQueue::GetMaterial(key);
+
+				uint32_t runEnd = runStart + 1;
+				while (runEnd < queue.GetSize())
+				{
+					uint64_t nextKey = queue[runEnd].SortKey;
+					if (RenderQueue::GetPass(nextKey) != pass || RenderQueue::GetShader(nextKey) != shader
+						|| RenderQueue::GetMesh(nextKey) != mesh || RenderQueue::GetMaterial(nextKey) != textureSet)
+						break;
+					runEnd++;
+				}
+
+				if (pass != currentPass)
+				{
+					// Translucent spheres are depth tested against opaque ones but do not occlude each other
+					RenderCommand::SetDepthWrite(pass == RenderQueue::Pass::Opaque);
+					currentPass = pass;
+					s_DataR3D.Stats.StateChanges++;
+				}
+
+				if (shader != boundShader)
+				{
+					s_DataR3D.SphereShader->Bind();
+					if (!s_DataR3D.Environment.UseIrradianceSH)
+						ResourceManager::Get()->GetCubeTexture("IrradianceMap")->Bind(0);
+					ResourceManager::Get()->GetCubeTexture("PrefilterMap")->Bind(1);
+					ResourceManager::Get()->Get2DTexture("BrdfLUTTexture")->Bind(2);
+					boundShader = shader;
+					s_DataR3D.Stats.StateChanges++;
+				}
+
+				// Untextured spheres sample nothing, so whatever arrays are bound can stay
+				if (textureSet != 0 && textureSet != boundTextures)
+				{
+					const SphereTextureSet& set = s_DataR3D.SphereTextureSets[textureSet];
+					for (uint32_t map = 0; map < SphereTextureSet::MapCount; map++)
+						s_DataR3D.TextureArrays[set.Groups[map]].Array->Bind(3 + map);
+					boundTextures = textureSet;
+					s_DataR3D.Stats.StateChanges++;
+				}
+
+				if (mesh != boundMesh)
+				{
+					boundMesh = mesh;
+					s_DataR3D.Stats.StateChanges++;
+				}
+
+				const Geometry& geometry = s_DataR3D.Geometries[mesh];
+				RenderCommand::DrawIndexedInstanced(geometry.VertexArray, geometry.IndexCount, runEnd - runStart, baseInstance + runStart);
+				s_DataR3D.Stats.DrawCalls++;
+				s_DataR3D.Stats.VertexBytes += (uint64_t)(runEnd - runStart) * geometry.VertexCount * sizeof(PackedMeshVertex);
+				s_DataR3D.Stats.UnpackedVertexBytes += (uint64_t)(runEnd - runStart) * geometry.VertexCount * sizeof(MeshVertex);
+				runStart = runEnd;
+			}
+
+			if (currentPass != RenderQueue::Pass::Opaque)
+				RenderCommand::SetDepthWrite(true);
 		}
 
 		if (s_DataR3D.LineVertexCount)
 		{
-			// VAO
-			s_DataR3D.LineVertexArray = VertexArray::Create();
-			// VBO
-			uint32_t dataSize = (uint8_t*)s_DataR3D.LineVertexBufferPtr - (uint8_t*)s_DataR3D.LineVertexBufferBase;
-			s_DataR3D.LineVertexBuffer = VertexBuffer::Create(s_DataR3D.LineVertexBufferBase, dataSize);
-			s_DataR3D.LineVertexBuffer->SetLayout({
-				{ ShaderDataType::Float3, "a_Position"	},
-				{ ShaderDataType::Float4, "a_Color"		},
-				{ ShaderDataType::Int,	  "a_EntityID"	},
-			});
-			s_DataR3D.LineVertexArray->AddVertexBuffer(s_DataR3D.LineVertexBuffer);
+			uint32_t dataSize = (uint32_t)((uint8_t*)s_DataR3D.LineVertexBufferPtr - (uint8_t*)s_DataR3D.LineVertexBufferBase);
+			// Lines are appended to a growable array, so they are still copied, but no longer through the driver
+			RingBuffer::Allocation allocation = s_DataR3D.LineVertexBuffer->Allocate(dataSize, sizeof(LineVertex));
+			memcpy(allocation.Data, s_DataR3D.LineVertexBufferBase, dataSize);
+			s_DataR3D.Stats.BytesUploaded += dataSize;
+			s_DataR3D.Stats.VertexBytes += dataSize;
+			s_DataR3D.Stats.UnpackedVertexBytes += s_DataR3D.LineVertexCount * Renderer3DData::UnpackedLineVertexSize;
 
 			s_DataR3D.LineShader->Bind();
 			RenderCommand::SetLineWidth(s_DataR3D.LineWidth);
-			RenderCommand::DrawLines(s_DataR3D.LineVertexArray, s_DataR3D.LineVertexCount);
+			RenderCommand::DrawLines(s_DataR3D.LineVertexArray, s_DataR3D.LineVertexCount, allocation.Offset / sizeof(LineVertex));
 			s_DataR3D.Stats.DrawCalls++;
 		}
 	}
@@ -217,160 +988,278 @@ namespace Hazel {
 		StartBatch();
 	}
 
-	void Renderer3D::DrawSphere(const glm::vec3& position, float radius, const PbrMaterial& material, LightParams lightParams)
+	void Renderer3D::DrawSphere(const glm::vec3& position, float radius, const PbrMaterial& material)
 	{
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::scale(glm::mat4(1.0f), { radius, radius, radius });
 
-		DrawSphere(transform, material, lightParams);
+		DrawSphere(transform, material);
 	}
 
-	void Renderer3D::DrawSphere(const glm::vec3& position, float radius, PbrMaterialTexture pbrTexture, LightParams lightParams)
+	void Renderer3D::DrawSphere(const glm::vec3& position, float radius, const PbrMaterialTexture& pbrTexture)
 	{
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::scale(glm::mat4(1.0f), { radius, radius, radius });
 
-		DrawSphere(transform, pbrTexture, lightParams);
+		DrawSphere(transform, pbrTexture);
 	}
 
-	void Renderer3D::DrawSphere(const glm::mat4& transform, const PbrMaterial& material, LightParams lightParams, int entityID)
+	// Picks the LOD from the projected radius. previousLod (if valid) only changes once the sphere is clearly past a threshold.
+	static uint32_t SelectSphereLod(const glm::mat4& transform, float depth, float lodBias, uint32_t previousLod)
 	{
-		const float textureIndex = 0.0f; // White Texture;
+		// The unit sphere's world radius is its largest axis scale
+		float radiusSquared = std::max({ glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+			glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+			glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2])) });
+		float radius = std::sqrt(radiusSquared);
+		if (depth <= radius)
+			return 0;
+
+		float coverage = radius * s_DataR3D.ProjectionMatrix[1][1] / depth;
+		coverage *= std::exp2(-(s_DataR3D.SphereLodBias + lodBias));
+
+		auto select = [coverage](float scale)
+		{
+			uint32_t lod = 0;
+			while (lod < Renderer3DData::SphereLodCount - 1 && coverage < Renderer3DData::SphereLodCoverage[lod] * scale)
+				lod++;
+			return lod;
+		};
 
-		const uint32_t xTotalSegments = 64;
-		const uint32_t yTotalSegments = 64;
-		constexpr float pi = glm::pi<float>();
+		uint32_t lod = select(1.0f);
+		if (previousLod >= Renderer3DData::SphereLodCount || lod == previousLod)
+			return lod;
 
-		s_DataR3D.SphereShader->Bind();
-		s_DataR3D.SphereShader->SetMat4("u_ModelMatrix", transform);
-		s_DataR3D.SphereShader->SetMat4("u_NormalMatrix", glm::transpose(glm::inverse(glm::mat3(transform))));
+		if (lod > previousLod)
+			return std::max(select(1.0f - Renderer3DData::SphereLodHysteresis), previousLod);
+		else
+			return std::min(select(1.0f + Renderer3DData::SphereLodHysteresis), previousLod);
+	}
 
-		s_DataR3D.SphereShader->SetInt("u_UseTexture", 0);
-		s_DataR3D.SphereShader->SetFloat3("u_Albedo", material.Albedo);
-		s_DataR3D.SphereShader->SetFloat("u_Metallic", material.Metallic);
-		s_DataR3D.SphereShader->SetFloat("u_Roughness", material.Roughness);
-		s_DataR3D.SphereShader->SetFloat("u_Ao", material.Ao);
+	// LOD the current camera last drew the entity's sphere with, SphereLodCount if none
+	static uint32_t GetPreviousSphereLod(int entityID)
+	{
+		if (entityID < 0)
+			return Renderer3DData::SphereLodCount;
 
-		int pointLightNum = lightParams.PointLightPositions.size();
-		s_DataR3D.SphereShader->SetInt("u_PointLightNum", pointLightNum);
-		if (pointLightNum > 0)
-		{
-			s_DataR3D.SphereShader->SetFloat3Array("u_PointLightPositions", glm::value_ptr(lightParams.PointLightPositions[0]), pointLightNum);
-			s_DataR3D.SphereShader->SetFloat3Array("u_PointLightColors", glm::value_ptr(lightParams.PointLightColors[0]), pointLightNum);
-		}
+		const auto& lods = s_DataR3D.CurrentLodHistory->Lods;
+		auto it = lods.find(entityID);
+		return it != lods.end() ? it->second : Renderer3DData::SphereLodCount;
+	}
 
-		for (uint32_t x = 0; x <= xTotalSegments; x++)
-		{
-			for (uint32_t y = 0; y <= yTotalSegments; y++)
-			{
-				float xSegment = (float)x / (float)xTotalSegments;
-				float ySegment = (float)y / (float)yTotalSegments;
-				float xPos = std::cos(xSegment * 2.0f * pi) * std::sin(ySegment * pi);
-				float yPos = std::cos(ySegment * pi);
-				float zPos = std::sin(xSegment * 2.0f * pi) * std::sin(ySegment * pi);
-
-				s_DataR3D.SphereVertexBufferPtr->Position = glm::vec3(xPos, yPos, zPos);
-				s_DataR3D.SphereVertexBufferPtr->Normal = glm::vec3(xPos, yPos, zPos);
-				s_DataR3D.SphereVertexBufferPtr->TexCoord = glm::vec2(xSegment, ySegment);
-				s_DataR3D.SphereVertexBufferPtr->EntityID = entityID;
-				s_DataR3D.SphereVertexBufferPtr++;
-			}
-		}
+	static void WriteInstance(MeshInstance& instance, uint32_t material, const glm::mat4& transform, const PbrMaterial& pbrMaterial, int entityID)
+	{
+		instance.ModelMatrix = transform;
+		instance.NormalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+		instance.Albedo = glm::vec4(pbrMaterial.Albedo, pbrMaterial.Opacity);
+		instance.Material = { pbrMaterial.Metallic, pbrMaterial.Roughness, pbrMaterial.Ao };
+		instance.EntityID = entityID;
+		instance.MaterialIndex = (int)material;
+	}
 
-		for (uint32_t y = 0; y < yTotalSegments; y++)
-		{
-			for (uint32_t x = 0; x < xTotalSegments; x++)
-			{
-				*s_DataR3D.SphereIndexBufferPtr++ = y * (xTotalSegments + 1) + x;
-				*s_DataR3D.SphereIndexBufferPtr++ = (y + 1) * (xTotalSegments + 1) + x;
-				*s_DataR3D.SphereIndexBufferPtr++ = (y + 1) * (xTotalSegments + 1) + x + 1;
+	static uint64_t MakeInstanceKey(uint32_t geometry, uint32_t material, float opacity, float depth)
+	{
+		RenderQueue::Pass pass = opacity < 1.0f ? RenderQueue::Pass::Translucent : RenderQueue::Pass::Opaque;
+		uint32_t textureSet = s_DataR3D.SphereMaterials[material].TextureSet;
+		return RenderQueue::MakeKey(pass, Renderer3DData::SphereShaderID, geometry, textureSet, depth);
+	}
 
-				*s_DataR3D.SphereIndexBufferPtr++ = y * (xTotalSegments + 1) + x;
-				*s_DataR3D.SphereIndexBufferPtr++ = (y + 1) * (xTotalSegments + 1) + x + 1;
-				*s_DataR3D.SphereIndexBufferPtr++ = y * (xTotalSegments + 1) + x + 1;
-			}
-		}
-		s_DataR3D.SphereIndexCount = s_DataR3D.SphereIndexBufferPtr - s_DataR3D.SphereIndexBufferBase;
+	static void SubmitInstance(uint32_t geometry, uint32_t material, const glm::mat4& transform, const PbrMaterial& pbrMaterial, int entityID, float depth)
+	{
+		WriteInstance(s_DataR3D.Instances.emplace_back(), material, transform, pbrMaterial, entityID);
+		s_DataR3D.Queue.Submit(MakeInstanceKey(geometry, material, pbrMaterial.Opacity, depth), s_DataR3D.InstanceCount);
+
+		s_DataR3D.InstanceCount++;
+		s_DataR3D.Stats.Triangles += s_DataR3D.Geometries[geometry].IndexCount / 3;
+	}
+
+	static void SubmitSphere(uint32_t material, const glm::mat4& transform, const PbrMaterial& pbrMaterial, int entityID, float lodBias = 0.0f)
+	{
+		float depth = -(s_DataR3D.ViewMatrix * transform[3]).z;
+		uint32_t lod = SelectSphereLod(transform, depth, lodBias, GetPreviousSphereLod(entityID));
+		if (entityID >= 0)
+			s_DataR3D.SphereLods.push_back({ entityID, lod });
+
+		SubmitInstance(lod, material, transform, pbrMaterial, entityID, depth);
 		s_DataR3D.Stats.SphereCount++;
-		NextBatch();
 	}
 
-	void Renderer3D::DrawSphere(const glm::mat4& transform, PbrMaterialTexture pbrTexture, LightParams lightParams, int entityID)
+	static void SubmitMesh(const Ref<Mesh>& mesh, uint32_t material, const glm::mat4& transform, const PbrMaterial& pbrMaterial, int entityID)
 	{
-		float textureIndex = 0.0f;
+		float depth = -(s_DataR3D.ViewMatrix * transform[3]).z;
+		SubmitInstance(GetMeshGeometry(mesh), material, transform, pbrMaterial, entityID, depth);
+		s_DataR3D.Stats.MeshCount++;
+	}
 
-		const uint32_t xTotalSegments = 64;
-		const uint32_t yTotalSegments = 64;
-		constexpr float pi = glm::pi<float>();
+	void Renderer3D::DrawSphere(const glm::mat4& transform, const PbrMaterial& material, int entityID)
+	{
+		SubmitSphere(0, transform, material, entityID);
+	}
 
-		s_DataR3D.SphereShader->Bind();
-		s_DataR3D.SphereShader->SetMat4("u_ModelMatrix", transform);
-		s_DataR3D.SphereShader->SetMat4("u_NormalMatrix", glm::transpose(glm::inverse(glm::mat3(transform))));
-		s_DataR3D.SphereShader->SetInt("u_UseTexture", 1);
+	void Renderer3D::DrawSphere(const glm::mat4& transform, const PbrMaterialTexture& pbrTexture, int entityID)
+	{
+		SubmitSphere(GetSphereMaterial(pbrTexture), transform, PbrMaterial(), entityID);
+	}
 
-		int pointLightNum = lightParams.PointLightPositions.size();
-		s_DataR3D.SphereShader->SetInt("u_PointLightNum", pointLightNum);
-		if (pointLightNum > 0)
+	void Renderer3D::DrawSphere(const glm::mat4& transform, SphereRendererComponent& src, int entityID)
+	{
+		if (src.MaterialTexture.isComplete())
+			SubmitSphere(GetSphereMaterial(src.MaterialTexture), transform, PbrMaterial(), entityID, src.LodBias);
+		else
+			SubmitSphere(0, transform, src.Material, entityID, src.LodBias);
+	}
+
+	void Renderer3D::DrawMesh(const glm::mat4& transform, const Ref<Mesh>& mesh, const PbrMaterial& material, int entityID)
+	{
+		SubmitMesh(mesh, 0, transform, material, entityID);
+	}
+
+	void Renderer3D::DrawMesh(const glm::mat4& transform, const Ref<Mesh>& mesh, const PbrMaterialTexture& pbrTexture, int entityID)
+	{
+		SubmitMesh(mesh, GetSphereMaterial(pbrTexture), transform, PbrMaterial(), entityID);
+	}
+
+	void Renderer3D::DrawMesh(const glm::mat4& transform, MeshRendererComponent& mrc, int entityID)
+	{
+		if (!mrc.Mesh)
+			return;
+
+		if (mrc.MaterialTexture.isComplete())
+			SubmitMesh(mrc.Mesh, GetSphereMaterial(mrc.MaterialTexture), transform, PbrMaterial(), entityID);
+		else
+			SubmitMesh(mrc.Mesh, 0, transform, mrc.Material, entityID);
+	}
+
+	// Runs on the recording threads, so it only reads shared renderer state
+	static void RecordInstance(CommandList& list, uint32_t geometry, uint32_t material, const glm::mat4& transform, const PbrMaterial& pbrMaterial,
+		int entityID, float depth, const PbrMaterialTexture* pendingMaterial, const Ref<Mesh>* pendingMesh)
+	{
+		uint32_t index = (uint32_t)list.Instances.size();
+		WriteInstance(list.Instances.emplace_back(), material, transform, pbrMaterial, entityID);
+		if (pendingMaterial || pendingMesh)
 		{
-			s_DataR3D.SphereShader->SetFloat3Array("u_PointLightPositions", glm::value_ptr(lightParams.PointLightPositions[0]), pointLightNum);
-			s_DataR3D.SphereShader->SetFloat3Array("u_PointLightColors", glm::value_ptr(lightParams.PointLightColors[0]), pointLightNum);
+			list.Deferred.push_back({ index, pendingMaterial, pendingMesh, geometry, pbrMaterial.Opacity, depth });
+			return;
 		}
 
-		s_DataR3D.PbrTex = pbrTexture;
+		list.Packets.push_back({ MakeInstanceKey(geometry, material, pbrMaterial.Opacity, depth), index });
+		list.Triangles += s_DataR3D.Geometries[geometry].IndexCount / 3;
+	}
+
+	void Renderer3D::BeginRecording(uint32_t listCount)
+	{
+		if (s_DataR3D.CommandLists.size() < listCount)
+			s_DataR3D.CommandLists.resize(listCount);
 
-		for (uint32_t x = 0; x <= xTotalSegments; x++)
+		for (uint32_t i = 0; i < listCount; i++)
 		{
-			for (uint32_t y = 0; y <= yTotalSegments; y++)
-			{
-				float xSegment = (float)x / (float)xTotalSegments;
-				float ySegment = (float)y / (float)yTotalSegments;
-				float xPos = std::cos(xSegment * 2.0f * pi) * std::sin(ySegment * pi);
-				float yPos = std::cos(ySegment * pi);
-				float zPos = std::sin(xSegment * 2.0f * pi) * std::sin(ySegment * pi);
-
-				s_DataR3D.SphereVertexBufferPtr->Position = glm::vec3(xPos, yPos, zPos);
-				s_DataR3D.SphereVertexBufferPtr->Normal = glm::vec3(xPos, yPos, zPos);
-				s_DataR3D.SphereVertexBufferPtr->TexCoord = glm::vec2(xSegment, ySegment);
-				s_DataR3D.SphereVertexBufferPtr->EntityID = entityID;
-				s_DataR3D.SphereVertexBufferPtr++;
-			}
+			CommandList& list = s_DataR3D.CommandLists[i];
+			list.Instances.clear();
+			list.Packets.clear();
+			list.Deferred.clear();
+			list.SphereLods.clear();
+			list.SphereCount = list.MeshCount = list.Triangles = 0;
+			list.RecordTime = 0.0f;
 		}
+		s_DataR3D.CommandListCount = listCount;
+	}
 
-		for (uint32_t y = 0; y < yTotalSegments; y++)
-		{
-			for (uint32_t x = 0; x < xTotalSegments; x++)
-			{
-				*s_DataR3D.SphereIndexBufferPtr++ = y * (xTotalSegments + 1) + x;
-				*s_DataR3D.SphereIndexBufferPtr++ = (y + 1) * (xTotalSegments + 1) + x;
-				*s_DataR3D.SphereIndexBufferPtr++ = (y + 1) * (xTotalSegments + 1) + x + 1;
+	void Renderer3D::RecordSphere(uint32_t list, const glm::mat4& transform, SphereRendererComponent& src, int entityID)
+	{
+		CommandList& commands = s_DataR3D.CommandLists[list];
+		float depth = -(s_DataR3D.ViewMatrix * transform[3]).z;
+		uint32_t lod = SelectSphereLod(transform, depth, src.LodBias, GetPreviousSphereLod(entityID));
+		if (entityID >= 0)
+			commands.SphereLods.push_back({ entityID, lod });
 
-				*s_DataR3D.SphereIndexBufferPtr++ = y * (xTotalSegments + 1) + x;
-				*s_DataR3D.SphereIndexBufferPtr++ = (y + 1) * (xTotalSegments + 1) + x + 1;
-				*s_DataR3D.SphereIndexBufferPtr++ = y * (xTotalSegments + 1) + x + 1;
-			}
+		if (src.MaterialTexture.isComplete())
+		{
+			uint32_t material = FindSphereMaterial(src.MaterialTexture);
+			RecordInstance(commands, lod, material, transform, PbrMaterial(), entityID, depth,
+				material == InvalidIndex ? &src.MaterialTexture : nullptr, nullptr);
 		}
-		s_DataR3D.SphereIndexCount = s_DataR3D.SphereIndexBufferPtr - s_DataR3D.SphereIndexBufferBase;
-		s_DataR3D.Stats.SphereCount++;
-		NextBatch();
+		else
+			RecordInstance(commands, lod, 0, transform, src.Material, entityID, depth, nullptr, nullptr);
+		commands.SphereCount++;
 	}
 
-	void Renderer3D::DrawSphere(const glm::mat4& transform, SphereRendererComponent& src, LightParams lightParams, int entityID)
+	void Renderer3D::RecordMesh(uint32_t list, const glm::mat4& transform, MeshRendererComponent& mrc, int entityID)
 	{
-		if (src.MaterialTexture.isComplete())
-			DrawSphere(transform, src.MaterialTexture, lightParams, entityID);
+		if (!mrc.Mesh)
+			return;
+
+		CommandList& commands = s_DataR3D.CommandLists[list];
+		float depth = -(s_DataR3D.ViewMatrix * transform[3]).z;
+		uint32_t geometry = FindMeshGeometry(mrc.Mesh.get());
+		const Ref<Mesh>* pendingMesh = geometry == InvalidIndex ? &mrc.Mesh : nullptr;
+
+		if (mrc.MaterialTexture.isComplete())
+		{
+			uint32_t material = FindSphereMaterial(mrc.MaterialTexture);
+			RecordInstance(commands, geometry, material, transform, PbrMaterial(), entityID, depth,
+				material == InvalidIndex ? &mrc.MaterialTexture : nullptr, pendingMesh);
+		}
 		else
-			DrawSphere(transform, src.Material, lightParams, entityID);
+			RecordInstance(commands, geometry, 0, transform, mrc.Material, entityID, depth, nullptr, pendingMesh);
+		commands.MeshCount++;
+	}
+
+	void Renderer3D::AddRecordTime(uint32_t list, float time)
+	{
+		s_DataR3D.CommandLists[list].RecordTime += time;
+	}
+
+	void Renderer3D::SubmitRecorded()
+	{
+		auto mergeStart = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t i = 0; i < s_DataR3D.CommandListCount; i++)
+		{
+			const CommandList& list = s_DataR3D.CommandLists[i];
+			uint32_t base = s_DataR3D.InstanceCount;
+			s_DataR3D.Instances.insert(s_DataR3D.Instances.end(), list.Instances.begin(), list.Instances.end());
+			for (const DrawPacket& packet : list.Packets)
+				s_DataR3D.Queue.Submit(packet.SortKey, base + packet.Index);
+
+			for (const DeferredInstance& deferred : list.Deferred)
+			{
+				MeshInstance& instance = s_DataR3D.Instances[base + deferred.Instance];
+				if (deferred.MaterialTexture)
+					instance.MaterialIndex = (int)GetSphereMaterial(*deferred.MaterialTexture);
+				uint32_t geometry = deferred.Mesh ? GetMeshGeometry(*deferred.Mesh) : deferred.Geometry;
+
+				uint64_t key = MakeInstanceKey(geometry, (uint32_t)instance.MaterialIndex, deferred.Opacity, deferred.Depth);
+				s_DataR3D.Queue.Submit(key, base + deferred.Instance);
+				s_DataR3D.Stats.Triangles += s_DataR3D.Geometries[geometry].IndexCount / 3;
+			}
+
+			s_DataR3D.SphereLods.insert(s_DataR3D.SphereLods.end(), list.SphereLods.begin(), list.SphereLods.end());
+			s_DataR3D.InstanceCount += (uint32_t)list.Instances.size();
+			s_DataR3D.Stats.SphereCount += list.SphereCount;
+			s_DataR3D.Stats.MeshCount += list.MeshCount;
+			s_DataR3D.Stats.Triangles += list.Triangles;
+			if (i < Statistics::MaxRecordThreads)
+				s_DataR3D.Stats.RecordTimes[i] += list.RecordTime;
+		}
+		s_DataR3D.Stats.RecordThreads = std::max(s_DataR3D.Stats.RecordThreads, std::min(s_DataR3D.CommandListCount, Statistics::MaxRecordThreads));
+
+		auto mergeEnd = std::chrono::high_resolution_clock::now();
+		s_DataR3D.Stats.MergeTime += std::chrono::duration<float, std::milli>(mergeEnd - mergeStart).count();
 	}
 
 	void Renderer3D::DrawLines(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID)
 	{
+		if (s_DataR3D.LineVertexCount + 2 > s_DataR3D.LineVertexCapacity)
+			ResizeLineVertexBuffer(GrowCapacity(s_DataR3D.LineVertexCapacity, s_DataR3D.LineVertexCount + 2));
+
+		uint32_t packedColor = glm::packUnorm4x8(color);
 		s_DataR3D.LineVertexBufferPtr->Position = p0;
-		s_DataR3D.LineVertexBufferPtr->Color = color;
+		s_DataR3D.LineVertexBufferPtr->Color = packedColor;
 		s_DataR3D.LineVertexBufferPtr->EntityID = entityID;
 		s_DataR3D.LineVertexBufferPtr++;
 
 		s_DataR3D.LineVertexBufferPtr->Position = p1;
-		s_DataR3D.LineVertexBufferPtr->Color = color;
+		s_DataR3D.LineVertexBufferPtr->Color = packedColor;
 		s_DataR3D.LineVertexBufferPtr->EntityID = entityID;
 		s_DataR3D.LineVertexBufferPtr++;
 
@@ -387,67 +1276,34 @@ namespace Hazel {
 		s_DataR3D.LineWidth = width;
 	}
 
-	static void RenderCube()
-	{
-		// initialize (if necessary)
-		float vertices[] = {
-			// back face
-			-1.0f, -1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 0.0f, 0.0f, // bottom-left
-			 1.0f,  1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 1.0f, 1.0f, // top-right
-			 1.0f, -1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 1.0f, 0.0f, // bottom-right         
-			 1.0f,  1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 1.0f, 1.0f, // top-right
-			-1.0f, -1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 0.0f, 0.0f, // bottom-left
-			-1.0f,  1.0f, -1.0f,  0.0f,  0.0f, -1.0f, 0.0f, 1.0f, // top-left
-			// front face
-			-1.0f, -1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, 0.0f, // bottom-left
-			 1.0f, -1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, 0.0f, // bottom-right
-			 1.0f,  1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, 1.0f, // top-right
-			 1.0f,  1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, 1.0f, // top-right
-			-1.0f,  1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, 1.0f, // top-left
-			-1.0f, -1.0f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, 0.0f, // bottom-left
-			// left face
-			-1.0f,  1.0f,  1.0f, -1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-right
-			-1.0f,  1.0f, -1.0f, -1.0f,  0.0f,  0.0f, 1.0f, 1.0f, // top-left
-			-1.0f, -1.0f, -1.0f, -1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-left
-			-1.0f, -1.0f, -1.0f, -1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-left
-			-1.0f, -1.0f,  1.0f, -1.0f,  0.0f,  0.0f, 0.0f, 0.0f, // bottom-right
-			-1.0f,  1.0f,  1.0f, -1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-right
-			// right face
-			 1.0f,  1.0f,  1.0f,  1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-left
-			 1.0f, -1.0f, -1.0f,  1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-right
-			 1.0f,  1.0f, -1.0f,  1.0f,  0.0f,  0.0f, 1.0f, 1.0f, // top-right         
-			 1.0f, -1.0f, -1.0f,  1.0f,  0.0f,  0.0f, 0.0f, 1.0f, // bottom-right
-			 1.0f,  1.0f,  1.0f,  1.0f,  0.0f,  0.0f, 1.0f, 0.0f, // top-left
-			 1.0f, -1.0f,  1.0f,  1.0f,  0.0f,  0.0f, 0.0f, 0.0f, // bottom-left     
-			 // bottom face
-			 -1.0f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f, 0.0f, 1.0f, // top-right
-			  1.0f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f, 1.0f, 1.0f, // top-left
-			  1.0f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f, // bottom-left
-			  1.0f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f, // bottom-left
-			 -1.0f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f, 0.0f, 0.0f, // bottom-right
-			 -1.0f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f, 0.0f, 1.0f, // top-right
-			 // top face
-			 -1.0f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f, 0.0f, 1.0f, // top-left
-			  1.0f,  1.0f , 1.0f,  0.0f,  1.0f,  0.0f, 1.0f, 0.0f, // bottom-right
-			  1.0f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f, 1.0f, 1.0f, // top-right     
-			  1.0f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f, 1.0f, 0.0f, // bottom-right
-			 -1.0f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f, 0.0f, 1.0f, // top-left
-			 -1.0f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f, 0.0f, 0.0f  // bottom-left        
-		};
+	float Renderer3D::GetSphereLodBias()
+	{
+		return s_DataR3D.SphereLodBias;
+	}
 
-		// VAO
-		Ref<VertexArray> cubeVAO = VertexArray::Create();
-		// VBO
-		Ref<VertexBuffer> cubeVBO = VertexBuffer::Create(vertices, sizeof(vertices));
-		cubeVBO->SetLayout({
-			{ ShaderDataType::Float3, "aPos"	},
-			{ ShaderDataType::Float3, "aNormal"	},
-			{ ShaderDataType::Float2, "aTexCoord"	},
-			});
-		cubeVAO->AddVertexBuffer(cubeVBO);
+	void Renderer3D::SetSphereLodBias(float bias)
+	{
+		s_DataR3D.SphereLodBias = bias;
+	}
+
+	void Renderer3D::SetIrradianceSH(const SphericalHarmonics& irradianceSH)
+	{
+		for (uint32_t i = 0; i < SphericalHarmonics::CoefficientCount; i++)
+			s_DataR3D.Environment.IrradianceSH[i] = glm::vec4(irradianceSH.Coefficients[i], 0.0f);
+		s_DataR3D.EnvironmentDirty = true;
+	}
 
-		// render Cube
-		RenderCommand::DrawArrays(cubeVAO, 36);
+	bool Renderer3D::GetUseIrradianceSH()
+	{
+		return s_DataR3D.Environment.UseIrradianceSH != 0;
+	}
+
+	void Renderer3D::SetUseIrradianceSH(bool use)
+	{
+		if (GetUseIrradianceSH() == use)
+			return;
+		s_DataR3D.Environment.UseIrradianceSH = use ? 1 : 0;
+		s_DataR3D.EnvironmentDirty = true;
 	}
 
 	void Renderer3D::DrawIBLBackground(const EditorCamera& camera)
@@ -457,7 +1313,7 @@ namespace Hazel {
 		s_DataR3D.IBL_BackgroundShader->SetMat4("view", camera.GetViewMatrix());
 		s_DataR3D.IBL_BackgroundShader->SetInt("environmentMap", 0);
 		ResourceManager::Get()->GetCubeTexture("EnvCubeMap")->Bind();
-		RenderCube();
+		PrimitiveCache::Draw(PrimitiveCache::Cube);
 	}
 
 	void Renderer3D::DrawGroundPlane(int rows, int cols, float spacing)
@@ -0,0 +1,20 @@
+#include "Hazel/Renderer/RingBuffer.h"
+
+#include "Hazel/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLRingBuffer.h"
+
+namespace Hazel {
+
+	Ref<RingBuffer> RingBuffer::Create(uint32_t segmentSize)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLRingBuffer>(segmentSize);
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,202 @@
+#include "Hazel/Renderer/SphericalHarmonics.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <future>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+	#define HZ_SH_SSE 1
+	#include <xmmintrin.h>
+#endif
+
+namespace Hazel {
+
+	namespace Utils {
+
+		// Normalization of each basis function, the polynomial parts are evaluated separately
+		static constexpr float SHBasisScale[SphericalHarmonics::CoefficientCount] = {
+			0.282095f,
+			0.488603f, 0.488603f, 0.488603f,
+			1.092548f, 1.092548f, 0.315392f, 1.092548f, 0.546274f
+		};
+
+		static void EvaluateSHPolynomials(float x, float y, float z, float* out)
+		{
+			out[0] = 1.0f;
+			out[1] = y;
+			out[2] = z;
+			out[3] = x;
+			out[4] = x * y;
+			out[5] = y * z;
+			out[6] = 3.0f * z * z - 1.0f;
+			out[7] = x * z;
+			out[8] = x * x - y * y;
+		}
+
+		struct SHSums
+		{
+			double Values[SphericalHarmonics::CoefficientCount][3] = {};
+		};
+
+		// Texel (i, j) is the direction at longitude cosPhi/sinPhi[i] and latitude of row j, weighted by its solid angle.
+		// Rows are summed in float and added to the double totals, so precision doesn't depend on the image size.
+		static void ProjectRows(const float* pixels, uint32_t width, uint32_t height, uint32_t channels, uint32_t rowBegin, uint32_t rowEnd,
+			const float* cosPhi, const float* sinPhi, SHSums& sums)
+		{
+			constexpr uint32_t count = SphericalHarmonics::CoefficientCount;
+			const float texelArea = (2.0f * glm::pi<float>() / (float)width) * (glm::pi<float>() / (float)height);
+
+			for (uint32_t j = rowBegin; j < rowEnd; j++)
+			{
+				float latitude = (((float)j + 0.5f) / (float)height - 0.5f) * glm::pi<float>();
+				float y = std::sin(latitude);
+				float cosLatitude = std::cos(latitude);
+				const float* row = pixels + (size_t)j * width * channels;
+
+				float rowSums[count][3] = {};
+				uint32_t i = 0;
+#if HZ_SH_SSE
+				// Four texels of the row per iteration, one lane each
+				__m128 acc[count][3];
+				for (uint32_t k = 0; k < count; k++)
+					acc[k][0] = acc[k][1] = acc[k][2] = _mm_setzero_ps();
+
+				const __m128 vy = _mm_set1_ps(y);
+				const __m128 vCosLatitude = _mm_set1_ps(cosLatitude);
+				const __m128 one = _mm_set1_ps(1.0f);
+				const __m128 three = _mm_set1_ps(3.0f);
+				for (; i + 4 <= width; i += 4)
+				{
+					__m128 x = _mm_mul_ps(vCosLatitude, _mm_loadu_ps(cosPhi + i));
+					__m128 z = _mm_mul_ps(vCosLatitude, _mm_loadu_ps(sinPhi + i));
+
+					const float* p = row + (size_t)i * channels;
+					__m128 rgb[3] = {
+						_mm_setr_ps(p[0], p[channels], p[2 * channels], p[3 * channels]),
+						_mm_setr_ps(p[1], p[channels + 1], p[2 * channels + 1], p[3 * channels + 1]),
+						_mm_setr_ps(p[2], p[channels + 2], p[2 * channels + 2], p[3 * channels + 2])
+					};
+
+					__m128 basis[count] = {
+						one,
+						vy,
+						z,
+						x,
+						_mm_mul_ps(x, vy),
+						_mm_mul_ps(vy, z),
+						_mm_sub_ps(_mm_mul_ps(three, _mm_mul_ps(z, z)), one),
+						_mm_mul_ps(x, z),
+						_mm_sub_ps(_mm_mul_ps(x, x), _mm_mul_ps(vy, vy))
+					};
+
+					for (uint32_t k = 0; k < count; k++)
+					{
+						for (uint32_t c = 0; c < 3; c++)
+							acc[k][c] = _mm_add_ps(acc[k][c], _mm_mul_ps(rgb[c], basis[k]));
+					}
+				}
+
+				alignas(16) float lanes[4];
+				for (uint32_t k = 0; k < count; k++)
+				{
+					for (uint32_t c = 0; c < 3; c++)
+					{
+						_mm_store_ps(lanes, acc[k][c]);
+						rowSums[k][c] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+					}
+				}
+#endif
+				for (; i < width; i++)
+				{
+					float basis[count];
+					EvaluateSHPolynomials(cosLatitude * cosPhi[i], y, cosLatitude * sinPhi[i], basis);
+
+					const float* p = row + (size_t)i * channels;
+					for (uint32_t k = 0; k < count; k++)
+					{
+						for (uint32_t c = 0; c < 3; c++)
+							rowSums[k][c] += p[c] * basis[k];
+					}
+				}
+
+				// Every texel of a row covers the same solid angle
+				double rowWeight = (double)texelArea * cosLatitude;
+				for (uint32_t k = 0; k < count; k++)
+				{
+					for (uint32_t c = 0; c < 3; c++)
+						sums.Values[k][c] += rowSums[k][c] * rowWeight;
+				}
+			}
+		}
+
+	}
+
+	SphericalHarmonics SphericalHarmonics::ProjectEquirectangular(const float* pixels, uint32_t width, uint32_t height, uint32_t channels)
+	{
+		HZ_CORE_ASSERT(pixels && width && height && channels >= 3, "Invalid environment image!");
+
+		// Longitude only depends on the column, matching atan(v.z, v.x) in IBL_EquirectangularToCubemap.glsl
+		std::vector<float> cosPhi(width), sinPhi(width);
+		for (uint32_t i = 0; i < width; i++)
+		{
+			float phi = (((float)i + 0.5f) / (float)width - 0.5f) * 2.0f * glm::pi<float>();
+			cosPhi[i] = std::cos(phi);
+			sinPhi[i] = std::sin(phi);
+		}
+
+		uint32_t bandCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), height);
+		std::vector<Utils::SHSums> bandSums(bandCount);
+		std::vector<std::future<void>> futures;
+		futures.reserve(bandCount);
+		for (uint32_t band = 0; band < bandCount; band++)
+		{
+			uint32_t rowBegin = (uint32_t)((uint64_t)height * band / bandCount);
+			uint32_t rowEnd = (uint32_t)((uint64_t)height * (band + 1) / bandCount);
+			futures.push_back(std::async(std::launch::async, Utils::ProjectRows, pixels, width, height, channels, rowBegin, rowEnd,
+				cosPhi.data(), sinPhi.data(), std::ref(bandSums[band])));
+		}
+		for (auto& future : futures)
+			future.get();
+
+		SphericalHarmonics result;
+		for (uint32_t k = 0; k < CoefficientCount; k++)
+		{
+			double sum[3] = {};
+			for (const Utils::SHSums& sums : bandSums)
+			{
+				for (uint32_t c = 0; c < 3; c++)
+					sum[c] += sums.Values[k][c];
+			}
+			result.Coefficients[k] = glm::vec3((float)sum[0], (float)sum[1], (float)sum[2]) * Utils::SHBasisScale[k];
+		}
+		return result;
+	}
+
+	SphericalHarmonics SphericalHarmonics::ConvolveIrradiance() const
+	{
+		// Clamped cosine lobe per band (pi, 2pi/3, pi/4), divided by pi
+		static constexpr float bandScale[CoefficientCount] = {
+			1.0f,
+			2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+			0.25f, 0.25f, 0.25f, 0.25f, 0.25f
+		};
+
+		SphericalHarmonics result;
+		for (uint32_t k = 0; k < CoefficientCount; k++)
+			result.Coefficients[k] = Coefficients[k] * bandScale[k];
+		return result;
+	}
+
+	glm::vec3 SphericalHarmonics::Evaluate(const glm::vec3& direction) const
+	{
+		float basis[CoefficientCount];
+		Utils::EvaluateSHPolynomials(direction.x, direction.y, direction.z, basis);
+
+		glm::vec3 result(0.0f);
+		for (uint32_t k = 0; k < CoefficientCount; k++)
+			result += Coefficients[k] * (basis[k] * Utils::SHBasisScale[k]);
+		return result;
+	}
+
+}
@@ -17,4 +17,11 @@ namespace Hazel {
 		glm::vec2 max = { ((coords.x + spriteSize.x) * cellSize.x) / texture->GetWidth(), ((coords.y + spriteSize.y) * cellSize.y) / texture->GetHeight() };
 		return CreateRef<SubTexture2D>(texture, min, max);
 	}
+
+	void SubTexture2D::Remap(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max)
+	{
+		m_Texture = texture;
+		for (glm::vec2& texCoord : m_TexCoords)
+			texCoord = min + texCoord * (max - min);
+	}
 }
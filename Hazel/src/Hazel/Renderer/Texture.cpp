@@ -7,12 +7,12 @@
 
 namespace Hazel {
 
-	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height)
+	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, TextureFormat format, uint32_t mipLevels)
 	{
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(width, height);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(width, height, format, mipLevels);
 		}
 
 		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -55,12 +55,36 @@ namespace Hazel {
 		return nullptr;
 	}
 
-	Ref<TextureCube> TextureCube::Create(uint32_t width, uint32_t height)
+	Ref<TextureCube> TextureCube::Create(uint32_t width, uint32_t height, uint32_t mipLevels)
 	{
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTextureCube>(width, height);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTextureCube>(width, height, mipLevels);
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<Texture2DArray> Texture2DArray::Create(uint32_t width, uint32_t height, uint32_t layers, TextureFormat format)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2DArray>(width, height, layers, format);
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<TextureReadback> TextureReadback::Create(uint32_t size)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTextureReadback>(size);
 		}
 
 		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
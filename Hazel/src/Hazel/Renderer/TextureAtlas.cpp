@@ -0,0 +1,264 @@
+#include "Hazel/Renderer/TextureAtlas.h"
+
+#include <stb_image.h>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		// Level 0 of an 8-bit texture decoded from its file and expanded to RGBA8, with the components GL would
+		// sample. Empty if the file is gone or no longer matches the texture.
+		static std::vector<uint32_t> LoadTexelsRGBA8(const Ref<Texture2D>& texture)
+		{
+			uint32_t width = texture->GetWidth(), height = texture->GetHeight();
+
+			int fileWidth, fileHeight, channels;
+			stbi_set_flip_vertically_on_load(1);
+			stbi_uc* data = stbi_load(texture->GetPath().c_str(), &fileWidth, &fileHeight, &channels, 0);
+			if (!data)
+				return {};
+
+			std::vector<uint32_t> texels;
+			if ((uint32_t)fileWidth == width && (uint32_t)fileHeight == height && (uint32_t)channels == GetTextureFormatTexelSize(texture->GetFormat()))
+			{
+				texels.resize(width * height);
+				for (uint32_t i = 0; i < width * height; i++)
+				{
+					const uint8_t* texel = &data[i * channels];
+					uint8_t r = texel[0];
+					uint8_t g = channels > 1 ? texel[1] : 0;
+					uint8_t b = channels > 2 ? texel[2] : 0;
+					uint8_t a = channels > 3 ? texel[3] : 255;
+					texels[i] = r | (g << 8) | (b << 16) | ((uint32_t)a << 24);
+				}
+			}
+
+			stbi_image_free(data);
+			return texels;
+		}
+
+	}
+
+	SkylinePacker::SkylinePacker(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height)
+	{
+		m_Skyline.push_back({ 0, 0, width });
+	}
+
+	bool SkylinePacker::Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const
+	{
+		if (m_Skyline[index].X + width > m_Width)
+			return false;
+
+		// The rect rests on the highest segment it spans, the segments always cover the full width
+		y = 0;
+		uint32_t remaining = width;
+		for (size_t i = index; remaining > 0; i++)
+		{
+			y = std::max(y, m_Skyline[i].Y);
+			if (y + height > m_Height)
+				return false;
+			remaining -= std::min(remaining, m_Skyline[i].Width);
+		}
+		return true;
+	}
+
+	bool SkylinePacker::Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y)
+	{
+		size_t best = m_Skyline.size();
+		uint32_t bestTop = 0, bestWidth = 0;
+		for (size_t i = 0; i < m_Skyline.size(); i++)
+		{
+			uint32_t fitY;
+			if (!Fit(i, width, height, fitY))
+				continue;
+
+			// Lowest top first, then the narrowest segment, which leaves the wider ones for larger rects
+			uint32_t top = fitY + height;
+			if (best == m_Skyline.size() || top < bestTop || (top == bestTop && m_Skyline[i].Width < bestWidth))
+			{
+				best = i;
+				bestTop = top;
+				bestWidth = m_Skyline[i].Width;
+			}
+		}
+
+		if (best == m_Skyline.size())
+			return false;
+
+		x = m_Skyline[best].X;
+		y = bestTop - height;
+
+		Segment segment = { x, bestTop, width };
+		m_Skyline.insert(m_Skyline.begin() + best, segment);
+
+		// Shrink or remove the segments the new one now covers
+		uint32_t segmentEnd = segment.X + segment.Width;
+		for (size_t i = best + 1; i < m_Skyline.size();)
+		{
+			Segment& next = m_Skyline[i];
+			if (next.X >= segmentEnd)
+				break;
+
+			uint32_t overlap = segmentEnd - next.X;
+			if (overlap < next.Width)
+			{
+				next.X += overlap;
+				next.Width -= overlap;
+				break;
+			}
+			m_Skyline.erase(m_Skyline.begin() + i);
+		}
+
+		// Merge neighbours at the same height
+		for (size_t i = 0; i + 1 < m_Skyline.size();)
+		{
+			if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+			{
+				m_Skyline[i].Width += m_Skyline[i + 1].Width;
+				m_Skyline.erase(m_Skyline.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+
+		m_UsedHeight = std::max(m_UsedHeight, bestTop);
+		return true;
+	}
+
+	TextureAtlas::TextureAtlas(uint32_t pageSize, uint32_t maxTextureSize, uint32_t padding)
+		: m_PageSize(pageSize), m_MaxTextureSize(maxTextureSize), m_Padding(padding)
+	{
+		HZ_CORE_ASSERT(maxTextureSize + 2 * padding <= pageSize, "Atlas textures must fit in a page!");
+
+		for (uint32_t size = 2; size <= padding; size <<= 1)
+			m_MipLevels++;
+	}
+
+	bool TextureAtlas::Add(const Ref<Texture2D>& texture)
+	{
+		bool added = Insert(texture);
+		UpdateMips();
+		return added;
+	}
+
+	void TextureAtlas::Add(std::vector<Ref<Texture2D>> textures)
+	{
+		std::sort(textures.begin(), textures.end(), [](const Ref<Texture2D>& a, const Ref<Texture2D>& b)
+		{
+			if (a->GetHeight() != b->GetHeight())
+				return a->GetHeight() > b->GetHeight();
+			return a->GetWidth() > b->GetWidth();
+		});
+
+		for (const Ref<Texture2D>& texture : textures)
+			Insert(texture);
+		UpdateMips();
+	}
+
+	bool TextureAtlas::Insert(const Ref<Texture2D>& texture)
+	{
+		if (!texture || !texture->IsLoaded() || texture->GetPath().empty())
+			return false;
+
+		if (m_Regions.find(texture) != m_Regions.end())
+			return true;
+
+		if (texture->GetWidth() > m_MaxTextureSize || texture->GetHeight() > m_MaxTextureSize)
+			return false;
+
+		TextureFormat format = texture->GetFormat();
+		if (format != TextureFormat::R8 && format != TextureFormat::RGB8 && format != TextureFormat::RGBA8)
+			return false;
+
+		std::vector<uint32_t> texels = Utils::LoadTexelsRGBA8(texture);
+		if (texels.empty())
+			return false;
+
+		// The whole aligned rect is filled, so the mips of the page's unwritten texels never reach it
+		int width = (int)texture->GetWidth(), height = (int)texture->GetHeight();
+		int padding = (int)m_Padding;
+		uint32_t alignment = std::max(m_Padding, 1u);
+		uint32_t rectWidth = Utils::AlignUp(width + 2 * padding, alignment);
+		uint32_t rectHeight = Utils::AlignUp(height + 2 * padding, alignment);
+
+		uint32_t x, y;
+		size_t pageIndex = 0;
+		for (; pageIndex < m_Pages.size(); pageIndex++)
+		{
+			if (m_Pages[pageIndex].Packer.Insert(rectWidth, rectHeight, x, y))
+				break;
+		}
+
+		if (pageIndex == m_Pages.size())
+		{
+			Page& page = m_Pages.emplace_back(Page{ Texture2D::Create(m_PageSize, m_PageSize, TextureFormat::RGBA8, m_MipLevels), SkylinePacker(m_PageSize, m_PageSize) });
+			bool inserted = page.Packer.Insert(rectWidth, rectHeight, x, y);
+			HZ_CORE_ASSERT(inserted, "Texture does not fit in an empty atlas page!");
+		}
+
+		// Copy the texels and extrude the edges into the padding
+		std::vector<uint32_t> pixels(rectWidth * rectHeight);
+		for (int py = 0; py < (int)rectHeight; py++)
+		{
+			int sourceY = std::clamp(py - padding, 0, height - 1);
+			for (int px = 0; px < (int)rectWidth; px++)
+				pixels[py * rectWidth + px] = texels[sourceY * width + std::clamp(px - padding, 0, width - 1)];
+		}
+
+		Page& page = m_Pages[pageIndex];
+		page.Texture->SetSubData(pixels.data(), x, y, rectWidth, rectHeight);
+		page.MipsDirty = true;
+
+		Region& region = m_Regions[texture];
+		region.Page = page.Texture;
+		region.Rect = {
+			(float)(x + m_Padding) / m_PageSize,
+			(float)(y + m_Padding) / m_PageSize,
+			(float)(x + m_Padding + width) / m_PageSize,
+			(float)(y + m_Padding + height) / m_PageSize
+		};
+		return true;
+	}
+
+	void TextureAtlas::UpdateMips()
+	{
+		for (Page& page : m_Pages)
+		{
+			if (!page.MipsDirty)
+				continue;
+
+			if (m_MipLevels > 1)
+				page.Texture->GenerateMipmaps();
+			page.MipsDirty = false;
+		}
+	}
+
+	void TextureAtlas::Clear()
+	{
+		m_Pages.clear();
+		m_Regions.clear();
+	}
+
+	const TextureAtlas::Region* TextureAtlas::GetRegion(const Ref<Texture2D>& texture) const
+	{
+		auto it = m_Regions.find(texture);
+		return it != m_Regions.end() ? &it->second : nullptr;
+	}
+
+	bool TextureAtlas::Remap(SubTexture2D& subTexture) const
+	{
+		const Region* region = GetRegion(subTexture.GetTexture());
+		if (!region)
+			return false;
+
+		subTexture.Remap(region->Page, { region->Rect.x, region->Rect.y }, { region->Rect.z, region->Rect.w });
+		return true;
+	}
+
+}
@@ -0,0 +1,32 @@
+#include "Hazel/Renderer/UniformBuffer.h"
+
+#include "Hazel/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+namespace Hazel {
+
+	uint32_t UniformBuffer::GetOffsetAlignment()
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return 0;
+			case RendererAPI::API::OpenGL:  return OpenGLUniformBuffer::GetOffsetAlignment();
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return 0;
+	}
+
+	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLUniformBuffer>(size, binding);
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
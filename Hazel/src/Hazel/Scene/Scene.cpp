@@ -1,6 +1,7 @@
 #include "Hazel/Scene/Scene.h"
 
 #include "Hazel/Core/ResourceManager.h"
+#include "Hazel/Core/JobSystem.h"
 #include "Hazel/Scene/Components.h"
 #include "Hazel/Scene/Entity.h"
 #include "Hazel/Scene/ScriptableEntity.h"
@@ -8,10 +9,24 @@
 #include "Hazel/Renderer/Renderer3D.h"
 #include "Hazel/Renderer/RenderCommand.h"
 
+#include <chrono>
+
 namespace Hazel {
 
 	Scene::Scene()
+		: m_SpriteAtlas(CreateRef<TextureAtlas>())
 	{
+		m_Registry.on_destroy<RenderBoundsComponent>().connect<&Scene::OnRenderBoundsDestroy>(*this);
+		m_Registry.on_destroy<SpriteBoundsComponent>().connect<&Scene::OnSpriteBoundsDestroy>(*this);
+		m_Registry.on_construct<SpriteRendererComponent>().connect<&Scene::OnSpriteRendererConstruct>(*this);
+		m_Registry.on_destroy<SpriteRendererComponent>().connect<&Scene::OnSpriteRendererDestroy>(*this);
+		m_Registry.on_update<TransformComponent>().connect<&Scene::OnTransformUpdate>(*this);
+		m_Registry.on_construct<SphereRendererComponent>().connect<&Scene::OnRenderableChange>(*this);
+		m_Registry.on_update<SphereRendererComponent>().connect<&Scene::OnRenderableChange>(*this);
+		m_Registry.on_destroy<SphereRendererComponent>().connect<&Scene::OnRenderableChange>(*this);
+		m_Registry.on_construct<MeshRendererComponent>().connect<&Scene::OnRenderableChange>(*this);
+		m_Registry.on_update<MeshRendererComponent>().connect<&Scene::OnRenderableChange>(*this);
+		m_Registry.on_destroy<MeshRendererComponent>().connect<&Scene::OnRenderableChange>(*this);
 	}
 
 	Scene::~Scene()
@@ -48,6 +63,8 @@ namespace Hazel {
 
 		newScene->m_ViewportWidth = other->m_ViewportWidth;
 		newScene->m_ViewportHeight = other->m_ViewportHeight;
+		newScene->m_OcclusionCulling = other->m_OcclusionCulling;
+		newScene->m_SpriteAtlas = other->m_SpriteAtlas;
 
 		std::unordered_map<UUID, entt::entity> enttMap;
 
@@ -67,6 +84,8 @@ namespace Hazel {
 		CopyComponent<TransformComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
 		CopyComponent<SpriteRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
 		CopyComponent<SphereRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
+		CopyComponent<MeshRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
+		CopyComponent<OccluderComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
 		CopyComponent<PointLightComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
 		CopyComponent<DirectionalLightComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
 		CopyComponent<CameraComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
@@ -140,67 +159,48 @@ namespace Hazel {
 
 		if(mainCamera)
 		{
-			Renderer3D::BeginScene(*mainCamera, cameraTransform);
+			glm::mat4 viewProjection = mainCamera->GetProjection() * glm::inverse(cameraTransform);
+			UpdateRenderBounds();
+			CullRenderables(viewProjection);
+			UpdateSpriteBounds();
+			CullSprites(viewProjection);
 
 			LightParams lightParams = GetLightParams();
+			Renderer3D::BeginScene(*mainCamera, cameraTransform, lightParams);
+
+			// Draw spheres and meshes
+			RecordRenderables();
 
-			// Draw sphere
-			{
-				auto view = m_Registry.view<TransformComponent, SphereRendererComponent>();
-				for (auto entity : view)
-				{
-					auto [transform, sphere] = view.get<TransformComponent, SphereRendererComponent>(entity);
-					Renderer3D::DrawSphere(transform.GetTransform(), sphere, lightParams, (int)entity);
-				}
-			}
-/*
-			// Draw sprites
-			{
-				auto group = m_Registry.view<TransformComponent, SpriteRendererComponent>();
-				for (auto entity : group)
-				{
-					auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
-					Renderer3D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
-				}
-			}
-*/
 			Renderer3D::EndScene();
+
+			// Draw sprites
+			Renderer2D::BeginScene(*mainCamera, cameraTransform);
+			DrawSprites();
+			Renderer2D::EndScene();
 		}
 	}
 
 	void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
 	{
-		Renderer3D::BeginScene(camera);
+		UpdateRenderBounds();
+		CullRenderables(camera.GetViewProjection());
+		UpdateSpriteBounds();
+		CullSprites(camera.GetViewProjection());
 
 		LightParams lightParams = GetLightParams();
+		Renderer3D::BeginScene(camera, lightParams);
 
-		// Draw sphere
-		{
-			auto view = m_Registry.view<TransformComponent, SphereRendererComponent>();
-			for (auto entity : view)
-			{
-				auto [transform, sphere] = view.get<TransformComponent, SphereRendererComponent>(entity);
-				Renderer3D::DrawSphere(transform.GetTransform(), sphere, lightParams, (int)entity);
-			}
-		}
+		// Draw spheres and meshes
+		RecordRenderables();
 
 		Renderer3D::DrawGroundPlane(15, 15, 1.0f);
-/*
-		// Draw sprite
-		{
-			auto view = m_Registry.view<TransformComponent, SpriteRendererComponent>();
-			for (auto entity : view)
-			{
-				auto [transform, sprite] = view.get<TransformComponent, SpriteRendererComponent>(entity);
-				Renderer3D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
-			}
-		}
-*/
-		//Renderer2D::BeginScene(camera);
-		//Renderer2D::DrawQuad(glm::vec3(0.0f), glm::vec3(1.0f), ResourceManager::Get()->Get2DTexture("IBL"));
-		//Renderer2D::EndScene();
 
 		Renderer3D::EndScene();
+
+		// Draw sprites
+		Renderer2D::BeginScene(camera);
+		DrawSprites();
+		Renderer2D::EndScene();
 	}
 
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
@@ -225,6 +225,8 @@ namespace Hazel {
 		CopyComponentIfExists<TransformComponent>(newEntity, entity);
 		CopyComponentIfExists<SpriteRendererComponent>(newEntity, entity);
 		CopyComponentIfExists<SphereRendererComponent>(newEntity, entity);
+		CopyComponentIfExists<MeshRendererComponent>(newEntity, entity);
+		CopyComponentIfExists<OccluderComponent>(newEntity, entity);
 		CopyComponentIfExists<PointLightComponent>(newEntity, entity);
 		CopyComponentIfExists<DirectionalLightComponent>(newEntity, entity);
 		CopyComponentIfExists<CameraComponent>(newEntity, entity);
@@ -243,6 +245,92 @@ namespace Hazel {
 		return {};
 	}
 
+	Entity Scene::RayCast(const Ray& ray, float maxT, float* hitT)
+	{
+		entt::entity closest = entt::null;
+		float closestHit = maxT;
+		m_BoundsTree.RayCast(ray, maxT, [&](uint32_t userData, float closestT)
+		{
+			entt::entity entity = (entt::entity)userData;
+			glm::mat4 transform = m_Registry.get<TransformComponent>(entity).GetTransform();
+			if (glm::determinant(transform) == 0.0f)
+				return closestT;
+
+			// Tested in the entity's local space, the unit sphere and the mesh data are defined there
+			Ray localRay = ray.Transformed(glm::inverse(transform));
+			float t;
+			if (m_Registry.all_of<SphereRendererComponent>(entity) && localRay.IntersectsSphere(glm::vec3(0.0f), 1.0f, closestT, t))
+			{
+				closest = entity;
+				closestT = t;
+			}
+
+			auto* mrc = m_Registry.try_get<MeshRendererComponent>(entity);
+			if (mrc && mrc->Mesh && localRay.Intersects(mrc->Mesh->GetBounds(), closestT, t))
+			{
+				const auto& vertices = mrc->Mesh->GetVertices();
+				const auto& indices = mrc->Mesh->GetIndices();
+				for (size_t i = 0; i + 2 < indices.size(); i += 3)
+				{
+					if (localRay.IntersectsTriangle(vertices[indices[i]].Position, vertices[indices[i + 1]].Position,
+						vertices[indices[i + 2]].Position, closestT, t))
+					{
+						closest = entity;
+						closestT = t;
+					}
+				}
+			}
+			closestHit = closestT;
+			return closestT;
+		});
+
+		// Sprites are flat unit quads, only the part of the ray inside the depth range they span can hit one.
+		// The grid hands out the sprites under that part of the ray.
+		float sliceMin = 0.0f, sliceMax = closestHit;
+		if (ray.Direction.z != 0.0f)
+		{
+			float t0 = (m_SpriteMinZ - ray.Origin.z) / ray.Direction.z;
+			float t1 = (m_SpriteMaxZ - ray.Origin.z) / ray.Direction.z;
+			sliceMin = std::max(sliceMin, std::min(t0, t1));
+			sliceMax = std::min(sliceMax, std::max(t0, t1));
+		}
+		else if (ray.Origin.z < m_SpriteMinZ || ray.Origin.z > m_SpriteMaxZ)
+			sliceMax = -1.0f;
+
+		if (m_SpriteGrid.GetProxyCount() > 0 && sliceMin <= sliceMax)
+		{
+			glm::vec2 a = glm::vec2(ray.GetPoint(sliceMin)), b = glm::vec2(ray.GetPoint(sliceMax));
+			auto& transforms = m_Registry.storage<TransformComponent>();
+			m_SpriteGrid.Query(glm::min(a, b), glm::max(a, b), [&](uint32_t userData)
+			{
+				entt::entity entity = (entt::entity)userData;
+				glm::mat4 transform = transforms.get(entity).GetTransform();
+				if (glm::determinant(transform) == 0.0f)
+					return;
+
+				// The quad spans [-0.5, 0.5] on the local z = 0 plane
+				Ray localRay = ray.Transformed(glm::inverse(transform));
+				if (localRay.Direction.z == 0.0f)
+					return;
+
+				float t = -localRay.Origin.z / localRay.Direction.z;
+				glm::vec3 point = localRay.GetPoint(t);
+				if (t >= 0.0f && t <= closestHit && glm::abs(point.x) <= 0.5f && glm::abs(point.y) <= 0.5f)
+				{
+					closest = entity;
+					closestHit = t;
+				}
+			});
+		}
+
+		if (closest == entt::null)
+			return {};
+
+		if (hitT)
+			*hitT = closestHit;
+		return Entity{ closest, this };
+	}
+
 	LightParams Scene::GetLightParams()
 	{
 		LightParams lightParams;
@@ -253,6 +341,7 @@ namespace Hazel {
 			auto [transform, pointLight] = pointLightView.get<TransformComponent, PointLightComponent>(entity);
 			lightParams.PointLightPositions.push_back(transform.Translation);
 			lightParams.PointLightColors.push_back(pointLight.Color);
+			lightParams.PointLightRanges.push_back(pointLight.Range);
 		}
 		auto directionalLightView = m_Registry.view<TransformComponent, DirectionalLightComponent>();
 		for (auto entity : directionalLightView)
@@ -264,6 +353,444 @@ namespace Hazel {
 		return lightParams;
 	}
 
+	// Object space bounds of everything an entity renders
+	// Takes the registry as const so it never creates storages, which makes it safe to call from the job system
+	static AABB GetLocalRenderBounds(const entt::registry& registry, entt::entity entity)
+	{
+		AABB bounds;
+		bool empty = true;
+		if (registry.all_of<SphereRendererComponent>(entity))
+		{
+			bounds = AABB(glm::vec3(-1.0f), glm::vec3(1.0f));
+			empty = false;
+		}
+		if (auto* mrc = registry.try_get<MeshRendererComponent>(entity); mrc && mrc->Mesh)
+		{
+			bounds = empty ? mrc->Mesh->GetBounds() : AABB::Union(bounds, mrc->Mesh->GetBounds());
+			empty = false;
+		}
+		return bounds;
+	}
+
+	void Scene::UpdateRenderBounds()
+	{
+		// Only the renderables the registry signals reported as added, changed or moved are visited. They can be
+		// listed more than once, or have been destroyed or lost their last renderer component since.
+		std::sort(m_MovedRenderables.begin(), m_MovedRenderables.end());
+		m_MovedRenderables.erase(std::unique(m_MovedRenderables.begin(), m_MovedRenderables.end()), m_MovedRenderables.end());
+		m_MovedRenderables.erase(std::remove_if(m_MovedRenderables.begin(), m_MovedRenderables.end(), [&](entt::entity entity)
+		{
+			if (!m_Registry.valid(entity))
+				return true;
+
+			if (!m_Registry.any_of<SphereRendererComponent, MeshRendererComponent>(entity))
+			{
+				m_Registry.remove<RenderBoundsComponent>(entity);
+				return true;
+			}
+			return !m_Registry.all_of<TransformComponent>(entity);
+		}), m_MovedRenderables.end());
+
+		if (m_MovedRenderables.empty())
+			return;
+
+		for (entt::entity entity : m_MovedRenderables)
+		{
+			if (!m_Registry.all_of<RenderBoundsComponent>(entity))
+				m_Registry.emplace<RenderBoundsComponent>(entity);
+		}
+
+		// The new bounds are computed on the job system, only the tree updates stay serial
+		auto& transforms = m_Registry.storage<TransformComponent>();
+		auto& renderBounds = m_Registry.storage<RenderBoundsComponent>();
+		const entt::registry& registry = m_Registry;
+
+		uint32_t threadCount = JobSystem::GetThreadCount();
+		if (m_BoundsUpdates.size() < threadCount)
+			m_BoundsUpdates.resize(threadCount);
+		for (auto& updates : m_BoundsUpdates)
+			updates.clear();
+
+		JobSystem::ParallelFor((uint32_t)m_MovedRenderables.size(), RecordBatchSize, [&](uint32_t begin, uint32_t end, uint32_t thread)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				entt::entity entity = m_MovedRenderables[i];
+				AABB localBounds = GetLocalRenderBounds(registry, entity);
+				m_BoundsUpdates[thread].push_back({ entity, localBounds, localBounds.Transformed(transforms.get(entity).GetTransform()) });
+			}
+		});
+		m_MovedRenderables.clear();
+
+		for (const auto& updates : m_BoundsUpdates)
+		{
+			for (const RenderBoundsUpdate& update : updates)
+			{
+				const TransformComponent& transform = transforms.get(update.Entity);
+				RenderBoundsComponent& bounds = renderBounds.get(update.Entity);
+				bounds.LocalBounds = update.LocalBounds;
+				if (bounds.ProxyID == -1)
+					bounds.ProxyID = m_BoundsTree.CreateProxy(update.WorldBounds, (uint32_t)update.Entity);
+				else
+					m_BoundsTree.MoveProxy(bounds.ProxyID, update.WorldBounds, transform.Translation - bounds.Translation);
+
+				bounds.Translation = transform.Translation;
+			}
+		}
+	}
+
+	void Scene::CullRenderables(const glm::mat4& viewProjection)
+	{
+		m_VisibleEntities.clear();
+		m_BoundsTree.Query(Frustum(viewProjection), [this](uint32_t userData)
+		{
+			m_VisibleEntities.push_back((entt::entity)userData);
+		});
+
+		m_Stats.OccludedRenderables = 0;
+		m_Stats.Occluders = 0;
+		m_Stats.OcclusionRasterTime = 0.0f;
+		m_Stats.OcclusionTestTime = 0.0f;
+		if (m_OcclusionCulling)
+			CullOccluded(viewProjection);
+
+		m_Stats.VisibleRenderables = (uint32_t)m_VisibleEntities.size();
+		m_Stats.CulledRenderables = m_BoundsTree.GetProxyCount() - m_Stats.VisibleRenderables;
+	}
+
+	void Scene::CullOccluded(const glm::mat4& viewProjection)
+	{
+		auto rasterStart = std::chrono::high_resolution_clock::now();
+		m_OcclusionCuller.Begin(viewProjection);
+		auto occluderView = m_Registry.view<TransformComponent, OccluderComponent>();
+		for (auto entity : occluderView)
+		{
+			auto [transform, occluder] = occluderView.get<TransformComponent, OccluderComponent>(entity);
+			m_OcclusionCuller.AddOccluder(occluder.Bounds, transform.GetTransform());
+		}
+		m_Stats.Occluders = m_OcclusionCuller.GetOccluderCount();
+		if (m_Stats.Occluders == 0)
+			return;
+
+		m_OcclusionCuller.Rasterize();
+		auto testStart = std::chrono::high_resolution_clock::now();
+
+		// Tested against the tight world bounds, the tree's fat ones would hide less
+		auto& transforms = m_Registry.storage<TransformComponent>();
+		auto& renderBounds = m_Registry.storage<RenderBoundsComponent>();
+		m_Occluded.resize(m_VisibleEntities.size());
+		JobSystem::ParallelFor((uint32_t)m_VisibleEntities.size(), RecordBatchSize, [&](uint32_t begin, uint32_t end, uint32_t thread)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				entt::entity entity = m_VisibleEntities[i];
+				AABB bounds = renderBounds.get(entity).LocalBounds.Transformed(transforms.get(entity).GetTransform());
+				m_Occluded[i] = m_OcclusionCuller.IsOccluded(bounds);
+			}
+		});
+
+		size_t visibleCount = 0;
+		for (size_t i = 0; i < m_VisibleEntities.size(); i++)
+		{
+			if (!m_Occluded[i])
+				m_VisibleEntities[visibleCount++] = m_VisibleEntities[i];
+		}
+		m_Stats.OccludedRenderables = (uint32_t)(m_VisibleEntities.size() - visibleCount);
+		m_VisibleEntities.resize(visibleCount);
+
+		auto testEnd = std::chrono::high_resolution_clock::now();
+		m_Stats.OcclusionRasterTime = std::chrono::duration<float, std::milli>(testStart - rasterStart).count();
+		m_Stats.OcclusionTestTime = std::chrono::duration<float, std::milli>(testEnd - testStart).count();
+	}
+
+	void Scene::RecordRenderables()
+	{
+		// Storages are looked up here, on the main thread, since the registry may create them on first access
+		auto& transforms = m_Registry.storage<TransformComponent>();
+		auto& spheres = m_Registry.storage<SphereRendererComponent>();
+		auto& meshes = m_Registry.storage<MeshRendererComponent>();
+
+		Renderer3D::BeginRecording(JobSystem::GetThreadCount());
+		JobSystem::ParallelFor((uint32_t)m_VisibleEntities.size(), RecordBatchSize, [&](uint32_t begin, uint32_t end, uint32_t thread)
+		{
+			auto recordStart = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = begin; i < end; i++)
+			{
+				entt::entity entity = m_VisibleEntities[i];
+				glm::mat4 transform = transforms.get(entity).GetTransform();
+				if (spheres.contains(entity))
+					Renderer3D::RecordSphere(thread, transform, spheres.get(entity), (int)entity);
+				if (meshes.contains(entity))
+					Renderer3D::RecordMesh(thread, transform, meshes.get(entity), (int)entity);
+			}
+			auto recordEnd = std::chrono::high_resolution_clock::now();
+			Renderer3D::AddRecordTime(thread, std::chrono::duration<float, std::milli>(recordEnd - recordStart).count());
+		});
+		Renderer3D::SubmitRecorded();
+	}
+
+	// Sprites are unit quads in the xy plane of their transform
+	static const AABB s_SpriteLocalBounds = AABB(glm::vec3(-0.5f, -0.5f, 0.0f), glm::vec3(0.5f, 0.5f, 0.0f));
+
+	void Scene::UpdateSpriteBounds()
+	{
+		// Only the sprites the registry signals reported as added or moved are visited. They can be listed
+		// more than once, or have been destroyed or lost their sprite renderer since.
+		auto& transforms = m_Registry.storage<TransformComponent>();
+		auto& sprites = m_Registry.storage<SpriteRendererComponent>();
+		std::sort(m_MovedSprites.begin(), m_MovedSprites.end());
+		m_MovedSprites.erase(std::unique(m_MovedSprites.begin(), m_MovedSprites.end()), m_MovedSprites.end());
+		m_MovedSprites.erase(std::remove_if(m_MovedSprites.begin(), m_MovedSprites.end(), [&](entt::entity entity)
+		{
+			return !sprites.contains(entity) || !transforms.contains(entity);
+		}), m_MovedSprites.end());
+
+		if (m_MovedSprites.empty())
+			return;
+
+		for (entt::entity entity : m_MovedSprites)
+		{
+			if (!m_Registry.all_of<SpriteBoundsComponent>(entity))
+				m_Registry.emplace<SpriteBoundsComponent>(entity);
+		}
+		auto& spriteBounds = m_Registry.storage<SpriteBoundsComponent>();
+
+		uint32_t threadCount = JobSystem::GetThreadCount();
+		if (m_SpriteBoundsUpdates.size() < threadCount)
+			m_SpriteBoundsUpdates.resize(threadCount);
+		for (auto& updates : m_SpriteBoundsUpdates)
+		{
+			updates.Moved.clear();
+			updates.MinZ = std::numeric_limits<float>::max();
+			updates.MaxZ = std::numeric_limits<float>::lowest();
+		}
+
+		JobSystem::ParallelFor((uint32_t)m_MovedSprites.size(), RecordBatchSize, [&](uint32_t begin, uint32_t end, uint32_t thread)
+		{
+			SpriteBoundsUpdates& updates = m_SpriteBoundsUpdates[thread];
+			for (uint32_t i = begin; i < end; i++)
+			{
+				entt::entity entity = m_MovedSprites[i];
+				AABB worldBounds = s_SpriteLocalBounds.Transformed(transforms.get(entity).GetTransform());
+				updates.Moved.push_back({ entity, worldBounds });
+				updates.MinZ = std::min(updates.MinZ, worldBounds.Min.z);
+				updates.MaxZ = std::max(updates.MaxZ, worldBounds.Max.z);
+			}
+		});
+		m_MovedSprites.clear();
+
+		// The depth range only grows, a sprite leaving its edge would need all the others to find the new one.
+		// It starts over once the grid is empty.
+		if (m_SpriteGrid.GetProxyCount() == 0)
+		{
+			m_SpriteMinZ = std::numeric_limits<float>::max();
+			m_SpriteMaxZ = std::numeric_limits<float>::lowest();
+		}
+
+		for (const auto& updates : m_SpriteBoundsUpdates)
+		{
+			m_SpriteMinZ = std::min(m_SpriteMinZ, updates.MinZ);
+			m_SpriteMaxZ = std::max(m_SpriteMaxZ, updates.MaxZ);
+
+			for (const auto& update : updates.Moved)
+			{
+				SpriteBoundsComponent& bounds = spriteBounds.get(update.Entity);
+				glm::vec2 min = glm::vec2(update.WorldBounds.Min), max = glm::vec2(update.WorldBounds.Max);
+				if (bounds.ProxyID == -1)
+					bounds.ProxyID = m_SpriteGrid.CreateProxy(min, max, (uint32_t)update.Entity);
+				else
+					m_SpriteGrid.MoveProxy(bounds.ProxyID, min, max);
+
+				bounds.WorldBounds = update.WorldBounds;
+			}
+		}
+	}
+
+	// xy bounds of the part of the view volume between two depths, false if the view doesn't reach them.
+	// The clipped volume's corners are the view corners inside the slab plus the points where the view edges cross it.
+	static bool GetViewRect(const glm::mat4& viewProjection, float minZ, float maxZ, glm::vec2& min, glm::vec2& max)
+	{
+		glm::mat4 inverse = glm::inverse(viewProjection);
+		glm::vec3 corners[8];
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec4 corner = inverse * glm::vec4(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f);
+			corners[i] = glm::vec3(corner) / corner.w;
+		}
+
+		min = glm::vec2(std::numeric_limits<float>::max());
+		max = glm::vec2(std::numeric_limits<float>::lowest());
+		bool found = false;
+		auto add = [&](const glm::vec3& point)
+		{
+			min = glm::min(min, glm::vec2(point));
+			max = glm::max(max, glm::vec2(point));
+			found = true;
+		};
+
+		for (const glm::vec3& corner : corners)
+		{
+			if (corner.z >= minZ && corner.z <= maxZ)
+				add(corner);
+		}
+
+		static const uint32_t edges[12][2] = {
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+			{ 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+			{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+		};
+		for (const auto& edge : edges)
+		{
+			const glm::vec3& a = corners[edge[0]];
+			const glm::vec3& b = corners[edge[1]];
+			for (float z : { minZ, maxZ })
+			{
+				if (a.z == b.z || (a.z - z) * (b.z - z) > 0.0f)
+					continue;
+				add(a + (b - a) * ((z - a.z) / (b.z - a.z)));
+			}
+		}
+		return found;
+	}
+
+	void Scene::CullSprites(const glm::mat4& viewProjection)
+	{
+		m_VisibleSprites.clear();
+
+		glm::vec2 min, max;
+		if (m_SpriteGrid.GetProxyCount() > 0 && GetViewRect(viewProjection, m_SpriteMinZ, m_SpriteMaxZ, min, max))
+		{
+			// The rect covers the whole slab, the frustum test drops what it only touches on some depths
+			Frustum frustum(viewProjection);
+			auto& spriteBounds = m_Registry.storage<SpriteBoundsComponent>();
+			m_SpriteGrid.Query(min, max, [&](uint32_t userData)
+			{
+				entt::entity entity = (entt::entity)userData;
+				if (frustum.Intersects(spriteBounds.get(entity).WorldBounds))
+					m_VisibleSprites.push_back(entity);
+			});
+
+			// Cells come back in no particular order, sorted so overlapping sprites keep their draw order
+			std::sort(m_VisibleSprites.begin(), m_VisibleSprites.end());
+		}
+
+		m_Stats.VisibleSprites = (uint32_t)m_VisibleSprites.size();
+		m_Stats.CulledSprites = m_SpriteGrid.GetProxyCount() - m_Stats.VisibleSprites;
+	}
+
+	void Scene::DrawSprites()
+	{
+		// Sized once, then filled in place. Textures are passed as raw pointers, the components hold the references.
+		size_t count = m_VisibleSprites.size();
+		m_Sprites.Transforms.resize(count);
+		m_Sprites.Colors.resize(count);
+		m_Sprites.Textures.resize(count);
+		m_Sprites.TexRects.resize(count);
+		m_Sprites.TilingFactors.resize(count);
+		m_Sprites.EntityIDs.resize(count);
+
+		auto& transforms = m_Registry.storage<TransformComponent>();
+		auto& sprites = m_Registry.storage<SpriteRendererComponent>();
+		for (size_t i = 0; i < count; i++)
+		{
+			entt::entity entity = m_VisibleSprites[i];
+			const SpriteRendererComponent& sprite = sprites.get(entity);
+
+			// Tiling would wrap into the neighbours in the atlas
+			bool atlased = sprite.AtlasPage && sprite.AtlasSource == sprite.Texture && sprite.TilingFactor == 1.0f;
+			m_Sprites.Transforms[i] = transforms.get(entity).GetTransform();
+			m_Sprites.Colors[i] = sprite.Color;
+			m_Sprites.Textures[i] = atlased ? sprite.AtlasPage.get() : sprite.Texture.get();
+			m_Sprites.TexRects[i] = atlased ? sprite.AtlasRect : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+			m_Sprites.TilingFactors[i] = sprite.TilingFactor;
+			m_Sprites.EntityIDs[i] = (int)entity;
+		}
+
+		if (!m_Sprites.Transforms.empty())
+		{
+			Renderer2D::DrawQuads((uint32_t)m_Sprites.Transforms.size(), m_Sprites.Transforms.data(), m_Sprites.Colors.data(),
+				m_Sprites.Textures.data(), m_Sprites.TexRects.data(), m_Sprites.TilingFactors.data(), m_Sprites.EntityIDs.data());
+		}
+
+		m_Stats.AtlasPages = m_SpriteAtlas->GetPageCount();
+		m_Stats.AtlasTextures = m_SpriteAtlas->GetTextureCount();
+	}
+
+	void Scene::SetSpriteTexture(Entity entity, const Ref<Texture2D>& texture)
+	{
+		auto& sprite = entity.GetComponent<SpriteRendererComponent>();
+		sprite.Texture = texture;
+		m_SpriteAtlas->Add(texture);
+		SetSpriteAtlasRegion(sprite);
+	}
+
+	void Scene::PackSprites()
+	{
+		auto view = m_Registry.view<SpriteRendererComponent>();
+		std::vector<Ref<Texture2D>> textures;
+		for (auto entity : view)
+		{
+			const auto& sprite = view.get<SpriteRendererComponent>(entity);
+			if (sprite.Texture && sprite.AtlasSource != sprite.Texture && !m_SpriteAtlas->GetRegion(sprite.Texture)
+				&& std::find(textures.begin(), textures.end(), sprite.Texture) == textures.end())
+				textures.push_back(sprite.Texture);
+		}
+		if (!textures.empty())
+			m_SpriteAtlas->Add(std::move(textures));
+
+		for (auto entity : view)
+		{
+			auto& sprite = view.get<SpriteRendererComponent>(entity);
+			if (sprite.AtlasSource != sprite.Texture)
+				SetSpriteAtlasRegion(sprite);
+		}
+	}
+
+	void Scene::SetSpriteAtlasRegion(SpriteRendererComponent& sprite)
+	{
+		const TextureAtlas::Region* region = sprite.Texture ? m_SpriteAtlas->GetRegion(sprite.Texture) : nullptr;
+		sprite.AtlasSource = sprite.Texture;
+		sprite.AtlasPage = region ? region->Page : nullptr;
+		sprite.AtlasRect = region ? region->Rect : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	}
+
+	void Scene::OnRenderBoundsDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto& bounds = registry.get<RenderBoundsComponent>(entity);
+		if (bounds.ProxyID != -1)
+			m_BoundsTree.DestroyProxy(bounds.ProxyID);
+	}
+
+	void Scene::OnSpriteRendererConstruct(entt::registry& registry, entt::entity entity)
+	{
+		m_MovedSprites.push_back(entity);
+	}
+
+	void Scene::OnSpriteRendererDestroy(entt::registry& registry, entt::entity entity)
+	{
+		registry.remove<SpriteBoundsComponent>(entity);
+	}
+
+	void Scene::OnRenderableChange(entt::registry& registry, entt::entity entity)
+	{
+		m_MovedRenderables.push_back(entity);
+	}
+
+	void Scene::OnTransformUpdate(entt::registry& registry, entt::entity entity)
+	{
+		if (registry.all_of<SpriteRendererComponent>(entity))
+			m_MovedSprites.push_back(entity);
+		if (registry.any_of<SphereRendererComponent, MeshRendererComponent>(entity))
+			m_MovedRenderables.push_back(entity);
+	}
+
+	void Scene::OnSpriteBoundsDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto& bounds = registry.get<SpriteBoundsComponent>(entity);
+		if (bounds.ProxyID != -1)
+			m_SpriteGrid.DestroyProxy(bounds.ProxyID);
+	}
+
 	template<typename T>
 	void Scene::OnComponentAdded(Entity entity, T& component)
 	{
@@ -296,6 +823,16 @@ namespace Hazel {
 	{
 	}
 
+	template<>
+	void Scene::OnComponentAdded<MeshRendererComponent>(Entity entity, MeshRendererComponent& component)
+	{
+	}
+
+	template<>
+	void Scene::OnComponentAdded<OccluderComponent>(Entity entity, OccluderComponent& component)
+	{
+	}
+
 	template<>
 	void Scene::OnComponentAdded<PointLightComponent>(Entity entity, PointLightComponent& component)
 	{
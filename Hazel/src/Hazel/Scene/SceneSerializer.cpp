@@ -2,6 +2,7 @@
 
 #include "Hazel/Scene/Entity.h"
 #include "Hazel/Scene/Components.h"
+#include "Hazel/Core/ResourceManager.h"
 
 #include <fstream>
 #include <yaml-cpp/yaml.h>
@@ -147,6 +148,35 @@ namespace Hazel {
 			out << YAML::EndMap; // SpriteRendererComponent
 		}
 
+		if (entity.HasComponent<MeshRendererComponent>())
+		{
+			out << YAML::Key << "MeshRendererComponent";
+			out << YAML::BeginMap; // MeshRendererComponent
+
+			auto& meshRendererComponent = entity.GetComponent<MeshRendererComponent>();
+			auto& material = meshRendererComponent.Material;
+			out << YAML::Key << "Mesh" << YAML::Value << (meshRendererComponent.Mesh ? meshRendererComponent.Mesh->GetPath() : std::string());
+			out << YAML::Key << "Albedo" << YAML::Value << material.Albedo;
+			out << YAML::Key << "Metallic" << YAML::Value << material.Metallic;
+			out << YAML::Key << "Roughness" << YAML::Value << material.Roughness;
+			out << YAML::Key << "Ao" << YAML::Value << material.Ao;
+			out << YAML::Key << "Opacity" << YAML::Value << material.Opacity;
+
+			out << YAML::EndMap; // MeshRendererComponent
+		}
+
+		if (entity.HasComponent<OccluderComponent>())
+		{
+			out << YAML::Key << "OccluderComponent";
+			out << YAML::BeginMap; // OccluderComponent
+
+			auto& occluderComponent = entity.GetComponent<OccluderComponent>();
+			out << YAML::Key << "Min" << YAML::Value << occluderComponent.Bounds.Min;
+			out << YAML::Key << "Max" << YAML::Value << occluderComponent.Bounds.Max;
+
+			out << YAML::EndMap; // OccluderComponent
+		}
+
 		out << YAML::EndMap; // Entity
 	}
 
@@ -155,6 +185,7 @@ namespace Hazel {
 		YAML::Emitter out;
 		out << YAML::BeginMap;
 		out << YAML::Key << "Scene" << YAML::Value << "Untitled";
+		out << YAML::Key << "OcclusionCulling" << YAML::Value << m_Scene->IsOcclusionCullingEnabled();
 		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
 
 		for (auto entityID : m_Scene->m_Registry.view<entt::entity>())
@@ -191,6 +222,9 @@ namespace Hazel {
 		std::string sceneName = data["Scene"].as<std::string>();
 		HZ_CORE_TRACE("Deserializing scene '{0}'", sceneName);
 
+		if (auto occlusionCulling = data["OcclusionCulling"])
+			m_Scene->SetOcclusionCulling(occlusionCulling.as<bool>());
+
 		auto entities = data["Entities"];
 		if (entities)
 		{
@@ -243,9 +277,32 @@ namespace Hazel {
 					auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
 					src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
 				}
+
+				auto meshRendererComponent = entity["MeshRendererComponent"];
+				if (meshRendererComponent)
+				{
+					auto& mrc = deserializedEntity.AddComponent<MeshRendererComponent>();
+					auto meshPath = meshRendererComponent["Mesh"].as<std::string>();
+					if (!meshPath.empty())
+						mrc.Mesh = ResourceManager::Get()->GetMesh(meshPath);
+					mrc.Material.Albedo = meshRendererComponent["Albedo"].as<glm::vec3>();
+					mrc.Material.Metallic = meshRendererComponent["Metallic"].as<float>();
+					mrc.Material.Roughness = meshRendererComponent["Roughness"].as<float>();
+					mrc.Material.Ao = meshRendererComponent["Ao"].as<float>();
+					mrc.Material.Opacity = meshRendererComponent["Opacity"].as<float>();
+				}
+
+				auto occluderComponent = entity["OccluderComponent"];
+				if (occluderComponent)
+				{
+					auto& oc = deserializedEntity.AddComponent<OccluderComponent>();
+					oc.Bounds.Min = occluderComponent["Min"].as<glm::vec3>();
+					oc.Bounds.Max = occluderComponent["Max"].as<glm::vec3>();
+				}
 			}
 		}
 
+		m_Scene->PackSprites();
 		return true;
 	}
 
@@ -109,6 +109,14 @@ namespace Hazel {
 		glDeleteFramebuffers(1, &m_RendererID);
 		glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
 		glDeleteRenderbuffers(1, &m_DepthAttachment);
+
+		for (ReadbackSlot& slot : m_ReadbackSlots)
+		{
+			if (slot.Fence)
+				glDeleteSync((GLsync)slot.Fence);
+			if (slot.Buffer)
+				glDeleteBuffers(1, &slot.Buffer);
+		}
 	}
 
 	void OpenGLFrameBuffer::Invalidate()
@@ -215,6 +223,90 @@ namespace Hazel {
 		return pixelData;
 	}
 
+	uint32_t OpenGLFrameBuffer::ReadPixelsAsync(uint32_t attachmentIndex, int x, int y, uint32_t width, uint32_t height)
+	{
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+		HZ_CORE_ASSERT(m_ColorAttachmentSpecifications[attachmentIndex].TextureFormat == FramebufferTextureFormat::RED_INTEGER);
+
+		PixelReadback request;
+		request.RequestID = m_NextReadbackID++;
+		int x0 = std::max(x, 0), y0 = std::max(y, 0);
+		int x1 = std::min(x + (int)width, (int)m_Specification.Width), y1 = std::min(y + (int)height, (int)m_Specification.Height);
+		request.X = x0;
+		request.Y = y0;
+		request.Width = (uint32_t)std::max(x1 - x0, 0);
+		request.Height = (uint32_t)std::max(y1 - y0, 0);
+
+		if (request.Width == 0 || request.Height == 0)
+		{
+			request.Width = request.Height = 0;
+			m_FinishedReadbacks.push_back(std::move(request));
+			return m_FinishedReadbacks.back().RequestID;
+		}
+
+		// Only wait when every slot is still in flight, by then the oldest copy is a few frames old
+		if (m_PendingReadbackCount == ReadbackSlotCount)
+			RetireReadback(true);
+
+		ReadbackSlot& slot = m_ReadbackSlots[(m_FirstPendingReadback + m_PendingReadbackCount) % ReadbackSlotCount];
+		uint32_t size = request.Width * request.Height * sizeof(int);
+		if (slot.Size < size)
+		{
+			if (slot.Buffer)
+				glDeleteBuffers(1, &slot.Buffer);
+			glCreateBuffers(1, &slot.Buffer);
+			glNamedBufferData(slot.Buffer, size, nullptr, GL_STREAM_READ);
+			slot.Size = size;
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+		glReadPixels(request.X, request.Y, request.Width, request.Height, GL_RED_INTEGER, GL_INT, nullptr);
+		glReadBuffer(GL_COLOR_ATTACHMENT0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.Result = std::move(request);
+		m_PendingReadbackCount++;
+		return slot.Result.RequestID;
+	}
+
+	bool OpenGLFrameBuffer::PollReadPixels(PixelReadback& result)
+	{
+		while (m_PendingReadbackCount > 0)
+		{
+			GLsync fence = (GLsync)m_ReadbackSlots[m_FirstPendingReadback].Fence;
+			GLenum status = glClientWaitSync(fence, 0, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+				break;
+
+			RetireReadback(false);
+		}
+
+		if (m_FinishedReadbacks.empty())
+			return false;
+
+		result = std::move(m_FinishedReadbacks.front());
+		m_FinishedReadbacks.pop_front();
+		return true;
+	}
+
+	void OpenGLFrameBuffer::RetireReadback(bool wait)
+	{
+		ReadbackSlot& slot = m_ReadbackSlots[m_FirstPendingReadback];
+		if (wait)
+			glClientWaitSync((GLsync)slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+		glDeleteSync((GLsync)slot.Fence);
+		slot.Fence = nullptr;
+
+		PixelReadback& result = m_FinishedReadbacks.emplace_back(std::move(slot.Result));
+		result.Pixels.resize((size_t)result.Width * result.Height);
+		glGetNamedBufferSubData(slot.Buffer, 0, result.Pixels.size() * sizeof(int), result.Pixels.data());
+
+		m_FirstPendingReadback = (m_FirstPendingReadback + 1) % ReadbackSlotCount;
+		m_PendingReadbackCount--;
+	}
+
 	void OpenGLFrameBuffer::ClearAttachment(uint32_t attachmentIndex, int value)
 	{
 		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
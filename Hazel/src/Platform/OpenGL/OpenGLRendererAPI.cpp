@@ -4,6 +4,21 @@
 
 namespace Hazel {
 
+	namespace Utils {
+
+		static GLenum IndexTypeToGLType(IndexType type)
+		{
+			switch (type)
+			{
+				case IndexType::UInt16: return GL_UNSIGNED_SHORT;
+				case IndexType::UInt32: return GL_UNSIGNED_INT;
+			}
+			HZ_CORE_ASSERT(false, "Unknown index type!");
+			return 0;
+		}
+
+	}
+
 	void OpenGLRendererAPI::Init()
 	{
 		glEnable(GL_BLEND);
@@ -35,17 +50,26 @@ namespace Hazel {
 		glDrawArrays(GL_TRIANGLES, 0, vertexCount);
 	}
 
-	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
 	{
 		vertexArray->Bind();
-		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+		uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+		glDrawElementsBaseVertex(GL_TRIANGLES, count, Utils::IndexTypeToGLType(indexBuffer->GetIndexType()), nullptr, baseVertex);
 	}
 
-	void OpenGLRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance)
 	{
 		vertexArray->Bind();
-		glDrawArrays(GL_LINES, 0, vertexCount);
+		const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+		uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, Utils::IndexTypeToGLType(indexBuffer->GetIndexType()), nullptr, instanceCount, baseInstance);
+	}
+
+	void OpenGLRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex)
+	{
+		vertexArray->Bind();
+		glDrawArrays(GL_LINES, firstVertex, vertexCount);
 	}
 
 	void OpenGLRendererAPI::SetLineWidth(float width)
@@ -65,4 +89,9 @@ namespace Hazel {
 		glDepthMask(GL_FALSE);
 	}
 
+	void OpenGLRendererAPI::SetDepthWrite(bool enabled)
+	{
+		glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "Platform/OpenGL/OpenGLRingBuffer.h"
+
+#include <glad/glad.h>
+
+namespace Hazel {
+
+	OpenGLRingBuffer::OpenGLRingBuffer(uint32_t segmentSize)
+		: m_SegmentSize(segmentSize)
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, (GLsizeiptr)segmentSize * SegmentCount, nullptr, flags);
+		m_MappedData = (uint8_t*)glMapNamedBufferRange(m_RendererID, 0, (GLsizeiptr)segmentSize * SegmentCount, flags);
+		HZ_CORE_ASSERT(m_MappedData, "Failed to map ring buffer!");
+	}
+
+	OpenGLRingBuffer::~OpenGLRingBuffer()
+	{
+		for (void* fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync((GLsync)fence);
+		}
+
+		glUnmapNamedBuffer(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	RingBuffer::Allocation OpenGLRingBuffer::Reserve(uint32_t size, uint32_t alignment)
+	{
+		HZ_CORE_ASSERT(size <= m_SegmentSize, "Allocation is larger than a ring buffer segment!");
+
+		uint32_t offset = (m_Head + alignment - 1) / alignment * alignment;
+		if (offset + size > (m_Segment + 1) * m_SegmentSize)
+		{
+			NextSegment();
+			offset = (m_Head + alignment - 1) / alignment * alignment;
+			HZ_CORE_ASSERT(offset + size <= (m_Segment + 1) * m_SegmentSize, "Alignment pushes the allocation out of the segment!");
+		}
+
+		m_Reserved = offset;
+		return { m_MappedData + offset, offset, size };
+	}
+
+	RingBuffer::Allocation OpenGLRingBuffer::ReserveAvailable(uint32_t minSize, uint32_t maxSize, uint32_t alignment)
+	{
+		HZ_CORE_ASSERT(minSize <= maxSize && maxSize <= m_SegmentSize, "Allocation is larger than a ring buffer segment!");
+
+		uint32_t offset = (m_Head + alignment - 1) / alignment * alignment;
+		if (offset + minSize > (m_Segment + 1) * m_SegmentSize)
+		{
+			NextSegment();
+			offset = (m_Head + alignment - 1) / alignment * alignment;
+			HZ_CORE_ASSERT(offset + minSize <= (m_Segment + 1) * m_SegmentSize, "Alignment pushes the allocation out of the segment!");
+		}
+
+		uint32_t size = std::min(maxSize, (m_Segment + 1) * m_SegmentSize - offset);
+		m_Reserved = offset;
+		return { m_MappedData + offset, offset, size };
+	}
+
+	void OpenGLRingBuffer::Commit(uint32_t size)
+	{
+		m_Head = m_Reserved + size;
+	}
+
+	void OpenGLRingBuffer::NextSegment()
+	{
+		// Every draw reading the segment has been issued by now, so this fence covers them all
+		m_Fences[m_Segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_Segment = (m_Segment + 1) % SegmentCount;
+		m_Head = m_Segment * m_SegmentSize;
+
+		GLsync fence = (GLsync)m_Fences[m_Segment];
+		if (!fence)
+			return;
+
+		GLenum status = glClientWaitSync(fence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			m_StallCount++;
+			while (status == GL_TIMEOUT_EXPIRED)
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+		}
+		glDeleteSync(fence);
+		m_Fences[m_Segment] = nullptr;
+	}
+
+	void OpenGLRingBuffer::SetData(const void* data, uint32_t size)
+	{
+		HZ_CORE_ASSERT(false, "Ring buffers are written through Reserve!");
+	}
+
+	void OpenGLRingBuffer::Bind() const
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+	}
+
+	void OpenGLRingBuffer::Unbind() const
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+}
@@ -100,57 +100,113 @@ namespace Hazel {
 		return m_Name;
 	}
 
+	UniformHandle OpenGLShader::GetUniformHandle(const std::string& name)
+	{
+		return { GetUniformLocation(name) };
+	}
+
+	void OpenGLShader::SetInt(UniformHandle handle, int value)
+	{
+		glUniform1i(handle.Location, value);
+	}
+
+	void OpenGLShader::SetIntArray(UniformHandle handle, int* values, uint32_t count)
+	{
+		glUniform1iv(handle.Location, count, values);
+	}
+
+	void OpenGLShader::SetFloat(UniformHandle handle, float value)
+	{
+		glUniform1f(handle.Location, value);
+	}
+
+	void OpenGLShader::SetFloat2(UniformHandle handle, const glm::vec2& value)
+	{
+		glUniform2f(handle.Location, value.x, value.y);
+	}
+
+	void OpenGLShader::SetFloat3(UniformHandle handle, const glm::vec3& value)
+	{
+		glUniform3f(handle.Location, value.x, value.y, value.z);
+	}
+
+	void OpenGLShader::SetFloat3Array(UniformHandle handle, float* values, uint32_t count)
+	{
+		glUniform3fv(handle.Location, count, values);
+	}
+
+	void OpenGLShader::SetFloat4(UniformHandle handle, const glm::vec4& value)
+	{
+		glUniform4f(handle.Location, value.x, value.y, value.z, value.w);
+	}
+
+	void OpenGLShader::SetMat4(UniformHandle handle, const glm::mat4& value)
+	{
+		glUniformMatrix4fv(handle.Location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	int OpenGLShader::GetUniformLocation(const std::string& name)
+	{
+		auto it = m_UniformLocations.find(name);
+		if (it != m_UniformLocations.end())
+			return it->second;
+
+		if (m_MissingUniforms.insert(name).second)
+			HZ_CORE_WARN("Shader '{0}': uniform '{1}' is not an active uniform", m_Name, name);
+		return -1;
+	}
+
 	void OpenGLShader::UploadUniformInt(const std::string& name, int value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1i(location, value);
 	}
 
 	void OpenGLShader::UploadUniformIntArray(const std::string& name, int* values, uint32_t count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1iv(location, count, values);
 	}
 
 	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1f(location, value);
 	}
 
 	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& values)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform2f(location, values.x, values.y);
 	}
 
 	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& values)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform3f(location, values.x, values.y, values.z);
 	}
 
 	void OpenGLShader::UploadUniformFloat3Array(const std::string& name, float* values, uint32_t count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform3fv(location, count, values);
 	}
 
 	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& values)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform4f(location, values.x, values.y, values.z, values.w);
 	}
 
 	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
 	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
@@ -265,5 +321,49 @@ namespace Hazel {
 			glDetachShader(program, id);
 
 		m_RendererID = program;
+
+		ReflectUniforms();
+	}
+
+	void OpenGLShader::ReflectUniforms()
+	{
+		m_UniformLocations.clear();
+
+		GLint uniformCount = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		GLint maxNameLength = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> nameBuffer(maxNameLength + 1);
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLint size = 0;
+			GLenum type = 0;
+			GLsizei length = 0;
+			glGetActiveUniform(m_RendererID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+
+			std::string name(nameBuffer.data(), length);
+			GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+			// Members of uniform blocks have no location
+			if (location == -1)
+				continue;
+
+			// Arrays are reported as "name[0]", register the bare name and every element
+			size_t bracket = name.find('[');
+			if (bracket != std::string::npos)
+			{
+				std::string baseName = name.substr(0, bracket);
+				m_UniformLocations[baseName] = location;
+				for (GLint element = 0; element < size; element++)
+				{
+					std::string elementName = baseName + "[" + std::to_string(element) + "]";
+					m_UniformLocations[elementName] = glGetUniformLocation(m_RendererID, elementName.c_str());
+				}
+			}
+			else
+			{
+				m_UniformLocations[name] = location;
+			}
+		}
 	}
 }
\ No newline at end of file
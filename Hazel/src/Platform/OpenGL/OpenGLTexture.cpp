@@ -4,19 +4,109 @@
 
 namespace Hazel {
 
+	namespace Utils {
+
+		static TextureFormat GLInternalFormatToTextureFormat(GLenum internalFormat)
+		{
+			switch (internalFormat)
+			{
+				case GL_R8:      return TextureFormat::R8;
+				case GL_RGB8:    return TextureFormat::RGB8;
+				case GL_RGBA8:   return TextureFormat::RGBA8;
+				case GL_RGB16F:  return TextureFormat::RGB16F;
+				case GL_RGBA16F: return TextureFormat::RGBA16F;
+			}
+			return TextureFormat::None;
+		}
+
+		static GLenum TextureFormatToGLInternalFormat(TextureFormat format)
+		{
+			switch (format)
+			{
+				case TextureFormat::R8:      return GL_R8;
+				case TextureFormat::RGB8:    return GL_RGB8;
+				case TextureFormat::RGBA8:   return GL_RGBA8;
+				case TextureFormat::RGB16F:  return GL_RGB16F;
+				case TextureFormat::RGBA16F: return GL_RGBA16F;
+			}
+			HZ_CORE_ASSERT(false, "Unknown texture format!");
+			return 0;
+		}
+
+		static GLenum TextureFormatToGLDataFormat(TextureFormat format)
+		{
+			switch (format)
+			{
+				case TextureFormat::R8:      return GL_RED;
+				case TextureFormat::RGB8:    return GL_RGB;
+				case TextureFormat::RGBA8:   return GL_RGBA;
+				case TextureFormat::RGB16F:  return GL_RGB;
+				case TextureFormat::RGBA16F: return GL_RGBA;
+			}
+			HZ_CORE_ASSERT(false, "Unknown texture format!");
+			return 0;
+		}
+
+		static GLenum GLInternalFormatToGLDataType(GLenum internalFormat)
+		{
+			switch (internalFormat)
+			{
+				case GL_RGB16F:
+				case GL_RGBA16F: return GL_HALF_FLOAT;
+			}
+			return GL_UNSIGNED_BYTE;
+		}
+
+		// zOffset is the cube face or array layer, ignored for 2D textures. Rows are tightly packed.
+		// With a pixel pack buffer bound, data is an offset into it.
+		static void GetTextureLevel(uint32_t rendererID, GLenum internalFormat, GLenum dataFormat, uint32_t width, uint32_t height,
+			uint32_t zOffset, int level, void* data, uint32_t size)
+		{
+			uint32_t levelWidth = std::max(width >> level, 1u);
+			uint32_t levelHeight = std::max(height >> level, 1u);
+			HZ_CORE_ASSERT(size == levelWidth * levelHeight * GetTextureFormatTexelSize(GLInternalFormatToTextureFormat(internalFormat)), "Data must be entire level!");
+
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glGetTextureSubImage(rendererID, level, 0, 0, zOffset, levelWidth, levelHeight, 1,
+				dataFormat, GLInternalFormatToGLDataType(internalFormat), size, data);
+			glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		}
+
+		// Uploads rows [firstRow, firstRow + rowCount) of a level, a rowCount of 0 means every row
+		static void SetTextureLevel(uint32_t rendererID, GLenum target, GLenum internalFormat, GLenum dataFormat, uint32_t width, uint32_t height,
+			uint32_t zOffset, int level, const void* data, uint32_t size, uint32_t firstRow = 0, uint32_t rowCount = 0)
+		{
+			uint32_t levelWidth = std::max(width >> level, 1u);
+			uint32_t levelHeight = std::max(height >> level, 1u);
+			if (rowCount == 0)
+				rowCount = levelHeight;
+			HZ_CORE_ASSERT(firstRow + rowCount <= levelHeight, "Rows are out of range!");
+			HZ_CORE_ASSERT(size == levelWidth * rowCount * GetTextureFormatTexelSize(GLInternalFormatToTextureFormat(internalFormat)), "Data must be entire rows!");
+
+			GLenum type = GLInternalFormatToGLDataType(internalFormat);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			if (target == GL_TEXTURE_2D)
+				glTextureSubImage2D(rendererID, level, 0, firstRow, levelWidth, rowCount, dataFormat, type, data);
+			else
+				glTextureSubImage3D(rendererID, level, 0, firstRow, zOffset, levelWidth, rowCount, 1, dataFormat, type, data);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
+
+	}
+
 	////////////////////////////////////////////////////////////////////////////
 	// Texture2D ///////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
-	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
-		: m_Width(width), m_Height(height)
+	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, TextureFormat format, uint32_t mipLevels)
+		: m_Width(width), m_Height(height), m_MipLevels(mipLevels)
 	{
-		m_InternalFormat = GL_RGBA8;
-		m_DataFormat = GL_RGBA;
+		m_InternalFormat = Utils::TextureFormatToGLInternalFormat(format);
+		m_DataFormat = Utils::TextureFormatToGLDataFormat(format);
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		glTextureStorage2D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width, m_Height);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -154,11 +244,18 @@ namespace Hazel {
 		glDeleteTextures(1, &m_RendererID);
 	}
 
+	TextureFormat OpenGLTexture2D::GetFormat() const
+	{
+		return Utils::GLInternalFormatToTextureFormat(m_InternalFormat);
+	}
+
 	void OpenGLTexture2D::SetData(void* data, uint32_t size, uint32_t textureIndex)
 	{
-		uint32_t bpc = m_DataFormat == GL_RGBA ? 4 : 3;
+		// Half float textures take their texels as 32-bit floats
+		bool isFloat = m_InternalFormat == GL_RGB16F || m_InternalFormat == GL_RGBA16F;
+		uint32_t bpc = (m_DataFormat == GL_RGBA ? 4 : 3) * (isFloat ? sizeof(float) : 1);
 		HZ_CORE_ASSERT(size == m_Width * m_Height * bpc, "Data must be entire texture!");
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, isFloat ? GL_FLOAT : GL_UNSIGNED_BYTE, data);
 	}
 
 	void OpenGLTexture2D::SetDataFromFrameBuffer(const Ref<FrameBuffer>& frameBuffer, uint32_t textureIndex, int level)
@@ -168,6 +265,30 @@ namespace Hazel {
 		glCopyTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, 0, 0, m_Width, m_Height);
 	}
 
+	void OpenGLTexture2D::GetLevelData(void* data, uint32_t size, uint32_t textureIndex, int level) const
+	{
+		Utils::GetTextureLevel(m_RendererID, m_InternalFormat, m_DataFormat, m_Width, m_Height, 0, level, data, size);
+	}
+
+	void OpenGLTexture2D::SetLevelData(const void* data, uint32_t size, uint32_t textureIndex, int level)
+	{
+		Utils::SetTextureLevel(m_RendererID, GL_TEXTURE_2D, m_InternalFormat, m_DataFormat, m_Width, m_Height, 0, level, data, size);
+	}
+
+	void OpenGLTexture2D::SetLevelRows(const void* data, uint32_t size, uint32_t firstRow, uint32_t rowCount, uint32_t textureIndex, int level)
+	{
+		Utils::SetTextureLevel(m_RendererID, GL_TEXTURE_2D, m_InternalFormat, m_DataFormat, m_Width, m_Height, 0, level, data, size, firstRow, rowCount);
+	}
+
+	void OpenGLTexture2D::SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		HZ_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Rect is out of range!");
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(m_RendererID, 0, x, y, width, height, m_DataFormat, Utils::GLInternalFormatToGLDataType(m_InternalFormat), data);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
 	void OpenGLTexture2D::GenerateMipmaps() const
 	{
 		glBindTexture(GL_TEXTURE_2D, m_RendererID);
@@ -183,14 +304,14 @@ namespace Hazel {
 	////////////////////////////////////////////////////////////////////////////
 	// TextureCube /////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
-	OpenGLTextureCube::OpenGLTextureCube(uint32_t width, uint32_t height)
-		: m_Width(width), m_Height(height)
+	OpenGLTextureCube::OpenGLTextureCube(uint32_t width, uint32_t height, uint32_t mipLevels)
+		: m_Width(width), m_Height(height), m_MipLevels(mipLevels)
 	{
 		m_InternalFormat = GL_RGB16F;
 		m_DataFormat = GL_RGB;
 
 		glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		glTextureStorage2D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width, m_Height);
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -208,6 +329,11 @@ namespace Hazel {
 		glDeleteTextures(1, &m_RendererID);
 	}
 
+	TextureFormat OpenGLTextureCube::GetFormat() const
+	{
+		return Utils::GLInternalFormatToTextureFormat(m_InternalFormat);
+	}
+
 	void OpenGLTextureCube::SetData(void* data, uint32_t size, uint32_t textureIndex)
 	{
 		HZ_CORE_ASSERT(size == m_Width * m_Height * 3, "Data must be entire texture!");
@@ -218,7 +344,23 @@ namespace Hazel {
 	{
 		frameBuffer->Bind();
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
-		glCopyTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + textureIndex, level, 0, 0, 0, 0, m_Width, m_Height);
+		glCopyTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + textureIndex, level, 0, 0, 0, 0,
+			std::max(m_Width >> level, 1u), std::max(m_Height >> level, 1u));
+	}
+
+	void OpenGLTextureCube::GetLevelData(void* data, uint32_t size, uint32_t textureIndex, int level) const
+	{
+		Utils::GetTextureLevel(m_RendererID, m_InternalFormat, m_DataFormat, m_Width, m_Height, textureIndex, level, data, size);
+	}
+
+	void OpenGLTextureCube::SetLevelData(const void* data, uint32_t size, uint32_t textureIndex, int level)
+	{
+		Utils::SetTextureLevel(m_RendererID, GL_TEXTURE_CUBE_MAP, m_InternalFormat, m_DataFormat, m_Width, m_Height, textureIndex, level, data, size);
+	}
+
+	void OpenGLTextureCube::SetLevelRows(const void* data, uint32_t size, uint32_t firstRow, uint32_t rowCount, uint32_t textureIndex, int level)
+	{
+		Utils::SetTextureLevel(m_RendererID, GL_TEXTURE_CUBE_MAP, m_InternalFormat, m_DataFormat, m_Width, m_Height, textureIndex, level, data, size, firstRow, rowCount);
 	}
 
 	void OpenGLTextureCube::GenerateMipmaps() const
@@ -233,4 +375,162 @@ namespace Hazel {
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
 		glActiveTexture(GL_TEXTURE0);
 	}
-}
\ No newline at end of file
+
+
+	////////////////////////////////////////////////////////////////////////////
+	// Texture2DArray //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+	OpenGLTexture2DArray::OpenGLTexture2DArray(uint32_t width, uint32_t height, uint32_t layers, TextureFormat format)
+		: m_Width(width), m_Height(height), m_Layers(layers), m_Format(format)
+	{
+		m_InternalFormat = Utils::TextureFormatToGLInternalFormat(format);
+		m_DataFormat = Utils::TextureFormatToGLDataFormat(format);
+
+		m_MipLevels = 1;
+		while ((std::max(m_Width, m_Height) >> m_MipLevels) > 0)
+			m_MipLevels++;
+
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_RendererID);
+		glTextureStorage3D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width, m_Height, m_Layers);
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	}
+
+	OpenGLTexture2DArray::~OpenGLTexture2DArray()
+	{
+		glDeleteTextures(1, &m_RendererID);
+	}
+
+	void OpenGLTexture2DArray::SetData(void* data, uint32_t size, uint32_t textureIndex)
+	{
+		HZ_CORE_ASSERT(textureIndex < m_Layers, "Layer out of range!");
+
+		// Half float layers take their texels as 32-bit floats
+		bool isFloat = m_InternalFormat == GL_RGB16F || m_InternalFormat == GL_RGBA16F;
+		uint32_t bpc = (m_DataFormat == GL_RGBA ? 4 : m_DataFormat == GL_RGB ? 3 : 1) * (isFloat ? sizeof(float) : 1);
+		HZ_CORE_ASSERT(size == m_Width * m_Height * bpc, "Data must be an entire layer!");
+		glTextureSubImage3D(m_RendererID, 0, 0, 0, textureIndex, m_Width, m_Height, 1, m_DataFormat, isFloat ? GL_FLOAT : GL_UNSIGNED_BYTE, data);
+	}
+
+	void OpenGLTexture2DArray::SetDataFromFrameBuffer(const Ref<FrameBuffer>& frameBuffer, uint32_t textureIndex, int level)
+	{
+		frameBuffer->Bind();
+		glCopyTextureSubImage3D(m_RendererID, level, 0, 0, textureIndex, 0, 0, m_Width >> level, m_Height >> level);
+	}
+
+	void OpenGLTexture2DArray::GetLevelData(void* data, uint32_t size, uint32_t textureIndex, int level) const
+	{
+		HZ_CORE_ASSERT(textureIndex < m_Layers, "Layer out of range!");
+		Utils::GetTextureLevel(m_RendererID, m_InternalFormat, m_DataFormat, m_Width, m_Height, textureIndex, level, data, size);
+	}
+
+	void OpenGLTexture2DArray::SetLevelData(const void* data, uint32_t size, uint32_t textureIndex, int level)
+	{
+		HZ_CORE_ASSERT(textureIndex < m_Layers, "Layer out of range!");
+		Utils::SetTextureLevel(m_RendererID, GL_TEXTURE_2D_ARRAY, m_InternalFormat, m_DataFormat, m_Width, m_Height, textureIndex, level, data, size);
+	}
+
+	void OpenGLTexture2DArray::SetLevelRows(const void* data, uint32_t size, uint32_t firstRow, uint32_t rowCount, uint32_t textureIndex, int level)
+	{
+		HZ_CORE_ASSERT(textureIndex < m_Layers, "Layer out of range!");
+		Utils::SetTextureLevel(m_RendererID, GL_TEXTURE_2D_ARRAY, m_InternalFormat, m_DataFormat, m_Width, m_Height, textureIndex, level, data, size, firstRow, rowCount);
+	}
+
+	void OpenGLTexture2DArray::CopyLayer(const Ref<Texture2D>& source, uint32_t layer)
+	{
+		HZ_CORE_ASSERT(layer < m_Layers, "Layer out of range!");
+		HZ_CORE_ASSERT(source->GetWidth() == m_Width && source->GetHeight() == m_Height && source->GetFormat() == m_Format,
+			"Source texture does not match the array!");
+
+		glCopyImageSubData(source->GetRendererID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+			m_RendererID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+			m_Width, m_Height, 1);
+	}
+
+	void OpenGLTexture2DArray::GenerateMipmaps() const
+	{
+		glGenerateTextureMipmap(m_RendererID);
+	}
+
+	void OpenGLTexture2DArray::Bind(uint32_t slot, uint32_t textureIndex) const
+	{
+		glBindTextureUnit(slot, m_RendererID);
+	}
+
+
+	////////////////////////////////////////////////////////////////////////////
+	// TextureReadback /////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+	OpenGLTextureReadback::OpenGLTextureReadback(uint32_t size)
+		: m_Size(size)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, size, nullptr, GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT);
+	}
+
+	OpenGLTextureReadback::~OpenGLTextureReadback()
+	{
+		if (m_Fence)
+			glDeleteSync((GLsync)m_Fence);
+		if (m_MappedData)
+			glUnmapNamedBuffer(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLTextureReadback::Queue(const Ref<Texture>& texture, uint32_t textureIndex, int level, uint32_t offset)
+	{
+		HZ_CORE_ASSERT(!m_MappedData, "Readback data is already in use!");
+
+		uint32_t width = std::max(texture->GetWidth() >> level, 1u);
+		uint32_t height = std::max(texture->GetHeight() >> level, 1u);
+		uint32_t size = width * height * GetTextureFormatTexelSize(texture->GetFormat());
+		HZ_CORE_ASSERT(offset + size <= m_Size, "Readback buffer is too small!");
+
+		GLenum internalFormat = Utils::TextureFormatToGLInternalFormat(texture->GetFormat());
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, m_RendererID);
+		Utils::GetTextureLevel(texture->GetRendererID(), internalFormat, Utils::TextureFormatToGLDataFormat(texture->GetFormat()),
+			texture->GetWidth(), texture->GetHeight(), textureIndex, level, (void*)(uintptr_t)offset, size);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		m_Complete = false;
+	}
+
+	void OpenGLTextureReadback::Submit()
+	{
+		if (m_Fence)
+			glDeleteSync((GLsync)m_Fence);
+		m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	bool OpenGLTextureReadback::IsComplete(bool wait)
+	{
+		if (m_Complete)
+			return true;
+		HZ_CORE_ASSERT(m_Fence, "Readback was never submitted!");
+
+		GLenum status = glClientWaitSync((GLsync)m_Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		while (wait && status == GL_TIMEOUT_EXPIRED)
+			status = glClientWaitSync((GLsync)m_Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+		if (status == GL_TIMEOUT_EXPIRED)
+			return false;
+
+		glDeleteSync((GLsync)m_Fence);
+		m_Fence = nullptr;
+		m_Complete = true;
+		return true;
+	}
+
+	const void* OpenGLTextureReadback::GetData()
+	{
+		HZ_CORE_ASSERT(m_Complete, "Readback has not arrived yet!");
+
+		// Nothing writes the buffer while it is mapped, so it stays mapped until the readback goes away
+		if (!m_MappedData)
+			m_MappedData = glMapNamedBufferRange(m_RendererID, 0, m_Size, GL_MAP_READ_BIT);
+		return m_MappedData;
+	}
+
+}
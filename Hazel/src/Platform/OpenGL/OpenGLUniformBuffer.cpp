@@ -0,0 +1,44 @@
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+#include <glad/glad.h>
+
+namespace Hazel {
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+		: m_Size(size), m_Binding(binding)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		HZ_CORE_ASSERT(offset + size <= m_Size, "UniformBuffer overflow!");
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	void OpenGLUniformBuffer::Bind() const
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID);
+	}
+
+	void OpenGLUniformBuffer::BindRange(uint32_t offset, uint32_t size) const
+	{
+		glBindBufferRange(GL_UNIFORM_BUFFER, m_Binding, m_RendererID, offset, size);
+	}
+
+	uint32_t OpenGLUniformBuffer::GetOffsetAlignment()
+	{
+		static GLint alignment = 0;
+		if (alignment == 0)
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		return (uint32_t)alignment;
+	}
+
+}
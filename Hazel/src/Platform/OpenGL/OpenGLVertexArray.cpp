@@ -19,6 +19,11 @@ namespace Hazel {
 			case ShaderDataType::Int3:     return GL_INT;
 			case ShaderDataType::Int4:     return GL_INT;
 			case ShaderDataType::Bool:     return GL_BOOL;
+			case ShaderDataType::Half2:    return GL_HALF_FLOAT;
+			case ShaderDataType::Half4:    return GL_HALF_FLOAT;
+			case ShaderDataType::UByte4Norm:        return GL_UNSIGNED_BYTE;
+			case ShaderDataType::Short2Norm:        return GL_SHORT;
+			case ShaderDataType::Int2_10_10_10_Rev: return GL_INT_2_10_10_10_REV;
 		}
 
 		HZ_CORE_ASSERT(false, "Unknow ShaderDataType!");
@@ -46,14 +51,23 @@ namespace Hazel {
 		glBindVertexArray(0);
 	}
 
-	void OpenGLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer)
+	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		AddBuffer(vertexBuffer, 0);
+	}
+
+	void OpenGLVertexArray::AddInstanceBuffer(const Ref<VertexBuffer>& instanceBuffer)
+	{
+		AddBuffer(instanceBuffer, 1);
+	}
+
+	void OpenGLVertexArray::AddBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t divisor)
 	{
 		HZ_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "vertex buffer has no layout");
 
 		glBindVertexArray(m_RendererID);
 		vertexBuffer->Bind();
 
-		uint32_t index = 0;
 		const auto& layout = vertexBuffer->GetLayout();
 		for (const auto& element : layout)
 		{
@@ -64,14 +78,15 @@ namespace Hazel {
 				case ShaderDataType::Float3:
 				case ShaderDataType::Float4:
 				{
-					glEnableVertexAttribArray(index);
-					glVertexAttribPointer(index,
+					glEnableVertexAttribArray(m_VertexBufferIndex);
+					glVertexAttribPointer(m_VertexBufferIndex,
 						element.GetComponentCount(),
 						ShaderDataTypeToOpenGLBaseType(element.Type),
 						element.Normalized ? GL_TRUE : GL_FALSE,
 						layout.GetStride(),
 						(const void*)element.Offset);
-					index++;
+					glVertexAttribDivisor(m_VertexBufferIndex, divisor);
+					m_VertexBufferIndex++;
 					break;
 				}
 				case ShaderDataType::Int:
@@ -80,13 +95,32 @@ namespace Hazel {
 				case ShaderDataType::Int4:
 				case ShaderDataType::Bool:
 				{
-					glEnableVertexAttribArray(index);
-					glVertexAttribIPointer(index,
+					glEnableVertexAttribArray(m_VertexBufferIndex);
+					glVertexAttribIPointer(m_VertexBufferIndex,
+						element.GetComponentCount(),
+						ShaderDataTypeToOpenGLBaseType(element.Type),
+						layout.GetStride(),
+						(const void*)element.Offset);
+					glVertexAttribDivisor(m_VertexBufferIndex, divisor);
+					m_VertexBufferIndex++;
+					break;
+				}
+				case ShaderDataType::Half2:
+				case ShaderDataType::Half4:
+				case ShaderDataType::UByte4Norm:
+				case ShaderDataType::Short2Norm:
+				case ShaderDataType::Int2_10_10_10_Rev:
+				{
+					bool normalized = element.Type != ShaderDataType::Half2 && element.Type != ShaderDataType::Half4;
+					glEnableVertexAttribArray(m_VertexBufferIndex);
+					glVertexAttribPointer(m_VertexBufferIndex,
 						element.GetComponentCount(),
 						ShaderDataTypeToOpenGLBaseType(element.Type),
+						normalized ? GL_TRUE : GL_FALSE,
 						layout.GetStride(),
 						(const void*)element.Offset);
-					index++;
+					glVertexAttribDivisor(m_VertexBufferIndex, divisor);
+					m_VertexBufferIndex++;
 					break;
 				}
 				case ShaderDataType::Mat3:
@@ -95,15 +129,15 @@ namespace Hazel {
 					uint8_t count = element.GetComponentCount();
 					for (uint8_t i = 0; i < count; i++)
 					{
-						glEnableVertexAttribArray(index);
-						glVertexAttribPointer(index,
+						glEnableVertexAttribArray(m_VertexBufferIndex);
+						glVertexAttribPointer(m_VertexBufferIndex,
 							count,
 							ShaderDataTypeToOpenGLBaseType(element.Type),
 							element.Normalized ? GL_TRUE : GL_FALSE,
 							layout.GetStride(),
 							(const void*)(element.Offset + sizeof(float) * count * i));
-						glVertexAttribDivisor(index, 1);
-						index++;
+						glVertexAttribDivisor(m_VertexBufferIndex, divisor);
+						m_VertexBufferIndex++;
 					}
 					break;
 				}
@@ -5,6 +5,7 @@
 #include "Panels/ContentBrowserPanel.h"
 
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Renderer/RenderGraph.h"
 
 namespace Hazel {
 
@@ -39,8 +40,12 @@ namespace Hazel {
 
 		// UI Panels
 		void UI_Toolbar();
+		void UI_Environment();
 	private:
-		Ref<FrameBuffer> m_FrameBuffer;
+		RenderGraph m_RenderGraph;
+		FramebufferSpecification m_ViewportSpecification;
+		// Output of the graph, valid until the next frame resets it
+		RenderGraphResource m_ViewportTarget = RenderGraph::InvalidResource;
 
 		Ref<Scene> m_ActiveScene;
 		Ref<Scene> m_EditorScene;
@@ -236,6 +236,7 @@ namespace Hazel {
 		ImGui::Text("Quads: %d", stats.QuadCount);
 		ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 		ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+		ImGui::Text("Vertex Bytes: %llu (%llu unpacked)", (unsigned long long)stats.VertexBytes, (unsigned long long)stats.UnpackedVertexBytes);
 
 		ImGui::End();
 
@@ -315,6 +316,7 @@ namespace Hazel {
 				tc.Translation = translation;
 				tc.Rotation += deltaRotation; 
 				tc.Scale = scale;
+				selectedEntity.PatchComponent<TransformComponent>();
 			}
 		}
 
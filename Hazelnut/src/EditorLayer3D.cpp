@@ -12,6 +12,8 @@
 
 namespace Hazel {
 
+	static const std::filesystem::path s_EnvironmentDirectory = "../../assets/textures/hdr";
+
 	EditorLayer3D::EditorLayer3D()
 		: Layer("EditorLayer3D")
 	{
@@ -22,11 +24,9 @@ namespace Hazel {
 		m_IconPlay = Texture2D::Create("../../Hazelnut/Resources/Icons/PlayButton.png");
 		m_IconStop = Texture2D::Create("../../Hazelnut/Resources/Icons/StopButton.png");
 
-		FramebufferSpecification fbSpec;
-		fbSpec.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::RED_INTEGER, FramebufferTextureFormat::Depth };
-		fbSpec.Width = 1920;
-		fbSpec.Height = 1080;
-		m_FrameBuffer = FrameBuffer::Create(fbSpec);
+		m_ViewportSpecification.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::Depth };
+		m_ViewportSpecification.Width = 1920;
+		m_ViewportSpecification.Height = 1080;
 
 		m_EditorScene = CreateRef<Scene>();
 		m_ActiveScene = m_EditorScene;
@@ -117,56 +117,67 @@ namespace Hazel {
 	void EditorLayer3D::OnUpdate(float ts)
 	{
 		// Resize
-		if (FramebufferSpecification spec = m_FrameBuffer->GetSpecification();
-			m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f &&
-			(spec.Width != m_ViewportSize.x || spec.Height != m_ViewportSize.y))
+		if (m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f &&
+			(m_ViewportSpecification.Width != m_ViewportSize.x || m_ViewportSpecification.Height != m_ViewportSize.y))
 		{
-			m_FrameBuffer->Resize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+			m_ViewportSpecification.Width = (uint32_t)m_ViewportSize.x;
+			m_ViewportSpecification.Height = (uint32_t)m_ViewportSize.y;
 			m_EditorCamera.SetViewportSize(m_ViewportSize.x, m_ViewportSize.y);
 			m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 		}
 
+		// Environment maps are swapped between frames, never while the scene renders
+		ResourceManager::Get()->UpdateEnvironmentBake();
+
 		// Render
 		Renderer3D::ResetStats();
-		m_FrameBuffer->Bind();
-		RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
-		RenderCommand::Clear();
-
-		// Clear our entity ID attachment to -1
-		m_FrameBuffer->ClearAttachment(1, -1);
+		Renderer2D::ResetStats();
+		m_RenderGraph.Reset();
+		m_ViewportTarget = m_RenderGraph.CreateTarget("Viewport", m_ViewportSpecification);
+		m_RenderGraph.MarkOutput(m_ViewportTarget);
 
-		// Update scene
-		switch (m_SceneState)
+		m_RenderGraph.AddPass("Scene", {}, m_ViewportTarget, [this, ts](const RenderGraph& graph)
 		{
-			case SceneState::Edit:
-			{
-				m_EditorCamera.OnUpdate(ts);
+			RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+			RenderCommand::Clear();
 
-				m_ActiveScene->OnUpdateEditor(ts, m_EditorCamera);
-				break;
-			}
-			case SceneState::Play:
+			// Update scene
+			switch (m_SceneState)
 			{
-				m_ActiveScene->OnUpdateRuntime(ts);
-				break;
+				case SceneState::Edit:
+				{
+					m_EditorCamera.OnUpdate(ts);
+
+					m_ActiveScene->OnUpdateEditor(ts, m_EditorCamera);
+					break;
+				}
+				case SceneState::Play:
+				{
+					m_ActiveScene->OnUpdateRuntime(ts);
+					break;
+				}
 			}
-		}
+		});
+
+		m_RenderGraph.Execute();
 
 		auto[mx, my] = ImGui::GetMousePos();
 		mx -= m_ViewportBounds[0].x;
 		my -= m_ViewportBounds[0].y;
 		glm::vec2 viewportSize = m_ViewportBounds[1] - m_ViewportBounds[0];
 		my = viewportSize.y - my;
-		int mouseX = (int)mx;
-		int mouseY = (int)my;
 
-		if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y)
+		// Picking casts a ray through the mouse against the scene's bounds, so the viewport needs no entity ID attachment
+		if (mx >= 0.0f && my >= 0.0f && mx < viewportSize.x && my < viewportSize.y)
 		{
-			int pixelData = m_FrameBuffer->ReadPixel(1, mouseX, mouseY);
-			m_HoveredEntity = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_ActiveScene.get());
-		}
+			glm::mat4 viewProjection = m_EditorCamera.GetViewProjection();
+			Entity camera = m_SceneState == SceneState::Play ? m_ActiveScene->GetPrimaryCameraEntity() : Entity();
+			if (camera)
+				viewProjection = camera.GetComponent<CameraComponent>().Camera.GetProjection() * glm::inverse(camera.GetComponent<TransformComponent>().GetTransform());
 
-		m_FrameBuffer->Unbind();
+			glm::vec2 ndc = { mx / viewportSize.x * 2.0f - 1.0f, my / viewportSize.y * 2.0f - 1.0f };
+			m_HoveredEntity = m_ActiveScene->RayCast(Ray::FromNDC(ndc, viewProjection), 1.0f);
+		}
 	}
 
 	void EditorLayer3D::OnImGuiRender()
@@ -263,12 +274,61 @@ namespace Hazel {
 		auto stats = Renderer3D::GetStats();
 		ImGui::Text("Renderer3D Stats:");
 		ImGui::Text("Draw Calls: %d", stats.DrawCalls);
-		//ImGui::Text("Spheres: %d", stats.SphereCount);
+		ImGui::Text("Spheres: %d", stats.SphereCount);
+		ImGui::Text("Meshes: %d", stats.MeshCount);
+		ImGui::Text("Triangles: %d", stats.Triangles);
+		ImGui::Text("Bytes Uploaded: %llu", (unsigned long long)stats.BytesUploaded);
+		ImGui::Text("Buffers Allocated: %d", stats.BuffersAllocated);
+		ImGui::Text("Vertex Bytes: %llu (%llu unpacked)", (unsigned long long)stats.VertexBytes, (unsigned long long)stats.UnpackedVertexBytes);
+		ImGui::Text("State Changes: %d", stats.StateChanges);
+		ImGui::Text("Sort Time: %.3f ms", stats.SortTime);
+		ImGui::Text("Point Lights: %d", stats.PointLights);
+		ImGui::Text("Light Indices: %d", stats.LightIndices);
+		for (uint32_t i = 0; i < stats.RecordThreads; i++)
+			ImGui::Text("Record Thread %d: %.3f ms", i, stats.RecordTimes[i]);
+		ImGui::Text("Merge Time: %.3f ms", stats.MergeTime);
+
+		auto stats2D = Renderer2D::GetStats();
+		ImGui::Text("Renderer2D Stats:");
+		ImGui::Text("Draw Calls: %d", stats2D.DrawCalls);
+		ImGui::Text("Quads: %d", stats2D.QuadCount);
+
+		auto& graphStats = m_RenderGraph.GetStats();
+		ImGui::Text("Render Passes: %d (%d culled)", graphStats.Passes, graphStats.CulledPasses);
+		ImGui::Text("Render Targets: %d in %d framebuffers", graphStats.Targets, graphStats.FrameBuffersUsed);
+		ImGui::Text("Pooled Framebuffers: %d (%d created)", graphStats.PooledFrameBuffers, graphStats.FrameBuffersCreated);
+
+		auto& sceneStats = m_ActiveScene->GetStatistics();
+		ImGui::Text("Visible: %d", sceneStats.VisibleRenderables);
+		ImGui::Text("Culled: %d", sceneStats.CulledRenderables);
+		ImGui::Text("Sprites: %d visible, %d culled", sceneStats.VisibleSprites, sceneStats.CulledSprites);
+		ImGui::Text("Sprite Atlas: %d textures in %d pages", sceneStats.AtlasTextures, sceneStats.AtlasPages);
+
+		bool occlusionCulling = m_ActiveScene->IsOcclusionCullingEnabled();
+		if (ImGui::Checkbox("Occlusion Culling", &occlusionCulling))
+			m_ActiveScene->SetOcclusionCulling(occlusionCulling);
+		if (occlusionCulling)
+		{
+			ImGui::Text("Occluders: %d", sceneStats.Occluders);
+			ImGui::Text("Occluded: %d", sceneStats.OccludedRenderables);
+			ImGui::Text("Occluder Raster: %.3f ms", sceneStats.OcclusionRasterTime);
+			ImGui::Text("Occlusion Tests: %.3f ms", sceneStats.OcclusionTestTime);
+		}
+
+		float lodBias = Renderer3D::GetSphereLodBias();
+		if (ImGui::DragFloat("Sphere LOD Bias", &lodBias, 0.05f, -4.0f, 4.0f, "%.2f"))
+			Renderer3D::SetSphereLodBias(lodBias);
+
+		bool useIrradianceSH = Renderer3D::GetUseIrradianceSH();
+		if (ImGui::Checkbox("SH Irradiance", &useIrradianceSH))
+			Renderer3D::SetUseIrradianceSH(useIrradianceSH);
 		//ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 		//ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
 
 		ImGui::End();
 
+		UI_Environment();
+
 		ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2{ 0, 0 });
 		ImGui::Begin("Viewport");
 
@@ -288,8 +348,12 @@ namespace Hazel {
 		ImVec2 viewportPenelSize = ImGui::GetContentRegionAvail();
 		m_ViewportSize = { viewportPenelSize.x, viewportPenelSize.y };
 
-		uint32_t textureID = m_FrameBuffer->GetColorAttachmentRendererID(0);
-		ImGui::Image((void*)textureID, ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+		// Nothing rendered yet when the window starts minimized
+		if (m_ViewportTarget != RenderGraph::InvalidResource)
+		{
+			uint32_t textureID = m_RenderGraph.GetFrameBuffer(m_ViewportTarget)->GetColorAttachmentRendererID(0);
+			ImGui::Image((void*)textureID, ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+		}
 
 		if (ImGui::BeginDragDropTarget())
 		{
@@ -345,6 +409,7 @@ namespace Hazel {
 				tc.Translation = translation;
 				tc.Rotation += deltaRotation; 
 				tc.Scale = scale;
+				selectedEntity.PatchComponent<TransformComponent>();
 			}
 		}
 
@@ -356,6 +421,39 @@ namespace Hazel {
 		ImGui::End();
 	}
 
+	void EditorLayer3D::UI_Environment()
+	{
+		ImGui::Begin("Environment");
+
+		ResourceManager* resources = ResourceManager::Get();
+		std::filesystem::path environmentPath = resources->GetBakingEnvironmentPath();
+		if (ImGui::BeginCombo("HDR", environmentPath.filename().string().c_str()))
+		{
+			std::error_code error;
+			for (auto& entry : std::filesystem::directory_iterator(s_EnvironmentDirectory, error))
+			{
+				const std::filesystem::path& path = entry.path();
+				if (path.extension() != ".hdr")
+					continue;
+
+				if (ImGui::Selectable(path.filename().string().c_str(), path == environmentPath))
+					resources->SetEnvironment(path.string());
+			}
+			ImGui::EndCombo();
+		}
+
+		if (resources->IsEnvironmentBaking())
+			ImGui::ProgressBar(resources->GetEnvironmentBakeProgress(), ImVec2(-1.0f, 0.0f), "Baking");
+
+		IBLBakeSettings& settings = resources->GetIBLBakeSettings();
+		ImGui::DragFloat("Frame Budget (ms)", &settings.FrameBudget, 0.1f, 0.1f, 33.0f, "%.1f");
+		int maxSteps = (int)settings.MaxStepsPerFrame;
+		if (ImGui::DragInt("Max Steps Per Frame", &maxSteps, 0.1f, 1, 64))
+			settings.MaxStepsPerFrame = (uint32_t)std::max(maxSteps, 1);
+
+		ImGui::End();
+	}
+
 	void EditorLayer3D::UI_Toolbar()
 	{
 		ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 2));
@@ -1,6 +1,7 @@
 #include "Panels/SceneHierarchyPanel.h"
 
 #include "Hazel/Scene/Components.h"
+#include "Hazel/Core/ResourceManager.h"
 
 #include <imgui.h>
 #include <imgui_internal.h>
@@ -270,6 +271,24 @@ namespace Hazel {
 				}
 			}
 
+			if (!m_SelectionContext.HasComponent<MeshRendererComponent>())
+			{
+				if (ImGui::MenuItem("Mesh Renderer"))
+				{
+					m_SelectionContext.AddComponent<MeshRendererComponent>();
+					ImGui::CloseCurrentPopup();
+				}
+			}
+
+			if (!m_SelectionContext.HasComponent<OccluderComponent>())
+			{
+				if (ImGui::MenuItem("Occluder"))
+				{
+					m_SelectionContext.AddComponent<OccluderComponent>();
+					ImGui::CloseCurrentPopup();
+				}
+			}
+
 			if (!m_SelectionContext.HasComponent<PointLightComponent>())
 			{
 				if (ImGui::MenuItem("Point Light"))
@@ -293,13 +312,18 @@ namespace Hazel {
 
 		ImGui::PopItemWidth();
 
-		DrawComponent<TransformComponent>("Transform", entity, [](auto& component)
+		DrawComponent<TransformComponent>("Transform", entity, [&](auto& component)
 		{
+			TransformComponent previous = component;
 			DrawVec3Control("Translation", component.Translation);
 			glm::vec3 rotation = glm::degrees(component.Rotation);
 			DrawVec3Control("Rotation", rotation);
-			component.Rotation = glm::radians(rotation);
 			DrawVec3Control("Scale", component.Scale, 1.0f);
+			if (rotation != glm::degrees(previous.Rotation))
+				component.Rotation = glm::radians(rotation);
+
+			if (component.Translation != previous.Translation || component.Rotation != previous.Rotation || component.Scale != previous.Scale)
+				entity.PatchComponent<TransformComponent>();
 		});
 
 		DrawComponent<CameraComponent>("Camera", entity, [](auto& component)
@@ -376,7 +400,7 @@ namespace Hazel {
 			}
 		});
 
-		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [](auto& component)
+		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [&](auto& component)
 		{
 			ImGui::ColorEdit4("Color", glm::value_ptr(component.Color));
 			
@@ -389,7 +413,7 @@ namespace Hazel {
 					std::filesystem::path texturePath(path);
 					Ref<Texture2D> texture = Texture2D::Create(texturePath.string());
 					if (texture->IsLoaded())
-						component.Texture = texture;
+						m_Context->SetSpriteTexture(entity, texture);
 					else
 						HZ_WARN("Could not load texture {0}", texturePath.filename().string());
 				}
@@ -405,11 +429,51 @@ namespace Hazel {
 			DrawControl("Metallic", [&](){ ImGui::DragFloat("", &component.Material.Metallic, 0.005f, 0.0f, 1.0f, "%.2f"); });
 			DrawControl("Roughness", [&](){ ImGui::DragFloat("", &component.Material.Roughness, 0.005f, 0.0f, 1.0f, "%.2f"); });
 			DrawControl("Ao", [&](){ ImGui::DragFloat("", &component.Material.Ao, 0.005f, 0.0f, 1.0f, "%.2f"); });
+			DrawControl("Opacity", [&](){ ImGui::DragFloat("", &component.Material.Opacity, 0.005f, 0.0f, 1.0f, "%.2f"); });
+			DrawControl("LOD Bias", [&](){ ImGui::DragFloat("", &component.LodBias, 0.05f, -4.0f, 4.0f, "%.2f"); });
+		});
+
+		DrawComponent<MeshRendererComponent>("Mesh Renderer", entity, [&](auto& component)
+		{
+			std::string meshName = component.Mesh ? std::filesystem::path(component.Mesh->GetPath()).filename().string() : "None";
+			ImGui::Button(meshName.c_str(), ImVec2(100.0f, 0.0f));
+			if (ImGui::BeginDragDropTarget())
+			{
+				if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
+				{
+					const wchar_t* path = (const wchar_t*)payload->Data;
+					std::filesystem::path meshPath(path);
+					Ref<Mesh> mesh = ResourceManager::Get()->GetMesh(meshPath.string());
+					if (mesh)
+						entity.PatchComponent<MeshRendererComponent>([&](auto& mrc) { mrc.Mesh = mesh; });
+					else
+						HZ_WARN("Could not load mesh {0}", meshPath.filename().string());
+				}
+				ImGui::EndDragDropTarget();
+			}
+			if (component.Mesh)
+			{
+				ImGui::SameLine();
+				ImGui::Text("%d triangles", component.Mesh->GetTriangleCount());
+			}
+
+			DrawControl("Albedo", [&](){ ImGui::ColorEdit3("", glm::value_ptr(component.Material.Albedo)); });
+			DrawControl("Metallic", [&](){ ImGui::DragFloat("", &component.Material.Metallic, 0.005f, 0.0f, 1.0f, "%.2f"); });
+			DrawControl("Roughness", [&](){ ImGui::DragFloat("", &component.Material.Roughness, 0.005f, 0.0f, 1.0f, "%.2f"); });
+			DrawControl("Ao", [&](){ ImGui::DragFloat("", &component.Material.Ao, 0.005f, 0.0f, 1.0f, "%.2f"); });
+			DrawControl("Opacity", [&](){ ImGui::DragFloat("", &component.Material.Opacity, 0.005f, 0.0f, 1.0f, "%.2f"); });
+		});
+
+		DrawComponent<OccluderComponent>("Occluder", entity, [](auto& component)
+		{
+			DrawControl("Min", [&]() { ImGui::DragFloat3("", glm::value_ptr(component.Bounds.Min), 0.05f, 0.0f, 0.0f, "%.2f"); });
+			DrawControl("Max", [&]() { ImGui::DragFloat3("", glm::value_ptr(component.Bounds.Max), 0.05f, 0.0f, 0.0f, "%.2f"); });
 		});
 
 		DrawComponent<PointLightComponent>("Point Light", entity, [](auto& component)
 		{
 			DrawControl("Color", [&]() { ImGui::DragFloat3("", glm::value_ptr(component.Color), 1.0f, 0.0f, 0.0f, "%.2f"); });
+			DrawControl("Range", [&]() { ImGui::DragFloat("", &component.Range, 0.1f, 0.0f, 1000.0f, "%.2f"); });
 		});
 
 		DrawComponent<DirectionalLightComponent>("Directional Light", entity, [](auto& component)
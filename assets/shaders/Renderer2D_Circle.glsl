@@ -6,12 +6,16 @@
 #type vertex
 #version 450 core
 
-layout(location = 0) in vec3 a_WorldPosition;
-layout(location = 1) in vec3 a_LocalPosition;
-layout(location = 2) in vec4 a_Color;
-layout(location = 3) in float a_Thickness;
-layout(location = 4) in float a_Fade;
-layout(location = 5) in int a_EntityID;
+// Unit quad corner
+layout(location = 0) in vec2 a_Position;
+
+// Per instance, the x, y and translation columns of the transform
+layout(location = 1) in vec3 a_AxisX;
+layout(location = 2) in vec3 a_AxisY;
+layout(location = 3) in vec3 a_Translation;
+layout(location = 4) in vec4 a_Color;
+layout(location = 5) in vec2 a_ThicknessFade;
+layout(location = 6) in int a_EntityID;
 
 uniform mat4 u_ViewProjection;
 
@@ -29,12 +33,13 @@ layout(location = 4) flat out int v_EntityID;
 void main()
 {
 	Output.Color = a_Color;
-	Output.LocalPosition = a_LocalPosition;
-	Output.Thickness = a_Thickness;
-	Output.Fade = a_Fade;
+	Output.LocalPosition = vec3(a_Position * 2.0, 0.0);
+	Output.Thickness = a_ThicknessFade.x;
+	Output.Fade = a_ThicknessFade.y;
 	v_EntityID = a_EntityID;
 
-	gl_Position = u_ViewProjection * vec4(a_WorldPosition, 1.0);
+	vec3 worldPosition = a_Translation + a_AxisX * a_Position.x + a_AxisY * a_Position.y;
+	gl_Position = u_ViewProjection * vec4(worldPosition, 1.0);
 }
 
 #type fragment
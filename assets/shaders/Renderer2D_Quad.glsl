@@ -6,12 +6,17 @@
 #type vertex
 #version 450 core
 
-layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec4 a_Color;
-layout(location = 2) in vec2 a_TexCoord;
-layout(location = 3) in float a_TexIndex;
-layout(location = 4) in float a_TilingFactor;
-layout(location = 5) in int a_EntityID;
+// Unit quad corner
+layout(location = 0) in vec2 a_Position;
+
+// Per instance, the x, y and translation columns of the transform
+layout(location = 1) in vec3 a_AxisX;
+layout(location = 2) in vec3 a_AxisY;
+layout(location = 3) in vec3 a_Translation;
+layout(location = 4) in vec4 a_Color;
+layout(location = 5) in vec4 a_TexRect; // Min, max
+layout(location = 6) in vec2 a_TexIndexTiling; // Texture index, tiling factor
+layout(location = 7) in int a_EntityID;
 
 uniform mat4 u_ViewProjection;
 
@@ -29,12 +34,13 @@ layout(location = 4) flat out int v_EntityID;
 void main()
 {
 	Output.Color = a_Color;
-	Output.TexCoord = a_TexCoord;
-	v_TexIndex = a_TexIndex;
-	Output.TilingFactor = a_TilingFactor;
+	Output.TexCoord = mix(a_TexRect.xy, a_TexRect.zw, a_Position + 0.5);
+	v_TexIndex = a_TexIndexTiling.x;
+	Output.TilingFactor = a_TexIndexTiling.y;
 	v_EntityID = a_EntityID;
 
-	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+	vec3 position = a_Translation + a_AxisX * a_Position.x + a_AxisY * a_Position.y;
+	gl_Position = u_ViewProjection * vec4(position, 1.0);
 }
 
 #type fragment
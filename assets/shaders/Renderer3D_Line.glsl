@@ -10,7 +10,12 @@ layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
 layout(location = 2) in int a_EntityID;
 
-uniform mat4 u_ViewProjection;
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+	vec4 u_CameraPosition;
+	mat4 u_View;
+};
 
 struct VertexOutput
 {
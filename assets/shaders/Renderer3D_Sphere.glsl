@@ -7,27 +7,55 @@
 #version 450 core
 
 layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec3 a_Normal;
+layout(location = 1) in vec2 a_Normal; // Octahedral
 layout(location = 2) in vec2 a_TexCoord;
-layout(location = 3) in int a_EntityID;
+// Per-instance
+layout(location = 3) in mat4 a_ModelMatrix;
+layout(location = 7) in mat3 a_NormalMatrix;
+layout(location = 10) in vec4 a_Albedo; // rgb, opacity
+layout(location = 11) in vec3 a_Material; // metallic, roughness, ao
+layout(location = 12) in int a_EntityID;
+layout(location = 13) in int a_MaterialIndex;
 
 layout(location = 0) out vec3 v_WorldPos;
 layout(location = 1) out vec3 v_WorldNormal;
 layout(location = 2) out vec2 v_TexCoord;
-layout(location = 3) flat out int v_EntityID;
+layout(location = 3) flat out vec4 v_Albedo;
+layout(location = 4) flat out vec3 v_Material;
+layout(location = 5) flat out int v_EntityID;
+layout(location = 6) out vec4 v_ClipPos;
+layout(location = 7) out float v_ViewDepth;
+layout(location = 8) flat out int v_MaterialIndex;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+	vec4 u_CameraPosition;
+	mat4 u_View;
+};
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_ModelMatrix;
-uniform mat4 u_NormalMatrix;
+vec3 OctahedralDecode(vec2 encoded)
+{
+	vec3 n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float t = max(-n.z, 0.0);
+	n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+	return normalize(n);
+}
 
 void main()
 {
-	v_WorldPos = vec3(u_ModelMatrix * vec4(a_Position, 1.0));
-	v_WorldNormal = mat3(u_NormalMatrix) * a_Normal;
+	vec4 worldPos = a_ModelMatrix * vec4(a_Position, 1.0);
+	v_WorldPos = worldPos.xyz;
+	v_WorldNormal = a_NormalMatrix * OctahedralDecode(a_Normal);
 	v_TexCoord = a_TexCoord;
+	v_Albedo = a_Albedo;
+	v_Material = a_Material;
 	v_EntityID = a_EntityID;
+	v_MaterialIndex = a_MaterialIndex;
 
-	gl_Position = u_ViewProjection * u_ModelMatrix * vec4(a_Position, 1.0);
+	v_ClipPos = u_ViewProjection * worldPos;
+	v_ViewDepth = -(u_View * worldPos).z;
+	gl_Position = v_ClipPos;
 }
 
 #type fragment
@@ -39,33 +67,84 @@ layout(location = 1) out int o_EntityID;
 layout(location = 0) in vec3 v_WorldPos;
 layout(location = 1) in vec3 v_WorldNormal;
 layout(location = 2) in vec2 v_TexCoord;
-layout(location = 3) flat in int v_EntityID;
-
-uniform vec3 u_CamPos;
-
-// material parameters
-uniform bool u_UseTexture;
-uniform vec3 u_Albedo;
-uniform float u_Metallic;
-uniform float u_Roughness;
-uniform float u_Ao;
-uniform sampler2D u_AlbedoMap;
-uniform sampler2D u_NormalMap;
-uniform sampler2D u_MetallicMap;
-uniform sampler2D u_RoughnessMap;
-uniform sampler2D u_AoMap;
+layout(location = 3) flat in vec4 v_Albedo;
+layout(location = 4) flat in vec3 v_Material;
+layout(location = 5) flat in int v_EntityID;
+layout(location = 6) in vec4 v_ClipPos;
+layout(location = 7) in float v_ViewDepth;
+layout(location = 8) flat in int v_MaterialIndex;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+	vec4 u_CameraPosition;
+	mat4 u_View;
+};
+
+// lights
+layout(std140, binding = 1) uniform Lights
+{
+	vec4 u_DirectionalLightDirection;
+	vec4 u_DirectionalLightColor;
+	uvec4 u_ClusterGrid; // froxel counts in x, y, z
+	vec4 u_ClusterDepth; // near, far, slice = log(depth) * z + w
+};
+
+struct PointLight
+{
+	vec4 PositionRange;
+	vec4 Color;
+};
+
+layout(std430, binding = 0) readonly buffer PointLights
+{
+	PointLight u_PointLights[];
+};
+
+// offset into u_LightIndices, count
+layout(std430, binding = 1) readonly buffer LightClusters
+{
+	uvec2 u_LightClusters[];
+};
+
+layout(std430, binding = 2) readonly buffer LightIndices
+{
+	uint u_LightIndices[];
+};
+
+// material parameters, maps are layers of the arrays bound for the draw
+struct Material
+{
+	int UseTexture;
+	int AlbedoLayer;
+	int NormalLayer;
+	int MetallicLayer;
+	int RoughnessLayer;
+	int AoLayer;
+	int Padding[2];
+};
+
+layout(std430, binding = 3) readonly buffer Materials
+{
+	Material u_Materials[];
+};
+uniform sampler2DArray u_AlbedoMaps;
+uniform sampler2DArray u_NormalMaps;
+uniform sampler2DArray u_MetallicMaps;
+uniform sampler2DArray u_RoughnessMaps;
+uniform sampler2DArray u_AoMaps;
 
 // IBL
+// irradiance / PI as order 2 SH, see SphericalHarmonics.h for the basis order
+layout(std140, binding = 2) uniform Environment
+{
+	vec4 u_IrradianceSH[9];
+	int u_UseIrradianceSH;
+};
 uniform samplerCube irradianceMap;
 uniform samplerCube prefilterMap;
 uniform sampler2D brdfLUT;
 
-// lights
-uniform int u_PointLightNum;
-uniform vec3 u_PointLightPositions[16];
-uniform vec3 u_PointLightColors[16];
-uniform vec3 u_DirectionalLightDirection;
-uniform vec3 u_DirectionalLightColor;
 
 const float PI = 3.14159265359;
 // ----------------------------------------------------------------------------
@@ -73,9 +152,9 @@ const float PI = 3.14159265359;
 // Don't worry if you don't get what's going on; you generally want to do normal 
 // mapping the usual way for performance anyways; I do plan make a note of this 
 // technique somewhere later in the normal mapping tutorial.
-vec3 getNormalFromMap()
+vec3 getNormalFromMap(int layer)
 {
-    vec3 tangentNormal = texture(u_NormalMap, v_TexCoord).xyz * 2.0 - 1.0;
+    vec3 tangentNormal = texture(u_NormalMaps, vec3(v_TexCoord, layer)).xyz * 2.0 - 1.0;
 
     vec3 Q1  = dFdx(v_WorldPos);
     vec3 Q2  = dFdy(v_WorldPos);
@@ -130,35 +209,60 @@ vec3 fresnelSchlick(float cosTheta, vec3 F0)
     return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
 // ----------------------------------------------------------------------------
+vec3 evaluateIrradianceSH(vec3 n)
+{
+	vec3 result = u_IrradianceSH[0].rgb * 0.282095;
+	result += u_IrradianceSH[1].rgb * (0.488603 * n.y);
+	result += u_IrradianceSH[2].rgb * (0.488603 * n.z);
+	result += u_IrradianceSH[3].rgb * (0.488603 * n.x);
+	result += u_IrradianceSH[4].rgb * (1.092548 * n.x * n.y);
+	result += u_IrradianceSH[5].rgb * (1.092548 * n.y * n.z);
+	result += u_IrradianceSH[6].rgb * (0.315392 * (3.0 * n.z * n.z - 1.0));
+	result += u_IrradianceSH[7].rgb * (1.092548 * n.x * n.z);
+	result += u_IrradianceSH[8].rgb * (0.546274 * (n.x * n.x - n.y * n.y));
+	return max(result, vec3(0.0));
+}
+// ----------------------------------------------------------------------------
 vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
 {
     return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }   
 // ----------------------------------------------------------------------------
+uvec2 getLightCluster()
+{
+	vec2 ndc = v_ClipPos.xy / v_ClipPos.w;
+	uvec2 tile = uvec2(clamp((ndc * 0.5 + 0.5) * vec2(u_ClusterGrid.xy), vec2(0.0), vec2(u_ClusterGrid.xy - 1u)));
+	float slice = log(max(v_ViewDepth, 1e-4)) * u_ClusterDepth.z + u_ClusterDepth.w;
+	uint z = uint(clamp(slice, 0.0, float(u_ClusterGrid.z - 1u)));
+	return u_LightClusters[tile.x + u_ClusterGrid.x * (tile.y + u_ClusterGrid.y * z)];
+}
+// ----------------------------------------------------------------------------
 
 void main()
 {
     // material properties
 	vec3 albedo, N;
-	float metallic, roughness, ao;
-	if (u_UseTexture)
+	float metallic, roughness, ao, opacity = 1.0;
+	Material material = u_Materials[v_MaterialIndex];
+	if (material.UseTexture != 0)
 	{
-		albedo = pow(texture(u_AlbedoMap, v_TexCoord).rgb, vec3(2.2));
-		metallic = texture(u_MetallicMap, v_TexCoord).r;
-		roughness = texture(u_RoughnessMap, v_TexCoord).r;
-		ao = texture(u_AoMap, v_TexCoord).r;
-		N = getNormalFromMap();
+		albedo = pow(texture(u_AlbedoMaps, vec3(v_TexCoord, material.AlbedoLayer)).rgb, vec3(2.2));
+		metallic = texture(u_MetallicMaps, vec3(v_TexCoord, material.MetallicLayer)).r;
+		roughness = texture(u_RoughnessMaps, vec3(v_TexCoord, material.RoughnessLayer)).r;
+		ao = texture(u_AoMaps, vec3(v_TexCoord, material.AoLayer)).r;
+		N = getNormalFromMap(material.NormalLayer);
 	}
 	else
 	{
-		albedo = u_Albedo;
-		metallic = u_Metallic;
-		roughness = u_Roughness;
-		ao = u_Ao;
+		albedo = v_Albedo.rgb;
+		opacity = v_Albedo.a;
+		metallic = v_Material.x;
+		roughness = v_Material.y;
+		ao = v_Material.z;
 		N = normalize(v_WorldNormal);
 	}
 
-    vec3 V = normalize(u_CamPos - v_WorldPos);
+    vec3 V = normalize(u_CameraPosition.xyz - v_WorldPos);
 	vec3 R = reflect(-V, N); 
 
     // calculate reflectance at normal incidence; if dia-electric (like plastic) use F0 
@@ -168,14 +272,18 @@ void main()
 
     // reflectance equation
     vec3 Lo = vec3(0.0);
-    for(int i = 0; i < u_PointLightNum; i++) 
+    uvec2 cluster = getLightCluster();
+    for(uint i = 0u; i < cluster.y; i++) 
     {
-        // calculate per-light radiance
-        vec3 L = normalize(u_PointLightPositions[i] - v_WorldPos);
+        PointLight light = u_PointLights[u_LightIndices[cluster.x + i]];
+
+        // calculate per-light radiance, windowed so it reaches zero at the light's range
+        vec3 L = normalize(light.PositionRange.xyz - v_WorldPos);
         vec3 H = normalize(V + L);
-        float distance = length(u_PointLightPositions[i] - v_WorldPos);
-        float attenuation = 1.0 / (distance * distance);
-        vec3 radiance = u_PointLightColors[i] * attenuation;
+        float distance = length(light.PositionRange.xyz - v_WorldPos);
+        float window = clamp(1.0 - pow(distance / light.PositionRange.w, 4.0), 0.0, 1.0);
+        float attenuation = window * window / (distance * distance);
+        vec3 radiance = light.Color.rgb * attenuation;
 
         // Cook-Torrance BRDF
         float NDF = DistributionGGX(N, H, roughness);   
@@ -209,7 +317,7 @@ void main()
 	vec3 kS = F;
 	vec3 kD = 1.0 - kS;
 	kD *= 1.0 - metallic;	  
-	vec3 irradiance = texture(irradianceMap, N).rgb;
+	vec3 irradiance = u_UseIrradianceSH != 0 ? evaluateIrradianceSH(N) : texture(irradianceMap, N).rgb;
 	vec3 diffuse = irradiance * albedo;
 
 	// sample both the pre-filter map and the BRDF lut and combine them together as per the Split-Sum approximation to get the IBL specular part.
@@ -226,6 +334,6 @@ void main()
     // gamma correct
     color = pow(color, vec3(1.0/2.2)); 
 
-    o_Color = vec4(color, 1.0);
+    o_Color = vec4(color, opacity);
 	o_EntityID = v_EntityID;
 }
\ No newline at end of file